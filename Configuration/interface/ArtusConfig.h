@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -29,6 +32,8 @@ public:
 	// parses the json config from a stringstream
 	explicit ArtusConfig(std::stringstream& sStream);
 
+	~ArtusConfig();
+
 	void SaveConfig(TFile* outputFile) const;
 
 	std::vector<std::string> const& GetInputFiles() const;
@@ -47,6 +52,34 @@ public:
 		LoadPipelines< TPipelineInitializer, TPipelineRunner>(pInit, runner, factory, outputFile);
 	}
 
+	/// creates NumberOfThreads - 1 worker runners for multi-threaded event processing by loading
+	/// this configuration into them and adds them to the runner (see PipelineRunner::AddWorker).
+	/// Each worker writes to its own temporary output file until its outputs are merged.
+	/// Returns the number of threads, i.e. the number of event providers to be passed to
+	/// PipelineRunner::RunPipelinesMultiThreaded
+	template<class TPipelineInitializer, class TPipelineRunner, class TFactory>
+	size_t LoadWorkers(TPipelineInitializer& pInit, TPipelineRunner& runner,
+			TFactory & factory,
+			TFile * outputFile)
+	{
+		typedef typename TPipelineRunner::setting_type setting_type;
+
+		size_t nThreads = std::max(GetSettings<setting_type>().GetNumberOfThreads(), size_t(1));
+		for (size_t workerIndex = 1; workerIndex < nThreads; ++workerIndex)
+		{
+			TFile* workerOutputFile = nullptr;
+			if (outputFile != nullptr)
+			{
+				workerOutputFile = CreateWorkerOutputFile(outputFile, workerIndex);
+			}
+
+			TPipelineRunner* worker = new TPipelineRunner(false);
+			LoadConfiguration(pInit, *worker, factory, workerOutputFile);
+			runner.AddWorker(worker);
+		}
+		return nThreads;
+	}
+
 	template<class TSettings>
 	TSettings GetSettings()
 	{
@@ -61,6 +94,11 @@ public:
 		return m_outputPath;
 	}
 
+	/// closes the output files of the pipelines with an OutputFileGroup and removes the temporary
+	/// output files of the workers, to be called after the pipelines have been finished,
+	/// e.g. by RootEnvironment::Close, otherwise this is done when the config is destroyed
+	void CloseOutputFiles();
+
 	typedef std::pair< ProcessNodeType, std::string > NodeTypePair;
 
 	static NodeTypePair ParseProcessNode ( std::string const& sInp );
@@ -117,6 +155,8 @@ private:
 		typedef typename TPipelineInitializer::setting_type setting_type;
 		typedef typename TPipelineInitializer::pipeline_type pipeline_type;
 
+		std::vector<pipeline_type*> levelOnePipelines;
+
 		BOOST_FOREACH(boost::property_tree::ptree::value_type& v,
 				m_propTreeRoot.get_child("Pipelines"))
 		{
@@ -131,7 +171,14 @@ private:
 			pset.SetName(sKeyName);
 			pset.SetPropTreePath("Pipelines." + sKeyName);
 			pset.SetPropTree(&m_propTreeRoot);
-			pset.SetRootOutFile(outputFile);
+			if ((outputFile != nullptr) && (! pset.GetOutputFileGroup().empty()))
+			{
+				pset.SetRootOutFile(GetGroupOutputFile(outputFile, pset.GetOutputFileGroup()));
+			}
+			else
+			{
+				pset.SetRootOutFile(outputFile);
+			}
 
 			pipeline_type* pLine = new pipeline_type; //CreateDefaultPipeline();
 
@@ -176,9 +223,131 @@ private:
 
 			pLine->InitPipeline(pset, pInit);
 			runner.AddPipeline(pLine);
+
+			if (pset.GetLevel() == 1)
+			{
+				levelOnePipelines.push_back(pLine);
+			}
+		}
+
+		if (GetSettings<setting_type>().GetShareProducerPrefixes())
+		{
+			std::vector<size_t> pipelineIndices(levelOnePipelines.size());
+			std::vector<std::vector<std::string> > signatures;
+			for (size_t pipelineIndex = 0; pipelineIndex < levelOnePipelines.size(); ++pipelineIndex)
+			{
+				pipelineIndices[pipelineIndex] = pipelineIndex;
+				signatures.push_back(GetSharableProducerSignatures(*(levelOnePipelines[pipelineIndex])));
+			}
+			AddSharedPrefixes(runner, levelOnePipelines, signatures, pipelineIndices, 0, nullptr);
+		}
+	}
+
+	// one signature for every leading producer of a pipeline, which can be shared with other
+	// pipelines, consisting of the producer id and the values of all settings it reads
+	template<class TPipeline>
+	std::vector<std::string> GetSharableProducerSignatures(TPipeline & pipeline) const
+	{
+		typedef typename TPipeline::ProducerForThisPipeline producer_type;
+
+		std::vector<std::string> signatures;
+		for (typename TPipeline::ProcessNodeVector::iterator it = pipeline.GetNodes().begin(); it != pipeline.GetNodes().end(); ++it)
+		{
+			if (it->GetProcessNodeType() != ProcessNodeType::Producer)
+			{
+				break;
+			}
+
+			producer_type const& producer = static_cast<producer_type const&>(*it);
+			std::vector<std::string> settingNames;
+			if (! producer.GetSettingDependencies(settingNames))
+			{
+				break;
+			}
+			signatures.push_back(producer.GetProducerId() + GetSettingValues(pipeline.GetSettings().GetName(), settingNames));
+		}
+		return signatures;
+	}
+
+	// group the pipelines by their producers at the given depth and create a shared prefix
+	// for each group of at least two pipelines, which is as long as all of them agree
+	template<class TPipelineRunner, class TPipeline>
+	void AddSharedPrefixes(TPipelineRunner& runner, std::vector<TPipeline*> const& pipelines,
+			std::vector<std::vector<std::string> > const& signatures,
+			std::vector<size_t> const& pipelineIndices, size_t depth,
+			typename TPipelineRunner::shared_prefix_type const* parent)
+	{
+		typedef typename TPipelineRunner::shared_prefix_type shared_prefix_type;
+		typedef typename shared_prefix_type::producer_type producer_type;
+
+		std::vector<std::pair<std::string, std::vector<size_t> > > branches;
+		for (std::vector<size_t>::const_iterator pipelineIndex = pipelineIndices.begin(); pipelineIndex != pipelineIndices.end(); ++pipelineIndex)
+		{
+			if (signatures[*pipelineIndex].size() > depth)
+			{
+				std::string const& signature = signatures[*pipelineIndex][depth];
+				auto branch = std::find_if(branches.begin(), branches.end(),
+				                           [&signature](std::pair<std::string, std::vector<size_t> > const& b) { return (b.first == signature); });
+				if (branch == branches.end())
+				{
+					branches.push_back(std::make_pair(signature, std::vector<size_t>()));
+					branch = branches.end() - 1;
+				}
+				branch->second.push_back(*pipelineIndex);
+			}
+		}
+
+		for (auto const& branch : branches)
+		{
+			std::vector<size_t> const& branchPipelines = branch.second;
+			if (branchPipelines.size() < 2)
+			{
+				continue;
+			}
+
+			std::vector<std::string> const& firstSignatures = signatures[branchPipelines.front()];
+			size_t end = depth + 1;
+			while ((end < firstSignatures.size()) &&
+			       std::all_of(branchPipelines.begin(), branchPipelines.end(), [&](size_t pipelineIndex) {
+			           return ((signatures[pipelineIndex].size() > end) && (signatures[pipelineIndex][end] == firstSignatures[end]));
+			       }))
+			{
+				++end;
+			}
+
+			// the producers of the first pipeline are run for all pipelines of the branch
+			TPipeline * representative = pipelines[branchPipelines.front()];
+			std::vector<producer_type*> producers;
+			for (size_t nodeIndex = depth; nodeIndex < end; ++nodeIndex)
+			{
+				producers.push_back(&static_cast<producer_type&>(representative->GetNodes()[nodeIndex]));
+			}
+
+			shared_prefix_type* sharedPrefix = new shared_prefix_type(parent, producers, representative->GetSettings());
+			runner.AddSharedPrefix(sharedPrefix);
+			for (std::vector<size_t>::const_iterator pipelineIndex = branchPipelines.begin(); pipelineIndex != branchPipelines.end(); ++pipelineIndex)
+			{
+				pipelines[*pipelineIndex]->SetSharedPrefix(sharedPrefix);
+			}
+			LOG(INFO) << "Producers " << depth << " to " << (end - 1) << " of pipeline \"" << representative->GetSettings().GetName()
+			          << "\" are shared with " << (branchPipelines.size() - 1) << " other pipeline(s).";
+
+			AddSharedPrefixes(runner, pipelines, signatures, branchPipelines, end, sharedPrefix);
 		}
 	}
 
+	// values of the given settings as seen by a pipeline
+	std::string GetSettingValues(std::string const& pipelineName, std::vector<std::string> const& settingNames) const;
+
+	// output file of a group of pipelines, which is created with the first pipeline of the group
+	TFile* GetGroupOutputFile(TFile* mainOutputFile, std::string const& group);
+
+	// temporary output file of a worker runner
+	TFile* CreateWorkerOutputFile(TFile* mainOutputFile, size_t workerIndex);
+
+	// input files containing the events to be replayed (see ReplayEventIndex)
+	std::vector<std::string> GetReplayInputFiles(std::string const& eventIndexFileName);
+
 	std::string m_jsonConfigFileName;
 	std::string m_outputPath;
 	std::vector<std::string> m_fileNames;
@@ -186,5 +355,8 @@ private:
 
 	std::string m_minimumLogLevelString;
 
+	std::map<std::string, std::shared_ptr<TFile> > m_groupOutputFiles;
+	std::vector<std::shared_ptr<TFile> > m_workerOutputFiles;
+
 };
 
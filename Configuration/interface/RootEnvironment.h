@@ -11,12 +11,15 @@
 class RootEnvironment {
 public:
 	explicit RootEnvironment(const ArtusConfig& artusConfig);
+	/// the further output files of the config are closed together with the main output file
+	explicit RootEnvironment(ArtusConfig& artusConfig);
 	~RootEnvironment();
 	
 	inline TFile* GetRootFile() const { return m_rootFile; };
 	void Close();
 	
 private:
+	ArtusConfig* m_artusConfig = nullptr;
 	TFile* m_rootFile;
 	std::string m_rootFileName;
 };
@@ -39,6 +39,28 @@ public:
 	IMPL_SETTING_DEFAULT(long long, FirstEvent, 0)
 	IMPL_SETTING_DEFAULT(long long, ProcessNEvents, -1) // -1 for no limit
 
+	/// number of threads processing events, see PipelineRunner::AddWorker
+	IMPL_SETTING_DEFAULT(size_t, NumberOfThreads, 1)
+
+	/// number of threads running the level one pipelines of one event in parallel
+	IMPL_SETTING_DEFAULT(size_t, NumberOfPipelineThreads, 1)
+
+	/// number of threads compressing the baskets of the output trees in parallel (ROOT implicit multi-threading, 0: disabled)
+	IMPL_SETTING_DEFAULT(size_t, NumberOfCompressionThreads, 0)
+
+	/// measure the run times of the processors only in every n-th event
+	IMPL_SETTING_DEFAULT(size_t, RunTimeSamplingInterval, 1)
+
+	/// run leading producers, which are identical in several pipelines, only once per event,
+	/// see ProducerBaseUntemplated::GetSettingDependencies
+	/// (the pipelines get shallow copies of the shared product as of the global product, objects owned by
+	/// shared pointers, e.g. corrected objects, must therefore not be changed in place by later producers)
+	IMPL_SETTING_DEFAULT(bool, ShareProducerPrefixes, false)
+
+	/// do not read input collections, which are not used by any node, see ProcessNodeBase::GetInputCollections,
+	/// only to be enabled if no analysis-specific node reads further collections in overwritten hooks
+	IMPL_SETTING_DEFAULT(bool, PruneInputCollections, false)
+
 	IMPL_PROPERTY( std::string, Name )
 
 	IMPL_SETTING_DEFAULT( std::string , LogLevel, "unknown" )
@@ -56,6 +78,10 @@ public:
 	/// application
 	IMPL_PROPERTY(TFile *, RootOutFile)
 
+	/// pipelines with the same non-empty group are written into the file <output>_<group>.root
+	/// next to the main output file instead of into the main output file (see ArtusConfig)
+	IMPL_SETTING_DEFAULT(std::string, OutputFileGroup, "")
+
 	/// detemine whether this is data or MC
 	IMPL_SETTING(bool, InputIsData);
 
@@ -76,6 +102,21 @@ public:
 	//IMPL_SETTING_STRINGLIST(Quantities);
 	IMPL_SETTING_SORTED_STRINGLIST(Quantities);
 
+	/// number of events buffered by the LambdaNtupleConsumer before they are filled into the ntuple
+	/// (only used with NtupleWriterQueueSize > 0, otherwise the events are filled one by one)
+	IMPL_SETTING_DEFAULT(size_t, NtupleBatchSize, 1)
+
+	/// output format of the LambdaNtupleConsumer ("TTree" or "RNTuple")
+	IMPL_SETTING_DEFAULT(std::string, NtupleOutputBackend, "TTree")
+
+	/// compression of the ntuple ("ZLIB", "LZMA", "LZ4" or "ZSTD", empty for the settings of the output file)
+	IMPL_SETTING_DEFAULT(std::string, NtupleCompressionAlgorithm, "")
+	IMPL_SETTING_DEFAULT(int, NtupleCompressionLevel, 4)
+
+	/// number of batches of events, which the LambdaNtupleConsumer hands over to the background OutputWriter
+	/// before it waits for them to be written (0: fill the ntuple in the event loop)
+	IMPL_SETTING_DEFAULT(size_t, NtupleWriterQueueSize, 0)
+
 	virtual std::vector<std::string> GetFilters () const;
 
 	IMPL_SETTING_STRINGLIST_DEFAULT(TaggingFilters, std::vector<std::string>());
@@ -1,15 +1,18 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <set>
 
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
 #include "TObjString.h"
+#include "TSystem.h"
 
 #include "Artus/Configuration/interface/ArtusConfig.h"
 #include "Artus/Configuration/interface/PropertyTreeSupport.h"
 #include "Artus/Utility/interface/Utility.h"
+#include "Artus/Utility/interface/EventIndex.h"
 
 ArtusConfig::ArtusConfig(int argc, char** argv) :
 	m_jsonConfigFileName(""),
@@ -141,6 +144,12 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 
 	m_outputPath = m_propTreeRoot.get<std::string>("OutputPath", "output.root");
 	m_fileNames = PropertyTreeSupport::GetAsStringList(&m_propTreeRoot, "InputFiles");
+
+	std::string replayEventIndex = m_propTreeRoot.get<std::string>("ReplayEventIndex", "");
+	if (! replayEventIndex.empty())
+	{
+		m_fileNames = GetReplayInputFiles(replayEventIndex);
+	}
 	LOG(INFO) << "Loading " << m_fileNames.size() << " input files.";
 
 	if (m_fileNames.size() == 0)
@@ -149,6 +158,54 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 	}
 }
 
+std::vector<std::string> ArtusConfig::GetReplayInputFiles(std::string const& eventIndexFileName)
+{
+	EventIndex eventIndex;
+	if (! eventIndex.Read(eventIndexFileName))
+	{
+		LOG(FATAL) << "Cannot read event index \"" << eventIndexFileName << "\"!";
+	}
+
+	std::vector<std::string> eventIds;
+	if (m_propTreeRoot.get_child_optional("ReplayEvents"))
+	{
+		eventIds = PropertyTreeSupport::GetAsStringList(&m_propTreeRoot, "ReplayEvents");
+	}
+
+	std::set<std::string> replayFileNames;
+	for (std::vector<std::string>::const_iterator eventId = eventIds.begin(); eventId != eventIds.end(); ++eventId)
+	{
+		unsigned int run = 0;
+		unsigned int lumi = 0;
+		unsigned long long event = 0;
+		EventIndex::Entry const* indexEntry = nullptr;
+		if (EventIndex::ParseEvent(*eventId, run, lumi, event) && ((indexEntry = eventIndex.Find(run, lumi, event)) != nullptr))
+		{
+			replayFileNames.insert(eventIndex.GetFiles()[indexEntry->file]);
+		}
+	}
+
+	// keep the order of the input files, the event provider reports the events it cannot find
+	std::vector<std::string> replayInputFiles;
+	for (std::vector<std::string>::const_iterator fileName = m_fileNames.begin(); fileName != m_fileNames.end(); ++fileName)
+	{
+		if (replayFileNames.count(*fileName) > 0)
+		{
+			replayInputFiles.push_back(*fileName);
+		}
+	}
+	if (replayInputFiles.empty())
+	{
+		LOG(FATAL) << "None of the input files contains one of the events to be replayed!";
+	}
+	return replayInputFiles;
+}
+
+ArtusConfig::~ArtusConfig()
+{
+	CloseOutputFiles();
+}
+
 void ArtusConfig::SaveConfig(TFile * outputFile) const
 {
 	TObjString jsonConfigContent(
@@ -191,3 +248,122 @@ ArtusConfig::NodeTypePair ArtusConfig::ParseProcessNode(std::string const& sInp)
 
 	return std::make_pair(ntype, splitted[1]);
 }
+
+// append the value and all sub-settings of a setting
+static void AppendSettingValue(std::ostream & out, boost::property_tree::ptree const& setting)
+{
+	out << setting.data() << "{";
+	for (boost::property_tree::ptree::const_iterator it = setting.begin(); it != setting.end(); ++it)
+	{
+		out << it->first << ":";
+		AppendSettingValue(out, it->second);
+		out << ",";
+	}
+	out << "}";
+}
+
+std::string ArtusConfig::GetSettingValues(std::string const& pipelineName, std::vector<std::string> const& settingNames) const
+{
+	std::stringstream values;
+	for (std::vector<std::string>::const_iterator settingName = settingNames.begin(); settingName != settingNames.end(); ++settingName)
+	{
+		// pipeline settings take precedence over global settings
+		boost::optional<boost::property_tree::ptree const&> setting = m_propTreeRoot.get_child_optional("Pipelines." + pipelineName + "." + *settingName);
+		if (! setting)
+		{
+			setting = m_propTreeRoot.get_child_optional(*settingName);
+		}
+
+		values << "\n" << *settingName << "=";
+		if (setting)
+		{
+			AppendSettingValue(values, *setting);
+		}
+	}
+	return values.str();
+}
+
+TFile* ArtusConfig::GetGroupOutputFile(TFile* mainOutputFile, std::string const& group)
+{
+	std::string fileName = mainOutputFile->GetName();
+	if (boost::algorithm::ends_with(fileName, ".root"))
+	{
+		fileName = fileName.substr(0, fileName.size() - 5);
+	}
+	fileName += "_" + group + ".root";
+
+	// each worker writes the group into a temporary file next to its own output file
+	std::shared_ptr<TFile>& groupOutputFile = m_groupOutputFiles[fileName];
+	if (! groupOutputFile)
+	{
+		bool temporary = false;
+		for (std::vector<std::shared_ptr<TFile> >::const_iterator workerOutputFile = m_workerOutputFiles.begin();
+		     workerOutputFile != m_workerOutputFiles.end(); ++workerOutputFile)
+		{
+			temporary = (temporary || (workerOutputFile->get() == mainOutputFile));
+		}
+
+		TDirectory* tmpDirectory = gDirectory;
+		groupOutputFile.reset(new TFile(fileName.c_str(), "RECREATE"));
+		if (groupOutputFile->IsZombie())
+		{
+			LOG(FATAL) << "Cannot create output file \"" << fileName << "\" for the pipelines of group \"" << group << "\"!";
+		}
+		if (temporary)
+		{
+			m_workerOutputFiles.push_back(groupOutputFile);
+		}
+		else
+		{
+			LOG(INFO) << "Output file \"" << fileName << "\" created.";
+			SaveConfig(groupOutputFile.get());
+		}
+		gDirectory = tmpDirectory;
+	}
+	return groupOutputFile.get();
+}
+
+TFile* ArtusConfig::CreateWorkerOutputFile(TFile* mainOutputFile, size_t workerIndex)
+{
+	std::string fileName = mainOutputFile->GetName();
+	if (boost::algorithm::ends_with(fileName, ".root"))
+	{
+		fileName = fileName.substr(0, fileName.size() - 5);
+	}
+	fileName += ".worker" + std::to_string(workerIndex) + ".root";
+
+	TDirectory* tmpDirectory = gDirectory;
+	std::shared_ptr<TFile> workerOutputFile(new TFile(fileName.c_str(), "RECREATE"));
+	if (workerOutputFile->IsZombie())
+	{
+		LOG(FATAL) << "Cannot create temporary output file \"" << fileName << "\" for worker " << workerIndex << "!";
+	}
+	gDirectory = tmpDirectory;
+
+	m_workerOutputFiles.push_back(workerOutputFile);
+	return workerOutputFile.get();
+}
+
+void ArtusConfig::CloseOutputFiles()
+{
+	// the outputs of the workers have been merged into the main outputs
+	for (std::vector<std::shared_ptr<TFile> >::iterator workerOutputFile = m_workerOutputFiles.begin();
+	     workerOutputFile != m_workerOutputFiles.end(); ++workerOutputFile)
+	{
+		std::string fileName = (*workerOutputFile)->GetName();
+		(*workerOutputFile)->Close();
+		gSystem->Unlink(fileName.c_str());
+	}
+	m_workerOutputFiles.clear();
+
+	for (std::map<std::string, std::shared_ptr<TFile> >::iterator groupOutputFile = m_groupOutputFiles.begin();
+	     groupOutputFile != m_groupOutputFiles.end(); ++groupOutputFile)
+	{
+		if (groupOutputFile->second->IsOpen())
+		{
+			groupOutputFile->second->Close();
+			LOG(INFO) << "Output file \"" << groupOutputFile->first << "\" closed.";
+		}
+	}
+	m_groupOutputFiles.clear();
+}
@@ -13,11 +13,21 @@ RootEnvironment::RootEnvironment(const ArtusConfig & artusConfig) :
 	artusConfig.SaveConfig(m_rootFile);
 }
 
+RootEnvironment::RootEnvironment(ArtusConfig & artusConfig) :
+	RootEnvironment(static_cast<const ArtusConfig&>(artusConfig))
+{
+	m_artusConfig = &artusConfig;
+}
+
 RootEnvironment::~RootEnvironment() {
 	Close();
 }
 
 void RootEnvironment::Close() {
+	if(m_artusConfig) {
+		m_artusConfig->CloseOutputFiles();
+		m_artusConfig = nullptr;
+	}
 	if(m_rootFile) {
 		m_rootFile->Close();
 		LOG(INFO) << "Output file \"" << m_rootFileName << "\" closed.";
@@ -36,6 +36,15 @@ public:
 		// overwrite this to analyze
 	}
 
+	bool IsMergeable() const override
+	{
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override {
+		m_flow.Merge(static_cast<CutFlowConsumerBase<TTypes> &>(other).m_flow);
+	}
+
 protected:
 
 	CutFlow m_flow;
@@ -26,6 +26,11 @@ public:
 		return "cutflow_histogram";
 	}
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override
+	{
+		return true;
+	}
+
 	CutFlowHistogramConsumer() :
 		CutFlowConsumerBase< TTypes >(),
 		m_addWeightedCutFlow(false),
@@ -65,13 +70,13 @@ public:
 		}
 
 		// fill bins of histograms corresponding to passed filters
-		FilterResult::FilterDecisions const& filterDecisions = filterResult.GetFilterDecisions();
-		for(FilterResult::FilterDecisions::const_iterator filterDecision = filterDecisions.begin();
-		    filterDecision != filterDecisions.end(); ++filterDecision)
+		FilterResult::FilterIndices const& filterIndices = filterResult.GetFilterIndices();
+		for(FilterResult::FilterIndices::const_iterator filterIndex = filterIndices.begin();
+		    filterIndex != filterIndices.end(); ++filterIndex)
 		{
 			++bin;
-			if (filterDecision->filterDecision == FilterResult::Decision::Passed ||
-			    filterDecision->taggingMode == FilterResult::TaggingMode::Tagging)
+			if (filterResult.GetFilterDecision(*filterIndex) == FilterResult::Decision::Passed ||
+			    filterResult.GetTaggingMode(*filterIndex) == FilterResult::TaggingMode::Tagging)
 			{
 				m_cutFlowUnweightedHist->Fill(static_cast<float>(bin));
 
@@ -99,6 +104,41 @@ public:
 		}
 	}
 
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override {
+		CutFlowConsumerBase<TTypes>::Merge(other, setting);
+
+		auto & specOther = static_cast<CutFlowHistogramConsumer<TTypes> &>(other);
+		if (! specOther.m_histogramsInitialised)
+		{
+			return;
+		}
+
+		if (m_histogramsInitialised)
+		{
+			m_cutFlowUnweightedHist->Add(specOther.m_cutFlowUnweightedHist);
+
+			if(m_addWeightedCutFlow) {
+				m_cutFlowWeightedHist->Add(specOther.m_cutFlowWeightedHist);
+			}
+		}
+		else
+		{
+			// no events have been processed by this consumer
+			TDirectory* tmpDirectory = gDirectory;
+			RootFileHelper::SafeCd( setting.GetRootOutFile(),
+			                        setting.GetRootFileFolder());
+
+			m_cutFlowUnweightedHist = static_cast<TH1F*>(specOther.m_cutFlowUnweightedHist->Clone());
+
+			if(m_addWeightedCutFlow) {
+				m_cutFlowWeightedHist = static_cast<TH1F*>(specOther.m_cutFlowWeightedHist->Clone());
+			}
+
+			gDirectory = tmpDirectory;
+			m_histogramsInitialised = true;
+		}
+	}
+
 protected:
 	TH1F* m_cutFlowUnweightedHist = nullptr;
 	TH1F* m_cutFlowWeightedHist = nullptr;
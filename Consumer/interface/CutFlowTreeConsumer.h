@@ -3,10 +3,13 @@
 
 //#include <boost/scoped_ptr.hpp>
 
+#include <typeinfo>
+
 #include <TDirectory.h>
 #include <TTree.h>
 #include <TROOT.h>
 
+#include "Artus/Core/interface/OutputWriter.h"
 #include "Artus/Utility/interface/RootFileHelper.h"
 #include "Artus/Consumer/interface/CutFlowConsumerBase.h"
 
@@ -52,7 +55,7 @@ public:
 		
 		// initialise histograms in first event
 		if(! m_treesInitialised) {
-			m_treesInitialised = InitialiseTrees(setting, filterResult);
+			m_treesInitialised = InitialiseTrees(setting, filterResult.GetFilterNames());
 		}
 		
 		m_run = m_runExtractor(event, product, setting);
@@ -61,12 +64,13 @@ public:
 		
 		// fill tree corresponding to non-passed filters
 		size_t filterIndex = 0;
-		FilterResult::FilterDecisions const& filterDecisions = filterResult.GetFilterDecisions();
-		for(FilterResult::FilterDecisions::const_iterator filterDecision = filterDecisions.begin();
-		    filterDecision != filterDecisions.end(); ++filterDecision)
+		FilterResult::FilterIndices const& filterIndices = filterResult.GetFilterIndices();
+		for(FilterResult::FilterIndices::const_iterator it = filterIndices.begin();
+		    it != filterIndices.end(); ++it)
 		{
-			if ((filterDecision->filterDecision != FilterResult::Decision::Passed) &&
-			    (filterDecision->taggingMode == FilterResult::TaggingMode::Filtering)) {
+			if ((filterResult.GetFilterDecision(*it) != FilterResult::Decision::Passed) &&
+			    (filterResult.GetTaggingMode(*it) == FilterResult::TaggingMode::Filtering)) {
+				std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
 				m_cutFlowTrees[filterIndex]->Fill();
 				break;
 			}
@@ -91,6 +95,40 @@ public:
 		}
 	}
 
+	// derived consumers may fill additional branches, which are not merged here,
+	// therefore they have to enable merging explicitly by overwriting this method
+	bool IsMergeable() const override
+	{
+		return (typeid(*this) == typeid(CutFlowTreeConsumer<TTypes>));
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override {
+		CutFlowConsumerBase<TTypes>::Merge(other, setting);
+
+		auto & specOther = static_cast<CutFlowTreeConsumer<TTypes> &>(other);
+		if (! specOther.m_treesInitialised)
+		{
+			return;
+		}
+
+		if(! m_treesInitialised) {
+			m_treesInitialised = InitialiseTrees(setting, specOther.m_filterNames);
+		}
+
+		for (size_t filterIndex = 0; filterIndex < m_cutFlowTrees.size(); ++filterIndex)
+		{
+			TTree* otherTree = specOther.m_cutFlowTrees.at(filterIndex);
+			for (Long64_t entry = 0; entry < otherTree->GetEntries(); ++entry)
+			{
+				otherTree->GetEntry(entry);
+				m_run = specOther.m_run;
+				m_lumi = specOther.m_lumi;
+				m_event = specOther.m_event;
+				m_cutFlowTrees[filterIndex]->Fill();
+			}
+		}
+	}
+
 protected:
 	std::vector<TTree*> m_cutFlowTrees;
 	uint64_extractor_lambda m_runExtractor;
@@ -99,15 +137,16 @@ protected:
 
 private:
 	bool m_treesInitialised;
+	std::vector<std::string> m_filterNames;
 	uint64_t m_run;
 	uint64_t m_lumi;
 	uint64_t m_event;
 	
 	// initialise histograms; to be called in first event
-	bool InitialiseTrees(setting_type const& setting, FilterResult & filterResult) {
+	bool InitialiseTrees(setting_type const& setting, std::vector<std::string> const& filterNames) {
 
 		// filters
-		std::vector<std::string> filterNames = filterResult.GetFilterNames();
+		m_filterNames = filterNames;
 	
 		// trees
 		TDirectory* tmpDirectory = gDirectory;
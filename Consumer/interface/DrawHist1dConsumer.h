@@ -64,6 +64,14 @@ public:
 		}
 	}
 
+	bool IsMergeable() const override {
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override {
+		getHist()->m_hist->Add(static_cast<DrawHist1dConsumerBase<TTypes> &>(other).getHist()->m_hist.get());
+	}
+
 	Hist1D* getHist() {
 		return m_hist;
 	}
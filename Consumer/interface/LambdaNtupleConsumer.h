@@ -1,8 +1,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -14,15 +21,17 @@
 #include "Artus/Core/interface/EventBase.h"
 #include "Artus/Core/interface/ProductBase.h"
 #include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/Core/interface/OutputWriter.h"
 #include "Artus/Configuration/interface/SettingsBase.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/RootFileHelper.h"
+#include "Artus/Consumer/interface/NtupleOutputBackend.h"
 
 
 /**
- * Fills TTrees with valueExtractors defined as lambda functions
+ * Fills ntuples (TTree or RNTuple, see NtupleOutputBackend) with valueExtractors defined as lambda functions
  * This removes the string operations from its base class
  * This consumer can only be fully initilised in the constructor of an derived class
  * where the map LambdaNtupleConsumer<TTypes>::Quantities is filled with analysis specific code
@@ -32,6 +41,18 @@
 class LambdaNtupleQuantities {
 
 public:
+	/// type of a quantity, which selects the registry containing its extractor
+	typedef NtupleColumnKind Kind;
+
+	static std::string GetKindName(Kind kind);
+
+	/// Type of a quantity, derived from the registry containing it. The registries are searched
+	/// in a fixed order. Returns false, if the quantity is not registered.
+	static bool GetQuantityKind(std::string const& name, Kind & kind);
+
+	/// Remove a quantity from all registries, such that it can be registered with another type.
+	static void RemoveQuantity(std::string const& name);
+
 	static std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >> CommonBoolQuantities;
 	static std::map<std::string, std::function<int(EventBase const&, ProductBase const& ) >> CommonIntQuantities;
 	static std::map<std::string, std::function<uint64_t(EventBase const&, ProductBase const& ) >> CommonUInt64Quantities;
@@ -45,6 +66,13 @@ public:
 	static std::map<std::string, std::function<std::vector<RMFLV>(EventBase const&, ProductBase const& ) >> CommonVRMFLVQuantities;
 	static std::map<std::string, std::function<std::vector<std::string>(EventBase const&, ProductBase const& ) >> CommonVStringQuantities;
 	static std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >> CommonVIntQuantities;
+
+	// vector quantities, which are written into the existing vector of the previous event
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<double>&)>> CommonVDoubleInPlaceQuantities;
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<float>&)>> CommonVFloatInPlaceQuantities;
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<RMFLV>&)>> CommonVRMFLVInPlaceQuantities;
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<std::string>&)>> CommonVStringInPlaceQuantities;
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<int>&)>> CommonVIntInPlaceQuantities;
 };
 
 template<class TTypes>
@@ -70,136 +98,261 @@ public:
 	typedef std::function<std::vector<RMFLV>(EventBase const&, ProductBase const&)> vRMFLV_extractor_lambda_base;
 	typedef std::function<std::vector<std::string>(EventBase const&, ProductBase const&)> vString_extractor_lambda_base;
 	typedef std::function<std::vector<int>(EventBase const&, ProductBase const&)> vInt_extractor_lambda_base;
-
-
-	static void AddBoolQuantity(std::string const& name,
-	                            std::function<bool(event_type const&, product_type const&)> valueExtractor)
+	typedef std::function<void(EventBase const&, ProductBase const&, std::vector<double>&)> vDouble_inplace_extractor_lambda_base;
+	typedef std::function<void(EventBase const&, ProductBase const&, std::vector<float>&)> vFloat_inplace_extractor_lambda_base;
+	typedef std::function<void(EventBase const&, ProductBase const&, std::vector<RMFLV>&)> vRMFLV_inplace_extractor_lambda_base;
+	typedef std::function<void(EventBase const&, ProductBase const&, std::vector<std::string>&)> vString_inplace_extractor_lambda_base;
+	typedef std::function<void(EventBase const&, ProductBase const&, std::vector<int>&)> vInt_inplace_extractor_lambda_base;
+
+
+	/// Casts the event and the product to the analysis specific types. The values of quantities,
+	/// which do not depend on the pipeline product, are cached per event in the QuantityCache.
+	template<class T>
+	static std::function<T(EventBase const&, ProductBase const&)> WrapValueExtractor(
+			std::string const& name,
+			std::function<T(event_type const&, product_type const&)> valueExtractor,
+			QuantityScope scope)
 	{
-		LambdaNtupleQuantities::CommonBoolQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> bool
+		if (scope == QuantityScope::PipelineProduct)
+		{
+			return [valueExtractor](EventBase const& ev, ProductBase const& pd) -> T
+			{
+				auto const& specEv = static_cast<event_type const&>(ev);
+				auto const& specPd = static_cast<product_type const&>(pd);
+				return valueExtractor(specEv, specPd);
+			};
+		}
+
+		size_t quantityId = QuantityCache::GetQuantityId(name);
+		return [valueExtractor, quantityId](EventBase const& ev, ProductBase const& pd) -> T
 		{
 			auto const& specEv = static_cast<event_type const&>(ev);
 			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			if ((pd.quantityCache == nullptr) || (! pd.quantityCache->HasSlot(quantityId)))
+			{
+				return valueExtractor(specEv, specPd);
+			}
+			return pd.quantityCache->template Get<T>(quantityId, [&valueExtractor, &specEv, &specPd]() {
+				return valueExtractor(specEv, specPd);
+			});
 		};
 	}
-	static void AddIntQuantity(std::string const& name,
-	                           std::function<int(event_type const&, product_type const&)> valueExtractor)
+
+	/// Same as WrapValueExtractor for extractors writing into the vector of the previous event.
+	template<class T>
+	static std::function<void(EventBase const&, ProductBase const&, T&)> WrapInPlaceValueExtractor(
+			std::string const& name,
+			std::function<void(event_type const&, product_type const&, T&)> valueExtractor,
+			QuantityScope scope)
 	{
-		LambdaNtupleQuantities::CommonIntQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> int
+		if (scope == QuantityScope::PipelineProduct)
+		{
+			return [valueExtractor](EventBase const& ev, ProductBase const& pd, T& value)
+			{
+				auto const& specEv = static_cast<event_type const&>(ev);
+				auto const& specPd = static_cast<product_type const&>(pd);
+				valueExtractor(specEv, specPd, value);
+			};
+		}
+
+		size_t quantityId = QuantityCache::GetQuantityId(name);
+		return [valueExtractor, quantityId](EventBase const& ev, ProductBase const& pd, T& value)
 		{
 			auto const& specEv = static_cast<event_type const&>(ev);
 			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			if ((pd.quantityCache == nullptr) || (! pd.quantityCache->HasSlot(quantityId)))
+			{
+				valueExtractor(specEv, specPd, value);
+				return;
+			}
+			value = pd.quantityCache->template GetInPlace<T>(quantityId, [&valueExtractor, &specEv, &specPd](T& cachedValue) {
+				valueExtractor(specEv, specPd, cachedValue);
+			});
 		};
 	}
-	static void AddUInt64Quantity(std::string const& name,
-	                              std::function<uint64_t(event_type const&, product_type const&)> valueExtractor)
+
+	/// Returns the in-place extractor of a vector quantity. Quantities registered with a by-value
+	/// extractor are adapted, the returned vector is moved into the existing one.
+	template<class T>
+	static std::function<void(EventBase const&, ProductBase const&, T&)> GetInPlaceValueExtractor(
+			std::map<std::string, std::function<T(EventBase const&, ProductBase const&)>> const& quantities,
+			std::map<std::string, std::function<void(EventBase const&, ProductBase const&, T&)>> const& inPlaceQuantities,
+			std::string const& name)
 	{
-		LambdaNtupleQuantities::CommonUInt64Quantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> uint64_t
+		auto inPlaceQuantity = inPlaceQuantities.find(name);
+		if (inPlaceQuantity != inPlaceQuantities.end())
 		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			return inPlaceQuantity->second;
+		}
+
+		auto valueExtractor = SafeMap::Get(quantities, name);
+		return [valueExtractor](EventBase const& ev, ProductBase const& pd, T& value)
+		{
+			value = valueExtractor(ev, pd);
 		};
 	}
+
+	static void AddBoolQuantity(std::string const& name,
+	                            std::function<bool(event_type const&, product_type const&)> valueExtractor,
+	                            QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonBoolQuantities[name] = WrapValueExtractor<bool>(name, valueExtractor, scope);
+	}
+	static void AddIntQuantity(std::string const& name,
+	                           std::function<int(event_type const&, product_type const&)> valueExtractor,
+	                           QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonIntQuantities[name] = WrapValueExtractor<int>(name, valueExtractor, scope);
+	}
+	static void AddUInt64Quantity(std::string const& name,
+	                              std::function<uint64_t(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonUInt64Quantities[name] = WrapValueExtractor<uint64_t>(name, valueExtractor, scope);
+	}
 	static void AddFloatQuantity(std::string const& name,
-	                             std::function<float(event_type const&, product_type const&)> valueExtractor)
+	                             std::function<float(event_type const&, product_type const&)> valueExtractor,
+	                             QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonFloatQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> float
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonFloatQuantities[name] = WrapValueExtractor<float>(name, valueExtractor, scope);
 	}
 	static void AddDoubleQuantity(std::string const& name,
-	                              std::function<double(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<double(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonDoubleQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> double
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonDoubleQuantities[name] = WrapValueExtractor<double>(name, valueExtractor, scope);
 	}
 	static void AddPtEtaPhiMVectorQuantity(std::string const& name,
-	                              std::function<ROOT::Math::PtEtaPhiMVector(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<ROOT::Math::PtEtaPhiMVector(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonPtEtaPhiMVectorQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> ROOT::Math::PtEtaPhiMVector
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonPtEtaPhiMVectorQuantities[name] = WrapValueExtractor<ROOT::Math::PtEtaPhiMVector>(name, valueExtractor, scope);
 	}
 	static void AddRMFLVQuantity(std::string const& name,
-	                              std::function<RMFLV(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<RMFLV(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonRMFLVQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> RMFLV
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonRMFLVQuantities[name] = WrapValueExtractor<RMFLV>(name, valueExtractor, scope);
 	}
 	static void AddStringQuantity(std::string const& name,
-	                              std::function<std::string(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<std::string(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonStringQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::string
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonStringQuantities[name] = WrapValueExtractor<std::string>(name, valueExtractor, scope);
 	}
 	static void AddVDoubleQuantity(std::string const& name,
-	                              std::function<std::vector<double>(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<std::vector<double>(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonVDoubleQuantities[name] = WrapValueExtractor<std::vector<double>>(name, valueExtractor, scope);
+	}
+	/// In-place extractors write into the column buffer, which still contains the values of the
+	/// previous event. They have to overwrite its complete content (e.g. by clear and push_back).
+	static void AddVDoubleQuantityInPlace(std::string const& name,
+	                              std::function<void(event_type const&, product_type const&, std::vector<double>&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonVDoubleQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<double>
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		auto inPlaceValueExtractor = WrapInPlaceValueExtractor<std::vector<double>>(name, valueExtractor, scope);
+		LambdaNtupleQuantities::CommonVDoubleInPlaceQuantities[name] = inPlaceValueExtractor;
+		LambdaNtupleQuantities::CommonVDoubleQuantities[name] = [inPlaceValueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<double>
 		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			std::vector<double> value;
+			inPlaceValueExtractor(ev, pd, value);
+			return value;
 		};
 	}
 	static void AddVFloatQuantity(std::string const& name,
-	                              std::function<std::vector<float>(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<std::vector<float>(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonVFloatQuantities[name] = WrapValueExtractor<std::vector<float>>(name, valueExtractor, scope);
+	}
+	static void AddVFloatQuantityInPlace(std::string const& name,
+	                              std::function<void(event_type const&, product_type const&, std::vector<float>&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonVFloatQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<float>
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		auto inPlaceValueExtractor = WrapInPlaceValueExtractor<std::vector<float>>(name, valueExtractor, scope);
+		LambdaNtupleQuantities::CommonVFloatInPlaceQuantities[name] = inPlaceValueExtractor;
+		LambdaNtupleQuantities::CommonVFloatQuantities[name] = [inPlaceValueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<float>
 		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			std::vector<float> value;
+			inPlaceValueExtractor(ev, pd, value);
+			return value;
 		};
 	}
 	static void AddVRMFLVQuantity(std::string const& name,
-	                              std::function<std::vector<RMFLV>(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<std::vector<RMFLV>(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonVRMFLVQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<RMFLV>
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonVRMFLVQuantities[name] = WrapValueExtractor<std::vector<RMFLV>>(name, valueExtractor, scope);
+	}
+	static void AddVRMFLVQuantityInPlace(std::string const& name,
+	                              std::function<void(event_type const&, product_type const&, std::vector<RMFLV>&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		auto inPlaceValueExtractor = WrapInPlaceValueExtractor<std::vector<RMFLV>>(name, valueExtractor, scope);
+		LambdaNtupleQuantities::CommonVRMFLVInPlaceQuantities[name] = inPlaceValueExtractor;
+		LambdaNtupleQuantities::CommonVRMFLVQuantities[name] = [inPlaceValueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<RMFLV>
 		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			std::vector<RMFLV> value;
+			inPlaceValueExtractor(ev, pd, value);
+			return value;
 		};
 	}
 	static void AddVStringQuantity(std::string const& name,
-	                              std::function<std::vector<std::string>(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<std::vector<std::string>(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonVStringQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<std::string>
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonVStringQuantities[name] = WrapValueExtractor<std::vector<std::string>>(name, valueExtractor, scope);
+	}
+	static void AddVStringQuantityInPlace(std::string const& name,
+	                              std::function<void(event_type const&, product_type const&, std::vector<std::string>&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		auto inPlaceValueExtractor = WrapInPlaceValueExtractor<std::vector<std::string>>(name, valueExtractor, scope);
+		LambdaNtupleQuantities::CommonVStringInPlaceQuantities[name] = inPlaceValueExtractor;
+		LambdaNtupleQuantities::CommonVStringQuantities[name] = [inPlaceValueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<std::string>
 		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			std::vector<std::string> value;
+			inPlaceValueExtractor(ev, pd, value);
+			return value;
 		};
 	}
 	static void AddVIntQuantity(std::string const& name,
-	                              std::function<std::vector<int>(event_type const&, product_type const&)> valueExtractor)
+	                              std::function<std::vector<int>(event_type const&, product_type const&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
 	{
-		LambdaNtupleQuantities::CommonVIntQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<int>
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		LambdaNtupleQuantities::CommonVIntQuantities[name] = WrapValueExtractor<std::vector<int>>(name, valueExtractor, scope);
+	}
+	static void AddVIntQuantityInPlace(std::string const& name,
+	                              std::function<void(event_type const&, product_type const&, std::vector<int>&)> valueExtractor,
+	                              QuantityScope scope = QuantityScope::PipelineProduct)
+	{
+		LambdaNtupleQuantities::RemoveQuantity(name);
+		auto inPlaceValueExtractor = WrapInPlaceValueExtractor<std::vector<int>>(name, valueExtractor, scope);
+		LambdaNtupleQuantities::CommonVIntInPlaceQuantities[name] = inPlaceValueExtractor;
+		LambdaNtupleQuantities::CommonVIntQuantities[name] = [inPlaceValueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<int>
 		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
+			std::vector<int> value;
+			inPlaceValueExtractor(ev, pd, value);
+			return value;
 		};
 	}
 	
@@ -243,232 +396,154 @@ public:
 	static std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >> & GetVIntQuantities () {
 		return LambdaNtupleQuantities::CommonVIntQuantities;
 	}
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<double>&)>> & GetVDoubleInPlaceQuantities () {
+		return LambdaNtupleQuantities::CommonVDoubleInPlaceQuantities;
+	}
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<float>&)>> & GetVFloatInPlaceQuantities () {
+		return LambdaNtupleQuantities::CommonVFloatInPlaceQuantities;
+	}
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<RMFLV>&)>> & GetVRMFLVInPlaceQuantities () {
+		return LambdaNtupleQuantities::CommonVRMFLVInPlaceQuantities;
+	}
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<std::string>&)>> & GetVStringInPlaceQuantities () {
+		return LambdaNtupleQuantities::CommonVStringInPlaceQuantities;
+	}
+	static std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<int>&)>> & GetVIntInPlaceQuantities () {
+		return LambdaNtupleQuantities::CommonVIntInPlaceQuantities;
+	}
 
 	void Init(setting_type const& settings) override {
 		ConsumerBase<TTypes>::Init(settings);
 
-		// construct value extractors
-		m_boolValueExtractors.clear();
-		m_floatValueExtractors.clear();
-		m_intValueExtractors.clear();
-		m_uint64ValueExtractors.clear();
-		m_doubleValueExtractors.clear();
-		m_ptEtaPhiMVectorValueExtractors.clear();
-		m_rmflvValueExtractors.clear();
-		m_stringValueExtractors.clear();
-		m_vDoubleValueExtractors.clear();
-		m_vFloatValueExtractors.clear();
-		m_vRMFLVValueExtractors.clear();
-		m_vStringValueExtractors.clear();
-		m_vIntValueExtractors.clear();
-		
-		m_boolQuantities.clear();
-		m_intQuantities.clear();
-		m_uint64Quantities.clear();
-		m_floatQuantities.clear();
-		m_doubleQuantities.clear();
-		m_ptEtaPhiMVectorQuantities.clear();
-		m_rmflvQuantities.clear();
-		m_stringQuantities.clear();
-		m_vDoubleQuantities.clear();
-		m_vFloatQuantities.clear();
-		m_vRMFLVQuantities.clear();
-		m_vStringQuantities.clear();
-		m_vIntQuantities.clear();
-		
-		size_t quantityIndex = 0;
-		for (std::vector<std::string>::iterator quantity = settings.GetQuantities().begin();
-		     quantity != settings.GetQuantities().end(); ++quantity)
+		// look up the type of each quantity once and assign the index of its value in the buffer of this type
+		std::vector<std::string> quantities = settings.GetQuantities();
+		m_quantities.clear();
+		m_quantityColumns.clear();
+		std::array<size_t, static_cast<size_t>(LambdaNtupleQuantities::Kind::NKinds)> nValues {{}};
+		for (std::vector<std::string>::const_iterator quantity = quantities.begin(); quantity != quantities.end(); ++quantity)
 		{
-			if (LambdaNtupleConsumer<TTypes>::GetFloatQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init float quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_floatValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetFloatQuantities(), *quantity));
-				m_floatQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetIntQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init int quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_intValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetIntQuantities(), *quantity));
-				m_intQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetUInt64Quantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init uint64 quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_uint64ValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetUInt64Quantities(), *quantity));
-				m_uint64Quantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetDoubleQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init double quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_doubleValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetDoubleQuantities(), *quantity));
-				m_doubleQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVDoubleQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vDouble quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vDoubleValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVDoubleQuantities(), *quantity));
-				m_vDoubleQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVFloatQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vFloat quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vFloatValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVFloatQuantities(), *quantity));
-				m_vFloatQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetBoolQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init bool quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_boolValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetBoolQuantities(), *quantity));
-				m_boolQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVIntQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vBool quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vIntValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVIntQuantities(), *quantity));
-				m_vIntQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetPtEtaPhiMVectorQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init ROOT::Math::PtEtaPhiMVector quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_ptEtaPhiMVectorValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetPtEtaPhiMVectorQuantities(), *quantity));
-				m_ptEtaPhiMVectorQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetRMFLVQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init RMFLV quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_rmflvValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetRMFLVQuantities(), *quantity));
-				m_rmflvQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVRMFLVQuantities().count(*quantity) > 0)
+			LambdaNtupleQuantities::Kind kind = LambdaNtupleQuantities::Kind::NKinds;
+			if (! LambdaNtupleQuantities::GetQuantityKind(*quantity, kind))
 			{
-				//LOG(DEBUG) << "Init vRMFLV quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vRMFLVValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVRMFLVQuantities(), *quantity));
-				m_vRMFLVQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetStringQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init string quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_stringValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetStringQuantities(), *quantity));
-				m_stringQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVStringQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vString quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vStringValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVStringQuantities(), *quantity));
-				m_vStringQuantities.push_back(*quantity);
+				LOG(FATAL) << "No lambda expression available for quantity \"" << *quantity << "\" (pipeline \"" << settings.GetName() << "\")!";
 			}
-			else
+			if (m_quantityColumns.insert(std::make_pair(*quantity, std::make_pair(kind, nValues[static_cast<size_t>(kind)]))).second)
 			{
-				LOG(FATAL) << "No lambda expression available for quantity \"" << *quantity << "\" (pipeline \"" << settings.GetName() << "\")!";
+				m_quantities.push_back(*quantity);
+				++nValues[static_cast<size_t>(kind)];
 			}
-
-			++quantityIndex;
 		}
 
-		// create tree
+		// create output
 		TDirectory* tmpDirectory = gDirectory;
 		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
-		m_tree = new TTree("ntuple", ("Tree for Pipeline \"" + settings.GetName() + "\"").c_str());
+		m_outputBackend = CreateNtupleOutputBackend(settings.GetNtupleOutputBackend(), gDirectory,
+		                                            "ntuple", "Tree for Pipeline \"" + settings.GetName() + "\"",
+		                                            RootFileHelper::GetCompressionSettings(settings.GetNtupleCompressionAlgorithm(),
+		                                                                                   settings.GetNtupleCompressionLevel()));
 		gDirectory = tmpDirectory;
 
-		// create branches
-		m_boolValues.resize(m_boolValueExtractors.size());
-		m_intValues.resize(m_intValueExtractors.size());
-		m_uint64Values.resize(m_uint64ValueExtractors.size());
-		m_floatValues.resize(m_floatValueExtractors.size());
-		m_doubleValues.resize(m_doubleValueExtractors.size());
-		m_ptEtaPhiMVectorValues.resize(m_ptEtaPhiMVectorValueExtractors.size());
-		m_rmflvValues.resize(m_rmflvValueExtractors.size());
-		m_stringValues.resize(m_stringValueExtractors.size());
-		m_vDoubleValues.resize(m_vDoubleValueExtractors.size());
-		m_vFloatValues.resize(m_vFloatValueExtractors.size());
-		m_vRMFLVValues.resize(m_vRMFLVValueExtractors.size());
-		m_vStringValues.resize(m_vStringValueExtractors.size());
-		m_vIntValues.resize(m_vIntValueExtractors.size());
-
-		size_t boolQuantityIndex = 0;
-		size_t intQuantityIndex = 0;
-		size_t uint64QuantityIndex = 0;
-		size_t floatQuantityIndex = 0;
-		size_t doubleQuantityIndex = 0;
-		size_t ptEtaPhiMVectorQuantityIndex = 0;
-		size_t rmflvQuantityIndex = 0;
-		size_t stringQuantityIndex = 0;
-		size_t vDoubleQuantityIndex = 0;
-		size_t vFloatQuantityIndex = 0;
-		size_t vRMFLVQuantityIndex = 0;
-		size_t vStringQuantityIndex = 0;
-		size_t vIntQuantityIndex = 0;
-		for (std::vector<std::string>::iterator quantity = settings.GetQuantities().begin();
-		     quantity != settings.GetQuantities().end(); ++quantity)
+		// the column buffers must not be reallocated after the columns have been created
+		m_boolValues.assign(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::Bool)], 0);
+		m_intValues.assign(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::Int)], 0);
+		m_uint64Values.assign(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::UInt64)], 0);
+		m_floatValues.assign(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::Float)], 0.0f);
+		m_doubleValues.assign(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::Double)], 0.0);
+		m_ptEtaPhiMVectorValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::PtEtaPhiMVector)]);
+		m_rmflvValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::RMFLV)]);
+		m_stringValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::String)]);
+		m_vDoubleValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::VDouble)]);
+		m_vFloatValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::VFloat)]);
+		m_vRMFLVValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::VRMFLV)]);
+		m_vStringValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::VString)]);
+		m_vIntValues.resize(nValues[static_cast<size_t>(LambdaNtupleQuantities::Kind::VInt)]);
+
+		// the values of several events can be buffered in rows of the batch vectors
+		// without the writer queue, the batches would only add copies of the values
+		m_batchSize = std::max(settings.GetNtupleBatchSize(), static_cast<size_t>(1));
+		m_batch.nEvents = 0;
+		m_writerQueueSize = settings.GetNtupleWriterQueueSize();
+		if ((m_writerQueueSize == 0) && (m_batchSize > 1))
 		{
-			if (LambdaNtupleQuantities::CommonFloatQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_floatValues[floatQuantityIndex]), (*quantity + "/F").c_str());
-				++floatQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonIntQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_intValues[intQuantityIndex]), (*quantity + "/I").c_str());
-				++intQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonUInt64Quantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_uint64Values[uint64QuantityIndex]), (*quantity + "/l").c_str());
-				++uint64QuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonDoubleQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_doubleValues[doubleQuantityIndex]), (*quantity + "/D").c_str());
-				++doubleQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVDoubleQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vDoubleValues[vDoubleQuantityIndex]));
-				++vDoubleQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVFloatQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vFloatValues[vFloatQuantityIndex]));
-				++vFloatQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonBoolQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_boolValues[boolQuantityIndex]), (*quantity + "/O").c_str());
-				++boolQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonPtEtaPhiMVectorQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), "ROOT::Math::PtEtaPhiMVector", &(m_ptEtaPhiMVectorValues[ptEtaPhiMVectorQuantityIndex]));
-				++ptEtaPhiMVectorQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonRMFLVQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_rmflvValues[rmflvQuantityIndex]));
-				++rmflvQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVRMFLVQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vRMFLVValues[vRMFLVQuantityIndex]));
-				++vRMFLVQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonStringQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_stringValues[stringQuantityIndex]));
-				++stringQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVStringQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vStringValues[vStringQuantityIndex]));
-				++vStringQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVIntQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vIntValues[vIntQuantityIndex]));
-				++vIntQuantityIndex;
+			LOG(WARNING) << "NtupleBatchSize = " << m_batchSize << " is ignored (pipeline \"" << settings.GetName()
+			             << "\"), since the batches are only used with NtupleWriterQueueSize > 0.";
+			m_batchSize = 1;
+		}
+		m_useBatch = (m_writerQueueSize > 0);
+		if (m_useBatch)
+		{
+			m_batch.boolValues.resize(m_boolValues.size() * m_batchSize);
+			m_batch.intValues.resize(m_intValues.size() * m_batchSize);
+			m_batch.uint64Values.resize(m_uint64Values.size() * m_batchSize);
+			m_batch.floatValues.resize(m_floatValues.size() * m_batchSize);
+			m_batch.doubleValues.resize(m_doubleValues.size() * m_batchSize);
+			m_batch.ptEtaPhiMVectorValues.resize(m_ptEtaPhiMVectorValues.size() * m_batchSize);
+			m_batch.rmflvValues.resize(m_rmflvValues.size() * m_batchSize);
+			m_batch.stringValues.resize(m_stringValues.size() * m_batchSize);
+			m_batch.vDoubleValues.resize(m_vDoubleValues.size() * m_batchSize);
+			m_batch.vFloatValues.resize(m_vFloatValues.size() * m_batchSize);
+			m_batch.vRMFLVValues.resize(m_vRMFLVValues.size() * m_batchSize);
+			m_batch.vStringValues.resize(m_vStringValues.size() * m_batchSize);
+			m_batch.vIntValues.resize(m_vIntValues.size() * m_batchSize);
+		}
+
+		// create columns and value fillers in the order of the quantities
+		m_fillers.clear();
+		m_fillers.reserve(m_quantities.size());
+		for (std::vector<std::string>::const_iterator quantityIt = m_quantities.begin(); quantityIt != m_quantities.end(); ++quantityIt)
+		{
+			std::string const& quantity = *quantityIt;
+			std::pair<LambdaNtupleQuantities::Kind, size_t> const& column = m_quantityColumns.at(quantity);
+			LambdaNtupleQuantities::Kind kind = column.first;
+			size_t valueIndex = column.second;
+
+			switch (kind)
+			{
+			case LambdaNtupleQuantities::Kind::Bool:
+				AddValueFiller(quantity, kind, m_boolValues, m_batch.boolValues, valueIndex, SafeMap::Get(GetBoolQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::Int:
+				AddValueFiller(quantity, kind, m_intValues, m_batch.intValues, valueIndex, SafeMap::Get(GetIntQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::UInt64:
+				AddValueFiller(quantity, kind, m_uint64Values, m_batch.uint64Values, valueIndex, SafeMap::Get(GetUInt64Quantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::Float:
+				AddValueFiller(quantity, kind, m_floatValues, m_batch.floatValues, valueIndex, SafeMap::Get(GetFloatQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::Double:
+				AddValueFiller(quantity, kind, m_doubleValues, m_batch.doubleValues, valueIndex, SafeMap::Get(GetDoubleQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::PtEtaPhiMVector:
+				AddValueFiller(quantity, kind, m_ptEtaPhiMVectorValues, m_batch.ptEtaPhiMVectorValues, valueIndex, SafeMap::Get(GetPtEtaPhiMVectorQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::RMFLV:
+				AddValueFiller(quantity, kind, m_rmflvValues, m_batch.rmflvValues, valueIndex, SafeMap::Get(GetRMFLVQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::String:
+				AddValueFiller(quantity, kind, m_stringValues, m_batch.stringValues, valueIndex, SafeMap::Get(GetStringQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::VDouble:
+				AddVectorFiller(quantity, kind, m_vDoubleValues, m_batch.vDoubleValues, valueIndex, GetInPlaceValueExtractor(GetVDoubleQuantities(), GetVDoubleInPlaceQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::VFloat:
+				AddVectorFiller(quantity, kind, m_vFloatValues, m_batch.vFloatValues, valueIndex, GetInPlaceValueExtractor(GetVFloatQuantities(), GetVFloatInPlaceQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::VRMFLV:
+				AddVectorFiller(quantity, kind, m_vRMFLVValues, m_batch.vRMFLVValues, valueIndex, GetInPlaceValueExtractor(GetVRMFLVQuantities(), GetVRMFLVInPlaceQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::VString:
+				AddVectorFiller(quantity, kind, m_vStringValues, m_batch.vStringValues, valueIndex, GetInPlaceValueExtractor(GetVStringQuantities(), GetVStringInPlaceQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::VInt:
+				AddVectorFiller(quantity, kind, m_vIntValues, m_batch.vIntValues, valueIndex, GetInPlaceValueExtractor(GetVIntQuantities(), GetVIntInPlaceQuantities(), quantity));
+				break;
+			case LambdaNtupleQuantities::Kind::NKinds:
+			default:
+				LOG(FATAL) << "Invalid type of quantity \"" << quantity << "\" (pipeline \"" << settings.GetName() << "\")!";
 			}
 		}
+		m_outputBackend->Init();
 	}
 
 	void ProcessFilteredEvent(event_type const& event, product_type const& product, setting_type const& settings ) override
@@ -476,242 +551,256 @@ public:
 		ConsumerBase<TTypes>::ProcessFilteredEvent(event, product, settings);
 
 		// calculate values
-		size_t boolValueIndex = 0;
-		for(typename std::vector<bool_extractor_lambda_base>::iterator valueExtractor = m_boolValueExtractors.begin();
-		    valueExtractor != m_boolValueExtractors.end(); ++valueExtractor)
+		size_t quantityIndex = 0;
+		try
 		{
-			try
+			for (; quantityIndex < m_fillers.size(); ++quantityIndex)
 			{
-				m_boolValues[boolValueIndex] = (*valueExtractor)(event, product);
+				ValueFiller const& filler = m_fillers[quantityIndex];
+				filler.fill(event, product, static_cast<char*>(filler.buffer) + (m_batch.nEvents * filler.rowSize));
 			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for bool quantity \"" << m_boolQuantities.at(boolValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++boolValueIndex;
 		}
-
-		size_t intValueIndex = 0;
-		for(typename std::vector<int_extractor_lambda_base>::iterator valueExtractor = m_intValueExtractors.begin();
-		    valueExtractor != m_intValueExtractors.end(); ++valueExtractor)
+		catch (...)
 		{
-			try
-			{
-				m_intValues[intValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for int quantity \"" << m_intQuantities.at(intValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++intValueIndex;
+			LOG(FATAL) << "Could not call lambda function for " << LambdaNtupleQuantities::GetKindName(m_fillers[quantityIndex].kind)
+			           << " quantity \"" << m_quantities.at(quantityIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
 		}
 
-		size_t uint64ValueIndex = 0;
-		for(typename std::vector<uint64_extractor_lambda_base>::iterator valueExtractor = m_uint64ValueExtractors.begin();
-		    valueExtractor != m_uint64ValueExtractors.end(); ++valueExtractor)
+		// fill tree
+		if (m_useBatch)
 		{
-			try
-			{
-				m_uint64Values[uint64ValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
+			++m_batch.nEvents;
+			if (m_batch.nEvents == m_batchSize)
 			{
-				LOG(FATAL) << "Could not call lambda function for uint64 quantity \"" << m_uint64Quantities.at(uint64ValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
+				WriteBatch();
 			}
-			++uint64ValueIndex;
 		}
-
-		size_t floatValueIndex = 0;
-		for(typename std::vector<float_extractor_lambda_base>::iterator valueExtractor = m_floatValueExtractors.begin();
-		    valueExtractor != m_floatValueExtractors.end(); ++valueExtractor)
+		else
 		{
-			try
-			{
-				m_floatValues[floatValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for float quantity \"" << m_floatQuantities.at(floatValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++floatValueIndex;
+			std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
+			m_outputBackend->Fill();
 		}
+	}
 
-		size_t doubleValueIndex = 0;
-		for(typename std::vector<double_extractor_lambda_base>::iterator valueExtractor = m_doubleValueExtractors.begin();
-		    valueExtractor != m_doubleValueExtractors.end(); ++valueExtractor)
+	void Finish(setting_type const& settings) override
+	{
+		WriteBatch();
+		OutputWriter::GetInstance().Flush();
+		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
+		m_outputBackend->Write();
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& settings) override
+	{
+		auto & specOther = static_cast<LambdaNtupleConsumer<TTypes> &>(other);
+		WriteBatch();
+		specOther.WriteBatch();
+		OutputWriter::GetInstance().Flush();
+		for (long long entry = 0; entry < specOther.m_outputBackend->GetEntries(); ++entry)
 		{
-			try
-			{
-				m_doubleValues[doubleValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for double quantity \"" << m_doubleQuantities.at(doubleValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++doubleValueIndex;
+			specOther.m_outputBackend->GetEntry(entry);
+
+			m_boolValues = specOther.m_boolValues;
+			m_intValues = specOther.m_intValues;
+			m_uint64Values = specOther.m_uint64Values;
+			m_floatValues = specOther.m_floatValues;
+			m_doubleValues = specOther.m_doubleValues;
+			m_ptEtaPhiMVectorValues = specOther.m_ptEtaPhiMVectorValues;
+			m_rmflvValues = specOther.m_rmflvValues;
+			m_stringValues = specOther.m_stringValues;
+			m_vDoubleValues = specOther.m_vDoubleValues;
+			m_vFloatValues = specOther.m_vFloatValues;
+			m_vRMFLVValues = specOther.m_vRMFLVValues;
+			m_vStringValues = specOther.m_vStringValues;
+			m_vIntValues = specOther.m_vIntValues;
+
+			m_outputBackend->Fill();
 		}
-		
-		size_t ptEtaPhiMVectorValueIndex = 0;
-		for(typename std::vector<ptEtaPhiMVector_extractor_lambda_base>::iterator valueExtractor = m_ptEtaPhiMVectorValueExtractors.begin();
-		    valueExtractor != m_ptEtaPhiMVectorValueExtractors.end(); ++valueExtractor)
+	}
+
+protected:
+	// derived consumers may fill additional branches, which are not merged by Merge, therefore
+	// they have to enable merging explicitly by overwriting IsMergeable, e.g. with this method
+	bool IsOutputMergeable() const
+	{
+		return ((! m_outputBackend) || m_outputBackend->IsMergeable());
+	}
+
+private:
+	std::unique_ptr<NtupleOutputBackend> m_outputBackend;
+
+	/// values of several events, the values of each type are stored in rows of the length of the
+	/// corresponding column buffer
+	struct Batch
+	{
+		size_t nEvents = 0;
+		std::vector<char> boolValues;
+		std::vector<int> intValues;
+		std::vector<uint64_t> uint64Values;
+		std::vector<float> floatValues;
+		std::vector<double> doubleValues;
+		std::vector<ROOT::Math::PtEtaPhiMVector> ptEtaPhiMVectorValues;
+		std::vector<RMFLV> rmflvValues;
+		std::vector<std::string> stringValues;
+		std::vector<std::vector<double> > vDoubleValues;
+		std::vector<std::vector<float> > vFloatValues;
+		std::vector<std::vector<RMFLV> > vRMFLVValues;
+		std::vector<std::vector<std::string> > vStringValues;
+		std::vector<std::vector<int> > vIntValues;
+
+		/// exchanges the values element by element, such that the storage of both batches is kept
+		void Swap(Batch& other)
 		{
-			try
-			{
-				m_ptEtaPhiMVectorValues[ptEtaPhiMVectorValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for ROOT::Math::PtEtaPhiMVector quantity \"" << m_ptEtaPhiMVectorQuantities.at(ptEtaPhiMVectorValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++ptEtaPhiMVectorValueIndex;
+			std::swap(nEvents, other.nEvents);
+			std::swap_ranges(boolValues.begin(), boolValues.end(), other.boolValues.begin());
+			std::swap_ranges(intValues.begin(), intValues.end(), other.intValues.begin());
+			std::swap_ranges(uint64Values.begin(), uint64Values.end(), other.uint64Values.begin());
+			std::swap_ranges(floatValues.begin(), floatValues.end(), other.floatValues.begin());
+			std::swap_ranges(doubleValues.begin(), doubleValues.end(), other.doubleValues.begin());
+			std::swap_ranges(ptEtaPhiMVectorValues.begin(), ptEtaPhiMVectorValues.end(), other.ptEtaPhiMVectorValues.begin());
+			std::swap_ranges(rmflvValues.begin(), rmflvValues.end(), other.rmflvValues.begin());
+			std::swap_ranges(stringValues.begin(), stringValues.end(), other.stringValues.begin());
+			std::swap_ranges(vDoubleValues.begin(), vDoubleValues.end(), other.vDoubleValues.begin());
+			std::swap_ranges(vFloatValues.begin(), vFloatValues.end(), other.vFloatValues.begin());
+			std::swap_ranges(vRMFLVValues.begin(), vRMFLVValues.end(), other.vRMFLVValues.begin());
+			std::swap_ranges(vStringValues.begin(), vStringValues.end(), other.vStringValues.begin());
+			std::swap_ranges(vIntValues.begin(), vIntValues.end(), other.vIntValues.begin());
 		}
-		
-		size_t rmflvValueIndex = 0;
-		for(typename std::vector<rmflv_extractor_lambda_base>::iterator valueExtractor = m_rmflvValueExtractors.begin();
-		    valueExtractor != m_rmflvValueExtractors.end(); ++valueExtractor)
+	};
+
+	/// computes the value of one quantity and writes it into its column buffer or into the
+	/// current row of the batch buffer
+	struct ValueFiller
+	{
+		void* buffer;
+		size_t rowSize;
+		std::function<void(EventBase const&, ProductBase const&, void*)> fill;
+		LambdaNtupleQuantities::Kind kind;
+	};
+
+	template<class TValue>
+	void AddFiller(std::string const& quantity, LambdaNtupleQuantities::Kind kind,
+	               std::vector<TValue>& values, std::vector<TValue>& batch, size_t valueIndex,
+	               std::function<void(EventBase const&, ProductBase const&, void*)> fill)
+	{
+		m_outputBackend->AddColumn(quantity, kind, &(values[valueIndex]));
+		if (m_useBatch)
 		{
-			try
-			{
-				m_rmflvValues[rmflvValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for RMFLV quantity \"" << m_rmflvQuantities.at(rmflvValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++rmflvValueIndex;
+			m_fillers.push_back(ValueFiller{&(batch[valueIndex]), values.size() * sizeof(TValue), fill, kind});
 		}
-		
-		size_t stringValueIndex = 0;
-		for(typename std::vector<string_extractor_lambda_base>::iterator valueExtractor = m_stringValueExtractors.begin();
-		    valueExtractor != m_stringValueExtractors.end(); ++valueExtractor)
+		else
 		{
-			try
-			{
-				m_stringValues[stringValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for string quantity \"" << m_stringQuantities.at(stringValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++stringValueIndex;
+			m_fillers.push_back(ValueFiller{&(values[valueIndex]), 0, fill, kind});
 		}
-		
-		size_t vDoubleValueIndex = 0;
-		for(typename std::vector<vDouble_extractor_lambda_base>::iterator valueExtractor = m_vDoubleValueExtractors.begin();
-		    valueExtractor != m_vDoubleValueExtractors.end(); ++valueExtractor)
+	}
+
+	template<class TValue, class T>
+	void AddValueFiller(std::string const& quantity, LambdaNtupleQuantities::Kind kind,
+	                    std::vector<TValue>& values, std::vector<TValue>& batch, size_t valueIndex,
+	                    std::function<T(EventBase const&, ProductBase const&)> const& valueExtractor)
+	{
+		AddFiller(quantity, kind, values, batch, valueIndex, [valueExtractor](EventBase const& event, ProductBase const& product, void* buffer)
 		{
-			try
-			{
-				m_vDoubleValues[vDoubleValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vDouble quantity \"" << m_vDoubleQuantities.at(vDoubleValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vDoubleValueIndex;
-		}
-		
-		size_t vFloatValueIndex = 0;
-		for(typename std::vector<vFloat_extractor_lambda_base>::iterator valueExtractor = m_vFloatValueExtractors.begin();
-		    valueExtractor != m_vFloatValueExtractors.end(); ++valueExtractor)
+			*static_cast<TValue*>(buffer) = valueExtractor(event, product);
+		});
+	}
+
+	template<class T>
+	void AddVectorFiller(std::string const& quantity, LambdaNtupleQuantities::Kind kind,
+	                     std::vector<T>& values, std::vector<T>& batch, size_t valueIndex,
+	                     std::function<void(EventBase const&, ProductBase const&, T&)> const& valueExtractor)
+	{
+		AddFiller(quantity, kind, values, batch, valueIndex, [valueExtractor](EventBase const& event, ProductBase const& product, void* buffer)
 		{
-			try
-			{
-				m_vFloatValues[vFloatValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vFloat quantity \"" << m_vFloatQuantities.at(vFloatValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vFloatValueIndex;
+			valueExtractor(event, product, *static_cast<T*>(buffer));
+		});
+	}
+
+	/// moves one row of a batch into the column buffers, the vectors are swapped, such that their
+	/// memory is reused by the next batch
+	template<class T>
+	static void CopyRow(std::vector<T>& values, std::vector<T> const& batch, size_t row)
+	{
+		std::copy(batch.begin() + (row * values.size()), batch.begin() + ((row + 1) * values.size()), values.begin());
+	}
+
+	template<class T>
+	static void SwapRow(std::vector<T>& values, std::vector<T>& batch, size_t row)
+	{
+		std::swap_ranges(values.begin(), values.end(), batch.begin() + (row * values.size()));
+	}
+
+	/// fills the buffered events into the output, the caller has to exclude the OutputWriter
+	void FillBatch(Batch& batch)
+	{
+		for (size_t row = 0; row < batch.nEvents; ++row)
+		{
+			CopyRow(m_boolValues, batch.boolValues, row);
+			CopyRow(m_intValues, batch.intValues, row);
+			CopyRow(m_uint64Values, batch.uint64Values, row);
+			CopyRow(m_floatValues, batch.floatValues, row);
+			CopyRow(m_doubleValues, batch.doubleValues, row);
+			CopyRow(m_ptEtaPhiMVectorValues, batch.ptEtaPhiMVectorValues, row);
+			CopyRow(m_rmflvValues, batch.rmflvValues, row);
+			SwapRow(m_stringValues, batch.stringValues, row);
+			SwapRow(m_vDoubleValues, batch.vDoubleValues, row);
+			SwapRow(m_vFloatValues, batch.vFloatValues, row);
+			SwapRow(m_vRMFLVValues, batch.vRMFLVValues, row);
+			SwapRow(m_vStringValues, batch.vStringValues, row);
+			SwapRow(m_vIntValues, batch.vIntValues, row);
+
+			m_outputBackend->Fill();
 		}
-		
-		size_t vRMFLVValueIndex = 0;
-		for(typename std::vector<vRMFLV_extractor_lambda_base>::iterator valueExtractor = m_vRMFLVValueExtractors.begin();
-		    valueExtractor != m_vRMFLVValueExtractors.end(); ++valueExtractor)
+		batch.nEvents = 0;
+	}
+
+	/// fills the buffered events into the output or hands them over to the OutputWriter,
+	/// at most NtupleWriterQueueSize batches are pending, further calls wait for the writer
+	void WriteBatch()
+	{
+		if (m_batch.nEvents == 0)
 		{
-			try
-			{
-				m_vRMFLVValues[vRMFLVValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vRMFLV quantity \"" << m_vRMFLVQuantities.at(vRMFLVValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vRMFLVValueIndex;
+			return;
 		}
-		
-		size_t vStringValueIndex = 0;
-		for(typename std::vector<vString_extractor_lambda_base>::iterator valueExtractor = m_vStringValueExtractors.begin();
-		    valueExtractor != m_vStringValueExtractors.end(); ++valueExtractor)
+
+		if (m_writerQueueSize == 0)
 		{
-			try
-			{
-				m_vStringValues[vStringValueIndex] = (*valueExtractor)(event, product);
-			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vString quantity \"" << m_vStringQuantities.at(vStringValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vStringValueIndex;
+			std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
+			FillBatch(m_batch);
+			return;
 		}
 
-		size_t vIntValueIndex = 0;
-		for(typename std::vector<vInt_extractor_lambda_base>::iterator valueExtractor = m_vIntValueExtractors.begin();
-		    valueExtractor != m_vIntValueExtractors.end(); ++valueExtractor)
+		Batch* batch = nullptr;
 		{
-			try
+			std::unique_lock<std::mutex> lock(m_batchMutex);
+			m_batchCondition.wait(lock, [this]() { return (m_nPendingBatches < m_writerQueueSize); });
+			++m_nPendingBatches;
+			if (m_freeBatches.empty())
 			{
-				m_vIntValues[vIntValueIndex] = (*valueExtractor)(event, product);
+				m_freeBatches.push_back(std::unique_ptr<Batch>(new Batch(m_batch)));
 			}
-			catch (...)
-			{
-				LOG(FATAL) << "Could not call lambda function for vInt quantity \"" << m_vIntQuantities.at(vIntValueIndex) << "\" (pipeline \"" << settings.GetName() << "\")!";
-			}
-			++vIntValueIndex;
+			batch = m_freeBatches.back().release();
+			m_freeBatches.pop_back();
 		}
 
-		// fill tree
-		this->m_tree->Fill();
-	}
+		// the value fillers keep writing into m_batch
+		m_batch.Swap(*batch);
+		m_batch.nEvents = 0;
 
-	void Finish(setting_type const& settings) override
-	{
-		RootFileHelper::SafeCd(settings.GetRootOutFile(), settings.GetRootFileFolder());
-		m_tree->Write(m_tree->GetName());
-	}
+		OutputWriter::GetInstance().Submit([this, batch]() {
+			FillBatch(*batch);
 
+			std::lock_guard<std::mutex> lock(m_batchMutex);
+			m_freeBatches.push_back(std::unique_ptr<Batch>(batch));
+			--m_nPendingBatches;
+			m_batchCondition.notify_one();
+		});
+	}
 
-private:
-	TTree* m_tree = nullptr;
-
-	std::vector<bool_extractor_lambda_base> m_boolValueExtractors;
-	std::vector<int_extractor_lambda_base> m_intValueExtractors;
-	std::vector<uint64_extractor_lambda_base> m_uint64ValueExtractors;
-	std::vector<float_extractor_lambda_base> m_floatValueExtractors;
-	std::vector<double_extractor_lambda_base> m_doubleValueExtractors;
-	std::vector<ptEtaPhiMVector_extractor_lambda_base> m_ptEtaPhiMVectorValueExtractors;
-	std::vector<rmflv_extractor_lambda_base> m_rmflvValueExtractors;
-	std::vector<string_extractor_lambda_base> m_stringValueExtractors;
-	std::vector<vDouble_extractor_lambda_base> m_vDoubleValueExtractors;
-	std::vector<vFloat_extractor_lambda_base> m_vFloatValueExtractors;
-	std::vector<vRMFLV_extractor_lambda_base> m_vRMFLVValueExtractors;
-	std::vector<vString_extractor_lambda_base> m_vStringValueExtractors;
-	std::vector<vInt_extractor_lambda_base> m_vIntValueExtractors;
-
-	std::vector<std::string> m_boolQuantities;
-	std::vector<std::string> m_intQuantities;
-	std::vector<std::string> m_uint64Quantities;
-	std::vector<std::string> m_floatQuantities;
-	std::vector<std::string> m_doubleQuantities;
-	std::vector<std::string> m_ptEtaPhiMVectorQuantities;
-	std::vector<std::string> m_rmflvQuantities;
-	std::vector<std::string> m_stringQuantities;
-	std::vector<std::string> m_vDoubleQuantities;
-	std::vector<std::string> m_vFloatQuantities;
-	std::vector<std::string> m_vRMFLVQuantities;
-	std::vector<std::string> m_vStringQuantities;
-	std::vector<std::string> m_vIntQuantities;
+	std::vector<std::string> m_quantities;
+	// type of each quantity and index of its value in the buffer of this type, filled by Init
+	std::map<std::string, std::pair<LambdaNtupleQuantities::Kind, size_t> > m_quantityColumns;
+	std::vector<ValueFiller> m_fillers;
 
 	std::vector<char> m_boolValues; // needs to be char vector because of bitset treatment of bool vector
 	std::vector<int> m_intValues;
@@ -726,5 +815,17 @@ private:
 	std::vector<std::vector<RMFLV> > m_vRMFLVValues;
 	std::vector<std::vector<std::string> > m_vStringValues;
 	std::vector<std::vector<int> > m_vIntValues;
+
+	// values of the buffered events, one row per event (see NtupleBatchSize)
+	size_t m_batchSize = 1;
+	bool m_useBatch = false;
+	Batch m_batch;
+
+	// batches handed to the OutputWriter (see NtupleWriterQueueSize)
+	size_t m_writerQueueSize = 0;
+	size_t m_nPendingBatches = 0;
+	std::vector<std::unique_ptr<Batch> > m_freeBatches;
+	std::mutex m_batchMutex;
+	std::condition_variable m_batchCondition;
 };
 
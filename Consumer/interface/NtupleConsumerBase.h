@@ -6,6 +6,7 @@
 #include <TNtuple.h>
 
 #include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/Core/interface/OutputWriter.h"
 #include "Artus/Utility/interface/RootFileHelper.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 
@@ -62,6 +63,7 @@ public:
 		}
 
 		// add the array to the ntuple
+		std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
 		m_ntuple->Fill(&array[0]);
 	}
 
@@ -75,6 +77,21 @@ public:
 	}
 
 
+	bool IsMergeable() const override
+	{
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override
+	{
+		TNtuple* otherNtuple = static_cast<NtupleConsumerBase<TTypes> &>(other).m_ntuple;
+		for (Long64_t entry = 0; entry < otherNtuple->GetEntries(); ++entry)
+		{
+			otherNtuple->GetEntry(entry);
+			m_ntuple->Fill(otherNtuple->GetArgs());
+		}
+	}
+
 protected:
 	TNtuple* m_ntuple;
 	std::vector<std::string> m_quantitiesVector;
@@ -0,0 +1,155 @@
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <RVersion.h>
+#include <TDirectory.h>
+#include <TTree.h>
+#include <Math/Vector4D.h>
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,32,0)
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+
+// the RNTuple classes moved out of ROOT::Experimental with ROOT 6.36
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+namespace RNTupleApi = ROOT;
+#else
+namespace RNTupleApi = ROOT::Experimental;
+#endif
+#endif
+
+#include "Artus/Utility/interface/Utility.h"
+
+
+/// type of a column of an ntuple, see LambdaNtupleQuantities
+enum class NtupleColumnKind : size_t
+{
+	Bool, Int, UInt64, Float, Double, PtEtaPhiMVector, RMFLV, String,
+	VDouble, VFloat, VRMFLV, VString, VInt,
+	NKinds
+};
+
+
+/**
+   \brief Writes the columns of the LambdaNtupleConsumer into an output format.
+
+   The consumer owns the buffers of the columns and writes the values of one event into them before
+   calling Fill. The buffers have the types of the LambdaNtupleConsumer (bool values are stored as
+   char) and must not be moved after AddColumn has been called.
+*/
+class NtupleOutputBackend: public boost::noncopyable
+{
+public:
+
+	virtual ~NtupleOutputBackend() {}
+
+	virtual void AddColumn(std::string const& name, NtupleColumnKind kind, void* buffer) = 0;
+
+	/// to be called after all columns have been added
+	virtual void Init() {}
+
+	virtual void Fill() = 0;
+	virtual void Write() = 0;
+
+	/// backends, which can read back their entries into the buffers, support merging
+	virtual bool IsMergeable() const
+	{
+		return false;
+	}
+	virtual long long GetEntries() const
+	{
+		return 0;
+	}
+	virtual void GetEntry(long long entry) {}
+};
+
+
+/// TTree with one branch per column
+class TreeNtupleOutputBackend: public NtupleOutputBackend
+{
+public:
+
+	TreeNtupleOutputBackend(TDirectory* directory, std::string const& name, std::string const& title,
+	                        int compressionSettings = -1);
+
+	void AddColumn(std::string const& name, NtupleColumnKind kind, void* buffer) override;
+
+	void Init() override;
+	void Fill() override;
+	void Write() override;
+
+	bool IsMergeable() const override;
+	long long GetEntries() const override;
+	void GetEntry(long long entry) override;
+
+private:
+	TTree* m_tree = nullptr;
+	int m_compressionSettings;
+};
+
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,32,0)
+/**
+   \brief RNTuple with one field per column
+
+   Lorentz vectors are split into one field per component (e.g. name_pt, name_eta, name_phi and
+   name_mass), vectors of Lorentz vectors into one vector field per component. Bool columns are
+   written as bool fields.
+*/
+class RNTupleOutputBackend: public NtupleOutputBackend
+{
+public:
+
+	RNTupleOutputBackend(TDirectory* directory, std::string const& name, int compressionSettings = -1);
+
+	void AddColumn(std::string const& name, NtupleColumnKind kind, void* buffer) override;
+
+	void Init() override;
+	void Fill() override;
+	void Write() override;
+
+private:
+
+	template<class T>
+	void AddField(std::string const& name, T* buffer);
+
+	/// adds a field with its own buffer, which is filled from the buffer of the consumer before each Fill
+	template<class T, class TConversion>
+	void AddConvertedField(std::string const& name, TConversion const& conversion);
+
+	template<class T>
+	void AddLorentzVectorFields(std::string const& name, T const* buffer);
+
+	template<class T>
+	void AddLorentzVectorsFields(std::string const& name, std::vector<T> const* buffer);
+
+	TDirectory* m_directory;
+	std::string m_name;
+	int m_compressionSettings;
+
+	std::unique_ptr<RNTupleApi::RNTupleModel> m_model;
+	std::unique_ptr<RNTupleApi::RNTupleWriter> m_writer;
+	std::unique_ptr<RNTupleApi::REntry> m_entry;
+
+	// fields are bound to the buffers after the writer has been created
+	std::vector<std::function<void(RNTupleApi::REntry&)>> m_bindings;
+	// conversions from the buffers of the consumer into the buffers of the converted fields,
+	// which are owned by the conversions
+	std::vector<std::function<void()>> m_conversions;
+};
+#endif
+
+
+/// creates the backend selected by the NtupleOutputBackend setting ("TTree" or "RNTuple"),
+/// negative compression settings keep the settings of the output file
+std::unique_ptr<NtupleOutputBackend> CreateNtupleOutputBackend(std::string const& backendName, TDirectory* directory,
+                                                               std::string const& name, std::string const& title,
+                                                               int compressionSettings = -1);
+
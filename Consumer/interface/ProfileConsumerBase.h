@@ -95,6 +95,14 @@ public:
 		m_profile->Store(setting.GetRootOutFile());
 	}
 
+	bool IsMergeable() const override {
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override {
+		m_profile->m_profile->Add(static_cast<ProfileConsumerBase<TTypes> &>(other).m_profile->m_profile.get());
+	}
+
 	void SetPlotName(std::string plotName) {
 		m_plotName = plotName;
 	}
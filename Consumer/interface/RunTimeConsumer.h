@@ -8,7 +8,8 @@
 #include <TTree.h>
 
 #include "Artus/Core/interface/ConsumerBase.h"
-#include "Artus/Utility/interface/SafeMap.h"
+#include "Artus/Core/interface/RunTimeProfiler.h"
+#include "Artus/Core/interface/OutputWriter.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 #include "Artus/Configuration/interface/ArtusConfig.h"
 
@@ -26,6 +27,11 @@ public:
 		return "RunTimeConsumer";
 	}
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override
+	{
+		return true;
+	}
+
 	RunTimeConsumer():
 		ConsumerBase<TTypes>()
 	{
@@ -61,6 +67,41 @@ public:
 				setting.GetRootFileFolder());
 
 		m_tree->Write("runTime");
+
+		// summary of the run times of all processors in microseconds
+		std::vector<std::pair<std::string, TH1D*> > summaryHistograms = {
+			std::pair<std::string, TH1D*>("mean", nullptr),
+			std::pair<std::string, TH1D*>("p50", nullptr),
+			std::pair<std::string, TH1D*>("p99", nullptr),
+			std::pair<std::string, TH1D*>("max", nullptr)
+		};
+		int nProcessors = m_processorNames.size();
+		for (auto & summaryHistogram : summaryHistograms)
+		{
+			std::string name = "runTimeSummary_" + summaryHistogram.first;
+			std::string title = "Run time (" + summaryHistogram.first + ") [#mus]";
+			summaryHistogram.second = new TH1D(name.c_str(), title.c_str(), nProcessors, 0.0, nProcessors);
+		}
+		for (int processorIndex = 0; processorIndex < nProcessors; ++processorIndex)
+		{
+			RunTimeStatistics statistics = GetStatistics(processorIndex);
+			std::vector<double> values = {
+				statistics.GetMean(),
+				statistics.GetQuantile(0.5),
+				statistics.GetQuantile(0.99),
+				statistics.GetMax()
+			};
+			for (size_t summaryIndex = 0; summaryIndex < summaryHistograms.size(); ++summaryIndex)
+			{
+				TH1D* summaryHistogram = summaryHistograms[summaryIndex].second;
+				summaryHistogram->GetXaxis()->SetBinLabel(processorIndex+1, m_processorNames[processorIndex].c_str());
+				summaryHistogram->SetBinContent(processorIndex+1, values[summaryIndex]);
+			}
+		}
+		for (auto & summaryHistogram : summaryHistograms)
+		{
+			summaryHistogram.second->Write(summaryHistogram.second->GetName());
+		}
 	}
 
 	void ProcessEvent(event_type const& event,
@@ -70,20 +111,113 @@ public:
 	{
 		ConsumerBase<TTypes>::ProcessEvent(event, product, setting, filterResult);
 
+		if (! m_profilersResolved)
+		{
+			ResolveProfilers(product);
+		}
+
+		// the run times are only available for sampled events
+		if ((product.localRunTimeProfiler != nullptr) && (! product.localRunTimeProfiler->IsSampling()))
+		{
+			return;
+		}
+
 		// set values of runtime
-		int i=0;
-		for (std::string processor : m_processorNames) {
-			m_runTime[i]=SafeMap::GetWithDefault (product.processorRunTime, processor, DefaultValues::UndefinedInt);
-			++i;
+		for (size_t processorIndex = 0; processorIndex < m_processorNames.size(); ++processorIndex)
+		{
+			RunTimeProfiler const* profiler = m_profilers[processorIndex];
+			m_runTime[processorIndex] = ((profiler != nullptr) ? profiler->GetRunTime(m_profilerNodes[processorIndex]) : DefaultValues::UndefinedInt);
 		}
 
 		// fill tree
+		std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
 		m_tree->Fill();
 	}
 
+	bool IsMergeable() const override
+	{
+		return true;
+	}
+
+	void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) override
+	{
+		auto & specOther = static_cast<RunTimeConsumer<TTypes> &>(other);
+		for (Long64_t entry = 0; entry < specOther.m_tree->GetEntries(); ++entry)
+		{
+			specOther.m_tree->GetEntry(entry);
+			m_runTime = specOther.m_runTime;
+			m_tree->Fill();
+		}
+
+		m_mergedStatistics.resize(m_processorNames.size());
+		for (size_t processorIndex = 0; processorIndex < m_processorNames.size(); ++processorIndex)
+		{
+			m_mergedStatistics[processorIndex].Merge(specOther.GetStatistics(processorIndex));
+		}
+	}
+
 protected:
 	std::vector<std::string> m_processorNames;
 	std::vector<int> m_runTime;
 	TTree* m_tree = 0;
 
+private:
+
+	// find the run time slots of the processors in the profilers of the global nodes and the pipeline
+	// the producers shared with other pipelines are measured by the profilers of the shared prefixes
+	void ResolveProfilers(product_type const& product)
+	{
+		std::vector<RunTimeProfiler const*> profilers;
+		if (product.localRunTimeProfiler != nullptr)
+		{
+			for (RunTimeProfiler const* sharedProfiler = product.localRunTimeProfiler->GetSharedProfiler();
+			     sharedProfiler != nullptr; sharedProfiler = sharedProfiler->GetSharedProfiler())
+			{
+				profilers.push_back(sharedProfiler);
+			}
+		}
+		profilers.push_back(product.localRunTimeProfiler);
+		profilers.push_back(product.globalRunTimeProfiler);
+
+		m_profilers.assign(m_processorNames.size(), nullptr);
+		m_profilerNodes.assign(m_processorNames.size(), RunTimeProfiler::UnknownNode);
+		for (size_t processorIndex = 0; processorIndex < m_processorNames.size(); ++processorIndex)
+		{
+			for (RunTimeProfiler const* profiler : profilers)
+			{
+				if (profiler != nullptr)
+				{
+					size_t node = profiler->FindNode(m_processorNames[processorIndex]);
+					if (node != RunTimeProfiler::UnknownNode)
+					{
+						m_profilers[processorIndex] = profiler;
+						m_profilerNodes[processorIndex] = node;
+						break;
+					}
+				}
+			}
+		}
+		m_profilersResolved = true;
+	}
+
+	// statistics of this consumer including the ones merged from other threads
+	RunTimeStatistics GetStatistics(size_t processorIndex) const
+	{
+		RunTimeStatistics statistics;
+		if (m_profilersResolved && (m_profilers[processorIndex] != nullptr))
+		{
+			statistics.Merge(m_profilers[processorIndex]->GetStatistics(m_profilerNodes[processorIndex]));
+		}
+		if (processorIndex < m_mergedStatistics.size())
+		{
+			statistics.Merge(m_mergedStatistics[processorIndex]);
+		}
+		return statistics;
+	}
+
+	bool m_profilersResolved = false;
+	std::vector<RunTimeProfiler const*> m_profilers;
+	std::vector<size_t> m_profilerNodes;
+	std::vector<RunTimeStatistics> m_mergedStatistics;
+
 };
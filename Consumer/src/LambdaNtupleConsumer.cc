@@ -1,6 +1,72 @@
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 
 
+std::string LambdaNtupleQuantities::GetKindName(Kind kind)
+{
+	switch (kind)
+	{
+	case Kind::Bool: return "bool";
+	case Kind::Int: return "int";
+	case Kind::UInt64: return "uint64";
+	case Kind::Float: return "float";
+	case Kind::Double: return "double";
+	case Kind::PtEtaPhiMVector: return "ROOT::Math::PtEtaPhiMVector";
+	case Kind::RMFLV: return "RMFLV";
+	case Kind::String: return "string";
+	case Kind::VDouble: return "vDouble";
+	case Kind::VFloat: return "vFloat";
+	case Kind::VRMFLV: return "vRMFLV";
+	case Kind::VString: return "vString";
+	case Kind::VInt: return "vInt";
+	case Kind::NKinds:
+	default:
+		break;
+	}
+	return "unknown";
+}
+
+bool LambdaNtupleQuantities::GetQuantityKind(std::string const& name, Kind & kind)
+{
+	if (CommonFloatQuantities.count(name) > 0) kind = Kind::Float;
+	else if (CommonIntQuantities.count(name) > 0) kind = Kind::Int;
+	else if (CommonUInt64Quantities.count(name) > 0) kind = Kind::UInt64;
+	else if (CommonDoubleQuantities.count(name) > 0) kind = Kind::Double;
+	else if ((CommonVDoubleQuantities.count(name) > 0) || (CommonVDoubleInPlaceQuantities.count(name) > 0)) kind = Kind::VDouble;
+	else if ((CommonVFloatQuantities.count(name) > 0) || (CommonVFloatInPlaceQuantities.count(name) > 0)) kind = Kind::VFloat;
+	else if (CommonBoolQuantities.count(name) > 0) kind = Kind::Bool;
+	else if ((CommonVIntQuantities.count(name) > 0) || (CommonVIntInPlaceQuantities.count(name) > 0)) kind = Kind::VInt;
+	else if (CommonPtEtaPhiMVectorQuantities.count(name) > 0) kind = Kind::PtEtaPhiMVector;
+	else if (CommonRMFLVQuantities.count(name) > 0) kind = Kind::RMFLV;
+	else if ((CommonVRMFLVQuantities.count(name) > 0) || (CommonVRMFLVInPlaceQuantities.count(name) > 0)) kind = Kind::VRMFLV;
+	else if (CommonStringQuantities.count(name) > 0) kind = Kind::String;
+	else if ((CommonVStringQuantities.count(name) > 0) || (CommonVStringInPlaceQuantities.count(name) > 0)) kind = Kind::VString;
+	else return false;
+	return true;
+}
+
+void LambdaNtupleQuantities::RemoveQuantity(std::string const& name)
+{
+	CommonBoolQuantities.erase(name);
+	CommonIntQuantities.erase(name);
+	CommonUInt64Quantities.erase(name);
+	CommonFloatQuantities.erase(name);
+	CommonDoubleQuantities.erase(name);
+	CommonPtEtaPhiMVectorQuantities.erase(name);
+	CommonRMFLVQuantities.erase(name);
+	CommonStringQuantities.erase(name);
+	CommonVDoubleQuantities.erase(name);
+	CommonVFloatQuantities.erase(name);
+	CommonVRMFLVQuantities.erase(name);
+	CommonVStringQuantities.erase(name);
+	CommonVIntQuantities.erase(name);
+	CommonVDoubleInPlaceQuantities.erase(name);
+	CommonVFloatInPlaceQuantities.erase(name);
+	CommonVRMFLVInPlaceQuantities.erase(name);
+	CommonVStringInPlaceQuantities.erase(name);
+	CommonVIntInPlaceQuantities.erase(name);
+}
+
+
 std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonBoolQuantities
 	= std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >>();
 
@@ -40,5 +106,17 @@ std::map<std::string, std::function<std::vector<std::string>(EventBase const&, P
 std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonVIntQuantities
 	= std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >>();
 
+std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<double>&)>> LambdaNtupleQuantities::CommonVDoubleInPlaceQuantities
+	= std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<double>&)>>();
+
+std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<float>&)>> LambdaNtupleQuantities::CommonVFloatInPlaceQuantities
+	= std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<float>&)>>();
+
+std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<RMFLV>&)>> LambdaNtupleQuantities::CommonVRMFLVInPlaceQuantities
+	= std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<RMFLV>&)>>();
 
+std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<std::string>&)>> LambdaNtupleQuantities::CommonVStringInPlaceQuantities
+	= std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<std::string>&)>>();
 
+std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<int>&)>> LambdaNtupleQuantities::CommonVIntInPlaceQuantities
+	= std::map<std::string, std::function<void(EventBase const&, ProductBase const&, std::vector<int>&)>>();
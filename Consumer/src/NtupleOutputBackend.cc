@@ -0,0 +1,277 @@
+
+#include <utility>
+
+#include "Artus/Consumer/interface/NtupleOutputBackend.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
+
+
+TreeNtupleOutputBackend::TreeNtupleOutputBackend(TDirectory* directory, std::string const& name, std::string const& title,
+                                                 int compressionSettings) :
+	m_compressionSettings(compressionSettings)
+{
+	TDirectory* tmpDirectory = gDirectory;
+	gDirectory = directory;
+	m_tree = new TTree(name.c_str(), title.c_str());
+	gDirectory = tmpDirectory;
+}
+
+void TreeNtupleOutputBackend::AddColumn(std::string const& name, NtupleColumnKind kind, void* buffer)
+{
+	switch (kind)
+	{
+	case NtupleColumnKind::Bool:
+		m_tree->Branch(name.c_str(), static_cast<char*>(buffer), (name + "/O").c_str());
+		break;
+	case NtupleColumnKind::Int:
+		m_tree->Branch(name.c_str(), static_cast<int*>(buffer), (name + "/I").c_str());
+		break;
+	case NtupleColumnKind::UInt64:
+		m_tree->Branch(name.c_str(), static_cast<uint64_t*>(buffer), (name + "/l").c_str());
+		break;
+	case NtupleColumnKind::Float:
+		m_tree->Branch(name.c_str(), static_cast<float*>(buffer), (name + "/F").c_str());
+		break;
+	case NtupleColumnKind::Double:
+		m_tree->Branch(name.c_str(), static_cast<double*>(buffer), (name + "/D").c_str());
+		break;
+	case NtupleColumnKind::PtEtaPhiMVector:
+		m_tree->Branch(name.c_str(), "ROOT::Math::PtEtaPhiMVector", buffer);
+		break;
+	case NtupleColumnKind::RMFLV:
+		m_tree->Branch(name.c_str(), static_cast<RMFLV*>(buffer));
+		break;
+	case NtupleColumnKind::String:
+		m_tree->Branch(name.c_str(), static_cast<std::string*>(buffer));
+		break;
+	case NtupleColumnKind::VDouble:
+		m_tree->Branch(name.c_str(), static_cast<std::vector<double>*>(buffer));
+		break;
+	case NtupleColumnKind::VFloat:
+		m_tree->Branch(name.c_str(), static_cast<std::vector<float>*>(buffer));
+		break;
+	case NtupleColumnKind::VRMFLV:
+		m_tree->Branch(name.c_str(), static_cast<std::vector<RMFLV>*>(buffer));
+		break;
+	case NtupleColumnKind::VString:
+		m_tree->Branch(name.c_str(), static_cast<std::vector<std::string>*>(buffer));
+		break;
+	case NtupleColumnKind::VInt:
+		m_tree->Branch(name.c_str(), static_cast<std::vector<int>*>(buffer));
+		break;
+	case NtupleColumnKind::NKinds:
+	default:
+		LOG(FATAL) << "Invalid type of column \"" << name << "\"!";
+	}
+}
+
+void TreeNtupleOutputBackend::Init()
+{
+	RootFileHelper::SetCompressionSettings(m_tree, m_compressionSettings);
+}
+
+void TreeNtupleOutputBackend::Fill()
+{
+	m_tree->Fill();
+}
+
+void TreeNtupleOutputBackend::Write()
+{
+	m_tree->Write(m_tree->GetName());
+}
+
+bool TreeNtupleOutputBackend::IsMergeable() const
+{
+	return true;
+}
+
+long long TreeNtupleOutputBackend::GetEntries() const
+{
+	return m_tree->GetEntries();
+}
+
+void TreeNtupleOutputBackend::GetEntry(long long entry)
+{
+	m_tree->GetEntry(entry);
+}
+
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,32,0)
+RNTupleOutputBackend::RNTupleOutputBackend(TDirectory* directory, std::string const& name, int compressionSettings) :
+	m_directory(directory),
+	m_name(name),
+	m_compressionSettings(compressionSettings),
+	m_model(RNTupleApi::RNTupleModel::CreateBare())
+{
+}
+
+template<class T>
+void RNTupleOutputBackend::AddField(std::string const& name, T* buffer)
+{
+	m_model->AddField(std::unique_ptr<RNTupleApi::RFieldBase>(new RNTupleApi::RField<T>(name)));
+	m_bindings.push_back([name, buffer](RNTupleApi::REntry& entry) {
+		entry.BindRawPtr(name, buffer);
+	});
+}
+
+template<class T, class TConversion>
+void RNTupleOutputBackend::AddConvertedField(std::string const& name, TConversion const& conversion)
+{
+	std::shared_ptr<T> fieldBuffer = std::make_shared<T>();
+	AddField(name, fieldBuffer.get());
+	m_conversions.push_back([fieldBuffer, conversion]() {
+		conversion(*fieldBuffer);
+	});
+}
+
+namespace
+{
+	template<class T>
+	std::vector<std::pair<std::string, std::function<typename T::Scalar(T const&)>>> GetLorentzVectorComponents()
+	{
+		return {
+			{ "_pt", [](T const& vector) { return vector.Pt(); } },
+			{ "_eta", [](T const& vector) { return vector.Eta(); } },
+			{ "_phi", [](T const& vector) { return vector.Phi(); } },
+			{ "_mass", [](T const& vector) { return vector.M(); } }
+		};
+	}
+}
+
+template<class T>
+void RNTupleOutputBackend::AddLorentzVectorFields(std::string const& name, T const* buffer)
+{
+	typedef typename T::Scalar Scalar;
+	for (auto const& component : GetLorentzVectorComponents<T>())
+	{
+		std::function<Scalar(T const&)> getComponent = component.second;
+		AddConvertedField<Scalar>(name + component.first, [buffer, getComponent](Scalar& value) {
+			value = getComponent(*buffer);
+		});
+	}
+}
+
+template<class T>
+void RNTupleOutputBackend::AddLorentzVectorsFields(std::string const& name, std::vector<T> const* buffer)
+{
+	typedef typename T::Scalar Scalar;
+	for (auto const& component : GetLorentzVectorComponents<T>())
+	{
+		std::function<Scalar(T const&)> getComponent = component.second;
+		AddConvertedField<std::vector<Scalar>>(name + component.first, [buffer, getComponent](std::vector<Scalar>& values) {
+			values.resize(buffer->size());
+			for (size_t index = 0; index < buffer->size(); ++index)
+			{
+				values[index] = getComponent((*buffer)[index]);
+			}
+		});
+	}
+}
+
+void RNTupleOutputBackend::AddColumn(std::string const& name, NtupleColumnKind kind, void* buffer)
+{
+	switch (kind)
+	{
+	case NtupleColumnKind::Bool:
+		AddConvertedField<bool>(name, [buffer](bool& value) {
+			value = (*static_cast<char const*>(buffer) != 0);
+		});
+		break;
+	case NtupleColumnKind::Int:
+		AddField(name, static_cast<int*>(buffer));
+		break;
+	case NtupleColumnKind::UInt64:
+		AddField(name, static_cast<std::uint64_t*>(buffer));
+		break;
+	case NtupleColumnKind::Float:
+		AddField(name, static_cast<float*>(buffer));
+		break;
+	case NtupleColumnKind::Double:
+		AddField(name, static_cast<double*>(buffer));
+		break;
+	case NtupleColumnKind::PtEtaPhiMVector:
+		AddLorentzVectorFields(name, static_cast<ROOT::Math::PtEtaPhiMVector const*>(buffer));
+		break;
+	case NtupleColumnKind::RMFLV:
+		AddLorentzVectorFields(name, static_cast<RMFLV const*>(buffer));
+		break;
+	case NtupleColumnKind::String:
+		AddField(name, static_cast<std::string*>(buffer));
+		break;
+	case NtupleColumnKind::VDouble:
+		AddField(name, static_cast<std::vector<double>*>(buffer));
+		break;
+	case NtupleColumnKind::VFloat:
+		AddField(name, static_cast<std::vector<float>*>(buffer));
+		break;
+	case NtupleColumnKind::VRMFLV:
+		AddLorentzVectorsFields(name, static_cast<std::vector<RMFLV> const*>(buffer));
+		break;
+	case NtupleColumnKind::VString:
+		AddField(name, static_cast<std::vector<std::string>*>(buffer));
+		break;
+	case NtupleColumnKind::VInt:
+		AddField(name, static_cast<std::vector<int>*>(buffer));
+		break;
+	case NtupleColumnKind::NKinds:
+	default:
+		LOG(FATAL) << "Invalid type of column \"" << name << "\"!";
+	}
+}
+
+void RNTupleOutputBackend::Init()
+{
+	RNTupleApi::RNTupleWriteOptions options;
+	if (m_compressionSettings >= 0)
+	{
+		options.SetCompression(m_compressionSettings);
+	}
+	m_writer = RNTupleApi::RNTupleWriter::Append(std::move(m_model), m_name, *m_directory, options);
+	m_entry = m_writer->CreateEntry();
+	for (auto const& binding : m_bindings)
+	{
+		binding(*m_entry);
+	}
+}
+
+void RNTupleOutputBackend::Fill()
+{
+	for (auto const& conversion : m_conversions)
+	{
+		conversion();
+	}
+	m_writer->Fill(*m_entry);
+}
+
+void RNTupleOutputBackend::Write()
+{
+	// the data set is committed when the writer is destroyed
+	m_entry.reset();
+	m_writer.reset();
+}
+#endif
+
+
+std::unique_ptr<NtupleOutputBackend> CreateNtupleOutputBackend(std::string const& backendName, TDirectory* directory,
+                                                               std::string const& name, std::string const& title,
+                                                               int compressionSettings)
+{
+	if (backendName == "TTree")
+	{
+		return std::unique_ptr<NtupleOutputBackend>(new TreeNtupleOutputBackend(directory, name, title, compressionSettings));
+	}
+	else if (backendName == "RNTuple")
+	{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,32,0)
+		return std::unique_ptr<NtupleOutputBackend>(new RNTupleOutputBackend(directory, name, compressionSettings));
+#else
+		LOG(FATAL) << "The RNTuple ntuple output backend requires ROOT 6.32 or newer!";
+#endif
+	}
+	else
+	{
+		LOG(FATAL) << "Unknown ntuple output backend \"" << backendName << "\"! Use \"TTree\" or \"RNTuple\".";
+	}
+	return std::unique_ptr<NtupleOutputBackend>();
+}
+
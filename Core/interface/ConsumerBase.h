@@ -38,18 +38,27 @@ public:
 	 */
 	virtual std::string GetConsumerId() const = 0;
 
+	/*
+	 * Must return true, if the consumer implements the merging of the output
+	 * of a clone of itself, which is needed for multi-threaded event processing.
+	 */
+	virtual bool IsMergeable() const {
+		return false;
+	}
+
 protected:
 	// will be implemented by the ConsumerBase class
 	virtual void baseProcess( SettingsBase const& setting ) = 0;
 	virtual void baseProcessEvent(EventBase const& evt, ProductBase const& prod,
 	                              SettingsBase const& setting,
-	                              FilterResult & fres) = 0;
+	                              FilterResult const& fres) = 0;
 	virtual void baseProcessFilteredEvent(EventBase const& evt, ProductBase const& prod,
 	                                      SettingsBase const& setting) = 0;
 	virtual void baseInit ( SettingsBase const& settings ) = 0;
 	virtual void baseOnRun(EventBase const& evt, SettingsBase const& setting) = 0;
 	virtual void baseOnLumi(EventBase const& evt, SettingsBase const& setting) = 0;
 	virtual void baseFinish ( SettingsBase const& settings ) = 0;
+	virtual void baseMerge ( ConsumerBaseUntemplated & other, SettingsBase const& settings ) = 0;
 };
 
 class ConsumerBaseAccess {
@@ -60,7 +69,7 @@ public:
 		m_cb.baseProcess( settings );
 	}
 
-	void ProcessEvent( EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, FilterResult fres){
+	void ProcessEvent( EventBase const& evt, ProductBase const& prod, SettingsBase const& settings, FilterResult const& fres){
 		m_cb.baseProcessEvent( evt, prod, settings, fres);
 	}
 
@@ -84,6 +93,10 @@ public:
 		m_cb.baseFinish( settings );
 	}
 
+	void Merge ( ConsumerBaseUntemplated & other, SettingsBase const& settings ) {
+		m_cb.baseMerge( other, settings );
+	}
+
 private:
 	ConsumerBaseUntemplated & m_cb;
 };
@@ -143,6 +156,15 @@ public:
 	 */
 	virtual void Finish(setting_type const& setting) = 0;
 
+	/*
+	 * Called before Finish for every clone of this consumer, which has processed a different
+	 * range of events in another thread. Overwrite this together with IsMergeable to add the
+	 * output of the clone to the output of this consumer.
+	 */
+	virtual void Merge(ConsumerBase<TTypes> & other, setting_type const& setting) {
+		LOG(FATAL) << "Consumer \"" << this->GetConsumerId() << "\" does not support merging of outputs!";
+	}
+
 	/*
 	 * Return a reference to the settings used for this consumer
 	 */
@@ -164,14 +186,16 @@ protected:
 	}
 
 	void baseProcessEvent(EventBase const& evt, ProductBase const& prod,
-	                              SettingsBase const& setting, FilterResult & fres)	override
+	                              SettingsBase const& setting, FilterResult const& fres)	override
 	{
 
 		auto const& specEvent = static_cast < event_type const&> ( evt );
 		auto const& specProd = static_cast < product_type const&> ( prod );
 		auto const& specSetting = static_cast < setting_type const&> ( setting );
 
-		ProcessEvent( specEvent, specProd, specSetting, fres );
+		// every consumer gets its own copy, which it may modify
+		m_filterResult = fres;
+		ProcessEvent( specEvent, specProd, specSetting, m_filterResult );
 	}
 
 	void baseProcessFilteredEvent(EventBase const& evt,
@@ -215,4 +239,15 @@ protected:
 
 		this->Finish ( specSettings );
 	}
+
+	void baseMerge (ConsumerBaseUntemplated & other, SettingsBase const& settings) override {
+		auto & specOther = static_cast < ConsumerBase<TTypes> &> ( other );
+		auto const& specSettings = static_cast < setting_type const&> ( settings );
+
+		this->Merge ( specOther, specSettings );
+	}
+
+private:
+	// reused for every event, such that copying the filter result does not allocate memory
+	FilterResult m_filterResult;
 };
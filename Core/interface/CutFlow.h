@@ -2,6 +2,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
@@ -19,6 +20,9 @@ public:
 	// sum up all passed events per filter
 	void AddFilterResult(FilterResult const& fres);
 
+	// add the counts of another cut flow, e.g. from another thread
+	void Merge(CutFlow const& other);
+
 	CutStat * GetCutEntry(std::string const& filterName);
 
 	CutCount const& GetCutCount() const;
@@ -30,4 +34,7 @@ public:
 private:
 	CutCount m_cutCount;
 	long m_overallEventCount;
+
+	// entries of m_cutCount by filter index
+	std::vector<CutStat*> m_cutEntries;
 };
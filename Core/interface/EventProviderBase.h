@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <boost/noncopyable.hpp>
 
 template<class TTypes>
@@ -16,6 +19,17 @@ public:
 	virtual bool GetEntry(long long lEventNumber) = 0;
 
 	virtual long long GetEntries() const = 0;
+
+	// the events are processed in batches, which are loaded at once before their first event is requested
+	// returns the end (exclusive) of the batch starting at lEventNumber, by default one batch per event
+	virtual long long GetBatchEnd(long long lEventNumber) { return (lEventNumber + 1); }
+	// returns false, if the batch cannot be loaded, which terminates the event loop
+	virtual bool LoadBatch(long long lFirstEventNumber, long long lEndEventNumber) { return true; }
+
+	// called before the event loop with the names of all input collections read by the nodes
+	// (see ProcessNodeBase::GetInputCollections), the other collections need not be read
+	virtual void SetRequiredInputCollections(std::vector<std::string> const& collectionNames) {}
+
 	virtual bool NewLumisection() const { return false; }
 	virtual bool NewRun() const { return false; }
 
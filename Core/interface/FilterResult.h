@@ -1,11 +1,20 @@
-
 #pragma once
 
+#include <limits>
 #include <list>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "Artus/Utility/interface/ArtusLogging.h"
 
+/*
+The filter names are interned to integer indices, which are the same for all filter results
+of the process. The decisions are stored in bitsets, which grow with the number of registered
+names, such that copying a filter result and evaluating HasPassed does not touch any strings. Filters and pipelines should
+determine their indices once with GetFilterIndex and use the index based functions in the
+event loop. The functions taking filter names are kept for compatibility, but are slow.
+*/
 class FilterResult {
 public:
 
@@ -13,7 +22,11 @@ public:
 	enum class TaggingMode { Tagging, Filtering };
 
 	typedef std::vector <std::string> FilterNames;
-	//typedef std::map<std::string, Decision> FilterDecisions;
+	typedef size_t FilterIndex;
+	typedef std::vector<FilterIndex> FilterIndices;
+
+	static const FilterIndex UnknownFilter = std::numeric_limits<FilterIndex>::max();
+
 	struct DecisionEntry
 	{
 		std::string filterName;
@@ -25,10 +38,24 @@ public:
 
 	typedef std::list<DecisionEntry> FilterDecisions;
 
+	// index of a filter name, the name is registered if it is not known yet (thread-safe)
+	static FilterIndex GetFilterIndex(std::string const& filterName);
+	static FilterIndices GetFilterIndices(FilterNames const& filterNames);
+	// index of a filter name or UnknownFilter, if the name has never been registered
+	static FilterIndex FindFilterIndex(std::string const& filterName);
+	static std::string GetFilterName(FilterIndex filterIndex);
+
 	FilterResult();
 	explicit FilterResult(FilterNames const& initialFilterNames);
 	FilterResult(FilterNames const& initialFilterNames, FilterNames const& taggingFilters );
+	FilterResult(FilterIndices const& initialFilterIndices, FilterIndices const& taggingFilterIndices);
+
+	// the cache of the slow path functions is not copied
+	FilterResult(FilterResult const& other);
+	FilterResult& operator=(FilterResult const& other);
 
+	// slow path, the entry is invalidated by the next modification of this filter result,
+	// changes of the decision and the tagging mode of the entry are applied to this filter result
 	DecisionEntry * GetDecisionEntry( std::string const& filterName );
 	DecisionEntry const* GetDecisionEntry( std::string const& filterName ) const;
 
@@ -37,25 +64,57 @@ public:
 	// name is not in the list before
 	void AddFilterNames( FilterNames const& fn);
 	void AddFilterNames( FilterNames const& fn, FilterNames const& taggingFilters);
-	
+	void AddFilterIndices( FilterIndices const& filterIndices);
+	void AddFilterIndices( FilterIndices const& filterIndices, FilterIndices const& taggingFilterIndices);
+
 	// list of all filter names as a vector of strings
 	FilterNames GetFilterNames() const;
-	
+	// list of all filter indices in the order of their insertion
+	FilterIndices const& GetFilterIndices() const;
+
 	bool HasPassed() const;
 	bool HasPassedIfExcludingFilter(std::string const& excludedFilter) const;
+	bool HasPassedIfExcludingFilter(FilterIndex excludedFilter) const;
+	bool HasFilter(FilterIndex filterIndex) const;
 	TaggingMode IsTaggingFilter(std::string const& filterName) const;
+	TaggingMode IsTaggingFilter(FilterIndex filterIndex) const;
+	// tagging mode of an entry, which has been fixed when the entry has been added
+	TaggingMode GetTaggingMode(FilterIndex filterIndex) const;
 	Decision GetFilterDecision(std::string filterName) const;
+	Decision GetFilterDecision(FilterIndex filterIndex) const;
+	// slow path, the list is rebuilt after each modification of this filter result
 	FilterDecisions const& GetFilterDecisions() const;
 	void SetFilterDecision(std::string filterName, bool passed);
+	void SetFilterDecision(FilterIndex filterIndex, bool passed);
 	std::string ToString() const;
 	std::string DecisionToString ( Decision dc ) const;
 
 private:
 
-	// optimize this, without strings
-	FilterNames m_taggingFilters;
-	FilterDecisions m_filterDecisions;
+	typedef boost::dynamic_bitset<> FilterBits;
 
-	mutable bool m_cacheHasPassed;
-	mutable bool m_IsCachedHasPassed;
+	static bool TestBit(FilterBits const& bits, FilterIndex filterIndex);
+	static void SetBit(FilterBits & bits, FilterIndex filterIndex, bool value);
+
+	void AddFilterIndex(FilterIndex filterIndex);
+
+	// applies changes made through the entries returned by the non-const GetDecisionEntry
+	void ApplyDecisionEntries() const;
+
+	FilterIndices m_filterIndices;
+	FilterBits m_filters;
+	FilterBits m_taggingFilters;
+
+	// mutable, since they can be changed through the decision entries
+	mutable FilterBits m_decided;
+	mutable FilterBits m_passed;
+	mutable FilterBits m_taggingMode;
+
+	// entries in filtering mode, which did not pass
+	mutable FilterBits m_vetoes;
+
+	mutable FilterDecisions m_filterDecisions;
+	mutable bool m_filterDecisionsValid;
+	mutable bool m_filterDecisionsWritable;
 };
+
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <boost/noncopyable.hpp>
+
+/**
+   \brief Background thread writing the outputs of the consumers.
+
+   Consumers hand tasks (e.g. filling a batch of events into a tree, which compresses and
+   writes its baskets) to the writer instead of executing them in the event loop. The tasks are
+   executed one after another in the order of their submission, such that all writes into the
+   shared output file are serialised. The thread is started with the first task.
+
+   Code writing into the output file during the event loop while the writer may be running
+   has to hold the lock returned by LockOutput. The runner calls Flush before the outputs are
+   merged and finished.
+*/
+class OutputWriter: public boost::noncopyable
+{
+public:
+
+	typedef std::function<void()> Task;
+
+	/// one writer per process, since all consumers share the output file
+	static OutputWriter& GetInstance();
+
+	~OutputWriter();
+
+	void Submit(Task task);
+
+	/// wait until all submitted tasks have been executed
+	void Flush();
+
+	/// excludes the execution of tasks
+	std::unique_lock<std::mutex> LockOutput();
+
+private:
+
+	OutputWriter() {}
+
+	void WriterLoop();
+
+	std::thread m_thread;
+	std::mutex m_outputMutex;
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskCondition;
+	std::condition_variable m_doneCondition;
+
+	// guarded by m_mutex
+	std::deque<Task> m_tasks;
+	bool m_busy = false;
+	bool m_stop = false;
+};
+
@@ -1,9 +1,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 #include <sstream>
-#include <time.h>
 
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
@@ -12,6 +12,7 @@
 #include "FilterBase.h"
 #include "ConsumerBase.h"
 #include "ProducerBase.h"
+#include "SharedPrefix.h"
 
 template<class TTypes>
 class Pipeline;
@@ -122,9 +123,27 @@ public:
 			ConsumerBaseAccess(it).Init( pset );
 		}
 
-		// store the filter names for later use in RunEvent
-		m_filterNames = pset.GetFilters();
-		m_taggingFilters = pset.GetTaggingFilters();
+		// store the filter indices for later use in RunEvent
+		m_filterIndices = FilterResult::GetFilterIndices(pset.GetFilters());
+		m_taggingFilterIndices = FilterResult::GetFilterIndices(pset.GetTaggingFilters());
+
+		m_nodeFilterIndices.clear();
+		std::vector<std::string> nodeIds;
+		for(ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+			if ( it->GetProcessNodeType () == ProcessNodeType::Filter ) {
+				std::string filterId = static_cast< FilterForThisPipeline &> ( *it ).GetFilterId();
+				m_nodeFilterIndices.push_back(FilterResult::GetFilterIndex(filterId));
+				nodeIds.push_back(filterId);
+			}
+			else {
+				m_nodeFilterIndices.push_back(FilterResult::UnknownFilter);
+				nodeIds.push_back(static_cast< ProducerForThisPipeline &> ( *it ).GetProducerId());
+			}
+		}
+
+		// one run time slot per node
+		m_runTimeProfiler.SetNodes(nodeIds);
+		m_runTimeProfiler.SetSamplingInterval(pset.GetRunTimeSamplingInterval());
 	}
 
 	/// Useful debug output of the Pipeline Content.
@@ -150,6 +169,46 @@ public:
 		}
 	}
 
+	/// Return true, if all consumers can merge the output of clones of this pipeline.
+	virtual bool IsMergeable() const {
+		for (auto const& it : m_consumer) {
+			if (! it.IsMergeable())
+				return false;
+		}
+		return true;
+	}
+
+	/// Add the names of the input collections read by the nodes and consumers and return true,
+	/// if all of them declare their input collections.
+	virtual bool GetInputCollections(std::vector<std::string> & collectionNames) const {
+		for (auto const& it : m_nodes) {
+			if (! it.GetInputCollections(collectionNames))
+				return false;
+		}
+		for (auto const& it : m_consumer) {
+			if (! it.GetInputCollections(collectionNames))
+				return false;
+		}
+		return true;
+	}
+
+	/// Merge the output of the consumers of a clone of this pipeline, which has processed a
+	/// different range of events. Called before FinishPipeline.
+	virtual void MergePipeline(Pipeline<TTypes> & other) {
+		if (m_consumer.size() != other.m_consumer.size()) {
+			LOG(FATAL) << "Cannot merge pipeline \"" << GetSettings().GetName() << "\" with a pipeline containing a different number of consumers!";
+		}
+
+		for (size_t consumerIndex = 0; consumerIndex < m_consumer.size(); ++consumerIndex) {
+			if (m_consumer[consumerIndex].GetConsumerId() != other.m_consumer[consumerIndex].GetConsumerId()) {
+				LOG(FATAL) << "Cannot merge consumer \"" << m_consumer[consumerIndex].GetConsumerId()
+				           << "\" with consumer \"" << other.m_consumer[consumerIndex].GetConsumerId()
+				           << "\" (pipeline \"" << GetSettings().GetName() << "\")!";
+			}
+			ConsumerBaseAccess( m_consumer[consumerIndex] ).Merge( other.m_consumer[consumerIndex], GetSettings() );
+		}
+	}
+
 	/// Run the pipeline without specific event input. This is most useful for Pipelines which 
 	/// process output from Pipelines already run.
 	virtual void Run() {
@@ -166,71 +225,36 @@ public:
 
 		// make a local copy of the global product/filter result
 		// and allow this one to be modified by local producers/filters.
-		product_type localProduct ( globalProduct );
-		FilterResult localFilterResult ( globalFilterResult );
-		localFilterResult.AddFilterNames( m_filterNames, m_taggingFilters );
-
-		// run Filters & Producers
-		for (ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
-
-			// variables for runtime measurement
-			timeval tStart, tEnd;
-			int runTime;
+		// the local objects are kept from the previous event and are assigned to,
+		// such that the memory already allocated by their containers is reused
+		// the products of shared leading producers are taken from the shared prefix
+		if (m_sharedPrefix != nullptr) {
+			m_localProduct = m_sharedPrefix->GetProduct();
+			m_localProduct.PreviousPipelinesResult = globalProduct.PreviousPipelinesResult;
+		}
+		else {
+			m_localProduct = globalProduct;
+		}
+		m_localFilterResult = globalFilterResult;
+		product_type & localProduct = m_localProduct;
+		FilterResult & localFilterResult = m_localFilterResult;
+		localFilterResult.AddFilterIndices( m_filterIndices, m_taggingFilterIndices );
 
-			// stop processing as soon as one filter fails
-			// but the consumers will still be processed
-			// this will also stop processing, if a global filter
-			// already failed
-			if (! localFilterResult.HasPassed())
-				break;
+		m_runTimeProfiler.StartEvent();
+		localProduct.localRunTimeProfiler = &m_runTimeProfiler;
 
-			if ( it->GetProcessNodeType () == ProcessNodeType::Producer ){
-				ProducerForThisPipeline& prod = static_cast<ProducerForThisPipeline&>(*it);
-				//LOG(DEBUG) << prod.GetProducerId() << "::Produce (pipeline: " << m_pipelineSettings.GetName() << ")";
-				gettimeofday(&tStart, nullptr);
-				if(globalProduct.newRun)
-						ProducerBaseAccess(prod).OnRun(evt, m_pipelineSettings);
-				if(globalProduct.newLumisection)
-						ProducerBaseAccess(prod).OnLumi(evt, m_pipelineSettings);
-				ProducerBaseAccess(prod).Produce(evt, localProduct, m_pipelineSettings);
-				gettimeofday(&tEnd, nullptr);
-				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);  // a long int might be needed here but SafeMaps for long ints are not yet working
-				localProduct.processorRunTime[prod.GetProducerId()] = runTime;
-			}
-			else if ( it->GetProcessNodeType () == ProcessNodeType::Filter ) {
-				FilterForThisPipeline & flt = static_cast<FilterForThisPipeline&>(*it);
-				//LOG(DEBUG) << flt.GetFilterId() << "::DoesEventPass (pipeline: " << m_pipelineSettings.GetName() << ")";
-				gettimeofday(&tStart, nullptr);
-				if(globalProduct.newRun)
-					FilterBaseAccess(flt).OnRun(evt, m_pipelineSettings);
-				if(globalProduct.newLumisection)
-					FilterBaseAccess(flt).OnLumi(evt, m_pipelineSettings);
-				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings);
-				localFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
-				gettimeofday(&tEnd, nullptr);
-				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);  // a long int might be needed here but SafeMaps for long ints are not yet working
-				localProduct.processorRunTime[flt.GetFilterId()] = runTime;
-			}
-			else {
-				LOG(FATAL) << "ProcessNodeType not supported by the pipeline!";
-			}
-		}
+		RunNodes(evt, globalProduct, localProduct, localFilterResult);
 		localProduct.fres = localFilterResult;
 
-		// run Consumers
-		for (ConsumerVectorIterator itcons = m_consumer.begin(); itcons != m_consumer.end(); ++itcons) {
-			//LOG(DEBUG) << itcons->GetConsumerId() << "::ProcessFilteredEvent/ProcessEvent (pipeline: " << m_pipelineSettings.GetName() << ")";
-			if(globalProduct.newRun)
-				ConsumerBaseAccess(*itcons).OnRun(evt, GetSettings());
-			if(globalProduct.newLumisection)
-				ConsumerBaseAccess(*itcons).OnLumi(evt, GetSettings());
-			if (localFilterResult.HasPassed()) {
-				ConsumerBaseAccess(*itcons).ProcessFilteredEvent(evt, localProduct, GetSettings());
-			}
-
-			ConsumerBaseAccess(*itcons).ProcessEvent(evt, localProduct, GetSettings(), localFilterResult);
+		// consumers of different pipelines share the output file and are
+		// therefore serialised, if the pipelines are run in parallel
+		std::unique_lock<std::mutex> consumerLock;
+		if (m_consumerMutex != nullptr) {
+			consumerLock = std::unique_lock<std::mutex>(*m_consumerMutex);
 		}
 
+		RunConsumers(evt, globalProduct, localProduct, localFilterResult);
+
 		return localFilterResult.HasPassed();
 	}
 
@@ -274,6 +298,22 @@ public:
 		return m_nodes;
 	}
 
+	/// Set a mutex to be locked while the consumers of this pipeline are running. This is needed,
+	/// if several pipelines are run in parallel. Pass nullptr to run without locking.
+	void SetConsumerMutex(std::mutex * consumerMutex) {
+		m_consumerMutex = consumerMutex;
+	}
+
+	/// Let this pipeline start from the product of a shared prefix, which runs the leading
+	/// producers of this pipeline. Pass nullptr to run all nodes in this pipeline.
+	void SetSharedPrefix(SharedPrefix<TTypes> const* sharedPrefix) {
+		if ((sharedPrefix != nullptr) && (sharedPrefix->GetNumberOfNodes() > m_nodes.size())) {
+			LOG(FATAL) << "Shared prefix of pipeline \"" << GetSettings().GetName() << "\" contains more nodes than the pipeline!";
+		}
+		m_sharedPrefix = sharedPrefix;
+		m_runTimeProfiler.SetSharedProfiler((sharedPrefix != nullptr) ? &(sharedPrefix->GetRunTimeProfiler()) : nullptr);
+	}
+
 	/// Return a list of filters is this pipeline.
 	/*
 	 * disabled for now, if you need this again, contact Thomas
@@ -281,11 +321,94 @@ public:
 		return m_filter;
 	}*/
 
+protected:
+
+	/// Run the producers and filters of this pipeline on the local product.
+	virtual void RunNodes(event_type const& evt,
+			product_type const& globalProduct,
+			product_type & localProduct,
+			FilterResult & localFilterResult) {
+
+		// run Filters & Producers, except the ones already run by a shared prefix
+		size_t nodeIndex = ((m_sharedPrefix != nullptr) ? m_sharedPrefix->GetNumberOfNodes() : 0);
+		for (ProcessNodeIterator it = m_nodes.begin() + nodeIndex; it != m_nodes.end(); ++it, ++nodeIndex) {
+
+			// stop processing as soon as one filter fails
+			// but the consumers will still be processed
+			// this will also stop processing, if a global filter
+			// already failed
+			if (! localFilterResult.HasPassed())
+				break;
+
+			const RunTimeProfiler::clock_type::time_point tStart = m_runTimeProfiler.Start();
+
+			if ( it->GetProcessNodeType () == ProcessNodeType::Producer ){
+				ProducerForThisPipeline& prod = static_cast<ProducerForThisPipeline&>(*it);
+				//LOG(DEBUG) << prod.GetProducerId() << "::Produce (pipeline: " << m_pipelineSettings.GetName() << ")";
+				if(globalProduct.newRun)
+						ProducerBaseAccess(prod).OnRun(evt, m_pipelineSettings);
+				if(globalProduct.newLumisection)
+						ProducerBaseAccess(prod).OnLumi(evt, m_pipelineSettings);
+				ProducerBaseAccess(prod).Produce(evt, localProduct, m_pipelineSettings);
+				m_runTimeProfiler.Stop(nodeIndex, tStart);
+			}
+			else if ( it->GetProcessNodeType () == ProcessNodeType::Filter ) {
+				FilterForThisPipeline & flt = static_cast<FilterForThisPipeline&>(*it);
+				//LOG(DEBUG) << flt.GetFilterId() << "::DoesEventPass (pipeline: " << m_pipelineSettings.GetName() << ")";
+				if(globalProduct.newRun)
+					FilterBaseAccess(flt).OnRun(evt, m_pipelineSettings);
+				if(globalProduct.newLumisection)
+					FilterBaseAccess(flt).OnLumi(evt, m_pipelineSettings);
+				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings);
+				localFilterResult.SetFilterDecision(m_nodeFilterIndices[nodeIndex], filterResult);
+				m_runTimeProfiler.Stop(nodeIndex, tStart);
+			}
+			else {
+				LOG(FATAL) << "ProcessNodeType not supported by the pipeline!";
+			}
+		}
+	}
+
+	/// Run the consumers of this pipeline on the local product.
+	virtual void RunConsumers(event_type const& evt,
+			product_type const& globalProduct,
+			product_type const& localProduct,
+			FilterResult const& localFilterResult) {
+
+		// run Consumers
+		for (ConsumerVectorIterator itcons = m_consumer.begin(); itcons != m_consumer.end(); ++itcons) {
+			//LOG(DEBUG) << itcons->GetConsumerId() << "::ProcessFilteredEvent/ProcessEvent (pipeline: " << m_pipelineSettings.GetName() << ")";
+			if(globalProduct.newRun)
+				ConsumerBaseAccess(*itcons).OnRun(evt, GetSettings());
+			if(globalProduct.newLumisection)
+				ConsumerBaseAccess(*itcons).OnLumi(evt, GetSettings());
+			if (localFilterResult.HasPassed()) {
+				ConsumerBaseAccess(*itcons).ProcessFilteredEvent(evt, localProduct, GetSettings());
+			}
+
+			ConsumerBaseAccess(*itcons).ProcessEvent(evt, localProduct, GetSettings(), localFilterResult);
+		}
+	}
+
+	RunTimeProfiler & GetRunTimeProfiler() {
+		return m_runTimeProfiler;
+	}
+
 private:
 	ConsumerVector m_consumer;
 	ProcessNodeVector m_nodes;
 	setting_type m_pipelineSettings;
-	std::vector<std::string> m_filterNames;
-	std::vector<std::string> m_taggingFilters;
+	FilterResult::FilterIndices m_filterIndices;
+	FilterResult::FilterIndices m_taggingFilterIndices;
+	// filter index of each node, UnknownFilter for producers
+	FilterResult::FilterIndices m_nodeFilterIndices;
+	std::mutex * m_consumerMutex = nullptr;
+	SharedPrefix<TTypes> const* m_sharedPrefix = nullptr;
+
+	RunTimeProfiler m_runTimeProfiler;
+
+	// buffers for the local products and filter decisions of the current event
+	product_type m_localProduct;
+	FilterResult m_localFilterResult;
 };
 
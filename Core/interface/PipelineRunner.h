@@ -1,21 +1,30 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 #include <algorithm>
 #include <unistd.h>
 #include <map>
-#include <sys/time.h>
 
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_list.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <RVersion.h>
+#include <TROOT.h>
 
 #include "Pipeline.h"
 #include "EventProviderBase.h"
 #include "ProgressReport.h"
 #include "FilterResult.h"
 #include "OsSignalHandler.h"
+#include "TaskPool.h"
+#include "RunTimeProfiler.h"
+#include "QuantityCache.h"
+#include "OutputWriter.h"
 
 /**
  \brief Class to manage all registered Pipelines and to connect them to the event.
@@ -25,6 +34,11 @@
  as an argument. Furthermore, Producers can be registered, which can generate Pipeline-
  independet products of the event. These Producers are run before any pipeline is started
  and the generated data is passed on to the pipelines.
+
+ Events can be processed in several threads by adding worker runners (see AddWorker) with
+ identically configured pipelines. Each thread processes a contiguous range of events and the
+ outputs of the consumers are merged before the pipelines are finished. Independently, the
+ level one pipelines of each event can be run in parallel (setting NumberOfPipelineThreads).
  */
 template<typename TPipeline, typename TTypes>
 class PipelineRunner: public boost::noncopyable
@@ -69,6 +83,9 @@ public:
 	typedef boost::ptr_list<ProcessNodeBase> ProcessNodes;
 	typedef typename ProcessNodes::iterator ProcessNodesIterator;
 
+	typedef SharedPrefix<TTypes> shared_prefix_type;
+	typedef boost::ptr_vector<shared_prefix_type> SharedPrefixes;
+
 	typedef boost::ptr_list<ProgressReportBase> ProgressReportList;
 	typedef typename ProgressReportList::iterator ProgressReportIterator;
 
@@ -94,6 +111,14 @@ public:
 		m_globalNodes.push_back(prod);
 	}
 
+	/// Add a prefix of producers shared by several level one pipelines. The prefixes are run in
+	/// the order they are added, therefore parents must be added before their children. The
+	/// object is destroyed in the destructor of the PipelineRunner.
+	void AddSharedPrefix(shared_prefix_type* sharedPrefix)
+	{
+		m_sharedPrefixes.push_back(sharedPrefix);
+	}
+
 	/// Add a range of pipelines. The object is destroyed in the destructor of the PipelineRunner.
 	void AddPipelines(std::vector<TPipeline*> pVec)
 	{
@@ -104,12 +129,27 @@ public:
 		}
 	}
 
+	/// Add a worker for multi-threaded event processing (see RunPipelinesMultiThreaded).
+	/// The worker must hold an identical set of global nodes and pipelines, e.g. by loading
+	/// the same configuration into it with ArtusConfig::LoadConfiguration using a separate
+	/// output file, and should be constructed without a signal handler. ArtusConfig::LoadWorkers
+	/// does this according to the setting NumberOfThreads. The object is destroyed in the
+	/// destructor of the PipelineRunner.
+	void AddWorker(PipelineRunner<TPipeline, TTypes>* worker)
+	{
+		// progress is only reported by this runner
+		worker->ClearProgressReports();
+		m_workers.push_back(worker);
+	}
+
 	/// Run the Producers and all pipelines. Give any pipeline setting here: only the
 	/// producer will read from the settings ...
 	template<class TEventProvider>
 	void RunPipelines(TEventProvider & evtProvider,
 			setting_type const& settings)
 	{
+		CheckPipelineNames();
+
 		long long firstEvent = settings.GetFirstEvent();
 		long long nEvents = evtProvider.GetEntries();
 		long long processNEvents = settings.GetProcessNEvents();
@@ -117,32 +157,294 @@ public:
 		{
 			nEvents = processNEvents;
 		}
-		const std::vector<std::string> globlalFilterIds = settings.GetFilters();
-		const std::vector<std::string> taggingFilters = settings.GetTaggingFilters();
 
-		// initialize pline filter decision
+		PruneInputCollections(evtProvider, settings);
+		EnableParallelCompression(settings);
+		RunEventLoop(evtProvider, settings, firstEvent, nEvents);
+		FinishPipelines();
+	}
+
+	/// Run the Producers and all pipelines in several threads. One event provider per thread
+	/// has to be passed, the first one is used by this runner, the following ones by the
+	/// workers in the order they have been added. The events are split into contiguous ranges,
+	/// one per thread. After all threads have finished, the outputs of the consumers of the
+	/// workers are merged into the consumers of this runner in the order of the event ranges,
+	/// such that the output is identical to the one of a single-threaded run.
+	template<class TEventProvider>
+	void RunPipelinesMultiThreaded(std::vector<TEventProvider*> const& evtProviders,
+			setting_type const& settings)
+	{
+		if (evtProviders.size() != (m_workers.size() + 1))
+		{
+			LOG(FATAL) << "One event provider per thread is needed, but " << evtProviders.size()
+			           << " event providers are given for " << (m_workers.size() + 1) << " threads!";
+		}
+		if (m_workers.empty())
+		{
+			RunPipelines(*(evtProviders.front()), settings);
+			return;
+		}
+
+		CheckPipelineNames();
+		CheckWorkerPipelines();
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if ((it->GetSettings().GetLevel() == 1) && (! it->IsMergeable()))
+			{
+				LOG(FATAL) << "Pipeline \"" << it->GetSettings().GetName() << "\" contains consumers, "
+				           << "that do not support merging of outputs. Run with a single thread instead!";
+			}
+		}
+
+		// the events are split among the threads, therefore the range must not exceed the input
+		long long firstEvent = settings.GetFirstEvent();
+		long long nEvents = std::max(0LL, evtProviders.front()->GetEntries() - firstEvent);
+		long long processNEvents = settings.GetProcessNEvents();
+		if (processNEvents > 0)
+		{
+			nEvents = std::min(nEvents, processNEvents);
+		}
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+		ROOT::EnableThreadSafety();
+#endif
+
+		for (typename std::vector<TEventProvider*>::const_iterator evtProvider = evtProviders.begin();
+		     evtProvider != evtProviders.end(); ++evtProvider)
+		{
+			PruneInputCollections(**evtProvider, settings);
+		}
+		EnableParallelCompression(settings);
+
+		const long long nThreads = static_cast<long long>(m_workers.size()) + 1;
+		const long long nEventsPerThread = (nEvents + nThreads - 1) / nThreads;
+
+		// the settings cache their values on first access and are therefore not thread-safe
+		std::vector<setting_type> workerSettings(m_workers.size(), settings);
+		std::vector<std::thread> workerThreads;
+		for (size_t workerIndex = 0; workerIndex < m_workers.size(); ++workerIndex)
+		{
+			long long workerFirstEvent = firstEvent + (static_cast<long long>(workerIndex) + 1) * nEventsPerThread;
+			long long workerNEvents = std::max(0LL, std::min(nEventsPerThread, firstEvent + nEvents - workerFirstEvent));
+			TEventProvider* workerEvtProvider = evtProviders[workerIndex + 1];
+			workerThreads.push_back(std::thread([this, workerIndex, workerEvtProvider, &workerSettings,
+			                                     workerFirstEvent, workerNEvents]() {
+				m_workers[workerIndex].RunEventLoop(*workerEvtProvider, workerSettings[workerIndex],
+				                                     workerFirstEvent, workerNEvents);
+			}));
+		}
+
+		RunEventLoop(*(evtProviders.front()), settings, firstEvent, std::min(nEventsPerThread, nEvents));
+
+		for (std::vector<std::thread>::iterator workerThread = workerThreads.begin();
+		     workerThread != workerThreads.end(); ++workerThread)
+		{
+			workerThread->join();
+		}
+		OutputWriter::GetInstance().Flush();
+
+		// merge in the order of the event ranges
+		for (typename Workers::iterator worker = m_workers.begin(); worker != m_workers.end(); ++worker)
+		{
+			PipelinesIterator workerPipeline = worker->m_pipelines.begin();
+			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it, ++workerPipeline)
+			{
+				if (it->GetSettings().GetLevel() == 1)
+				{
+					it->MergePipeline(*workerPipeline);
+				}
+			}
+		}
+
+		FinishPipelines();
+	}
+
+	void AddProgressReport(ProgressReportBase * p)
+	{
+		m_progressReport.push_back(p);
+	}
+
+	void ClearProgressReports()
+	{
+		m_progressReport.clear();
+	}
+
+	Pipelines & GetPipelines()
+	{
+		return m_pipelines;
+	}
+
+	ProcessNodes & GetNodes()
+	{
+		return m_globalNodes;
+	}
+
+private:
+
+	typedef boost::ptr_vector<PipelineRunner<TPipeline, TTypes> > Workers;
+
+	// pass the input collections read by the global nodes and the level one pipelines to the event provider,
+	// if all of them are known
+	template<class TEventProvider>
+	void PruneInputCollections(TEventProvider & evtProvider, setting_type const& settings) const
+	{
+		if (! settings.GetPruneInputCollections())
+		{
+			return;
+		}
+
+		std::vector<std::string> collectionNames;
+		for (typename ProcessNodes::const_iterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
+		{
+			if (! it->GetInputCollections(collectionNames))
+			{
+				LOG(DEBUG) << "Reading all input collections, since not all global nodes declare their input collections.";
+				return;
+			}
+		}
+		for (typename Pipelines::const_iterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if ((it->GetSettings().GetLevel() == 1) && (! it->GetInputCollections(collectionNames)))
+			{
+				LOG(DEBUG) << "Reading all input collections, since not all nodes of pipeline \""
+				           << it->GetSettings().GetName() << "\" declare their input collections.";
+				return;
+			}
+		}
+
+		std::sort(collectionNames.begin(), collectionNames.end());
+		collectionNames.erase(std::unique(collectionNames.begin(), collectionNames.end()), collectionNames.end());
+		evtProvider.SetRequiredInputCollections(collectionNames);
+	}
+
+	// the outputs of the workers are merged pipeline by pipeline, which is checked before any thread is started
+	void CheckWorkerPipelines() const
+	{
+		FilterResult::FilterNames pipelineNames = GetPipelineNames();
+		for (typename Workers::const_iterator worker = m_workers.begin(); worker != m_workers.end(); ++worker)
+		{
+			if (worker->GetPipelineNames() != pipelineNames)
+			{
+				LOG(FATAL) << "Worker is configured with different pipelines (" << worker->m_pipelines.size()
+				           << " instead of " << m_pipelines.size() << ")! Pipelines, which are not created from the "
+				           << "configuration (e.g. a StaticPipeline), are only supported with NumberOfThreads = 1.";
+			}
+		}
+	}
+
+	// pipeline names are used as filter names and must therefore be unique
+	void CheckPipelineNames() const
+	{
+		FilterResult::FilterNames pipelineResultNamesSorted = GetPipelineNames();
+
+		// must be sorted to perform the unique option
+		std::sort(pipelineResultNamesSorted.begin(),
+				pipelineResultNamesSorted.end());
+
+		auto itUnq = std::unique(pipelineResultNamesSorted.begin(),
+				pipelineResultNamesSorted.end());
+		if (itUnq != pipelineResultNamesSorted.end())
+		{
+			LOG(FATAL)<< "Pipeline name '" << *itUnq << "' is not unique, but pipeline names must be unique";
+		}
+	}
+
+	FilterResult::FilterNames GetPipelineNames() const
+	{
 		FilterResult::FilterNames pipelineResultNames(m_pipelines.size());
 		std::transform(m_pipelines.begin(), m_pipelines.end(),
 				pipelineResultNames.begin(),
 				[] ( pipeline_type const& p ) -> std::string
 				{	return p.GetSettings().GetName();});
+		return pipelineResultNames;
+	}
+
+	// run the global nodes and the level one pipelines for the events [firstEvent, firstEvent + nEvents)
+	template<class TEventProvider>
+	void RunEventLoop(TEventProvider & evtProvider,
+			setting_type const& settings,
+			long long firstEvent, long long nEvents)
+	{
+		const FilterResult::FilterIndices taggingFilterIndices = FilterResult::GetFilterIndices(settings.GetTaggingFilters());
+
+		// use the list of filters to bootstrap the filter list names
+		const FilterResult globalFilterResultTemplate(FilterResult::GetFilterIndices(settings.GetFilters()), taggingFilterIndices);
+
+		// initialize pline filter decision
+		const FilterResult pipelineFilterResTemplate(FilterResult::GetFilterIndices(GetPipelineNames()), taggingFilterIndices);
 
+		// filter indices of the global nodes and the level one pipelines
+		FilterResult::FilterIndices globalNodeFilterIndices;
+		std::vector<std::string> globalNodeIds;
+		for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
 		{
-			auto pipelineResultNamesSorted = pipelineResultNames;
-			// must be sorted to perform the unique option
-			// but don't use the sorted strings later on
-			std::sort(pipelineResultNamesSorted.begin(),
-					pipelineResultNamesSorted.end());
-
-			auto itUnq = std::unique(pipelineResultNamesSorted.begin(),
-					pipelineResultNamesSorted.end());
-			if (itUnq != pipelineResultNamesSorted.end())
+			if ( it->GetProcessNodeType () == ProcessNodeType::Filter )
+			{
+				std::string filterId = static_cast<filter_base_type&>(*it).GetFilterId();
+				globalNodeFilterIndices.push_back(FilterResult::GetFilterIndex(filterId));
+				globalNodeIds.push_back(filterId);
+			}
+			else
 			{
-				LOG(FATAL)<< "Pipeline name '" << *itUnq << "' is not unique, but pipeline names must be unique";
+				globalNodeFilterIndices.push_back(FilterResult::UnknownFilter);
+				globalNodeIds.push_back(static_cast<producer_base_type&>(*it).GetProducerId());
 			}
 		}
+		m_runTimeProfiler.SetNodes(globalNodeIds);
+		m_runTimeProfiler.SetSamplingInterval(settings.GetRunTimeSamplingInterval());
+		m_quantityCache.Init();
+		FilterResult::FilterIndices pipelineFilterIndices;
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if (it->GetSettings().GetLevel() == 1)
+			{
+				pipelineFilterIndices.push_back(FilterResult::GetFilterIndex(it->GetSettings().GetName()));
+			}
+		}
+
+		// kept outside of the event loop, such that their memory is reused
+		FilterResult globalFilterResult;
+		FilterResult pipelineFilterRes;
+
+		// the level one pipelines of one event can be run in parallel
+		// each pipeline is run as one task, such that its nodes and consumers are only
+		// used by one thread at a time, and the consumers of all pipelines are serialised
+		// since they share the output file
+		std::unique_ptr<TaskPool> pipelineTaskPool;
+		std::vector<TaskPool::Task> pipelineTasks;
+		std::vector<char> pipelineResults;
+		event_type const* currentEvent = nullptr;
+		product_type const* currentProductGlobal = nullptr;
+		FilterResult const* currentGlobalFilterResult = nullptr;
+
+		const size_t nPipelineThreads = settings.GetNumberOfPipelineThreads();
+		if (nPipelineThreads > 1)
+		{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+			ROOT::EnableThreadSafety();
+#endif
+			pipelineTaskPool.reset(new TaskPool(nPipelineThreads));
+			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+			{
+				if (it->GetSettings().GetLevel() == 1)
+				{
+					TPipeline* pipeline = &(*it);
+					size_t pipelineIndex = pipelineTasks.size();
+					pipeline->SetConsumerMutex(&m_consumerMutex);
+					pipelineTasks.push_back([pipeline, pipelineIndex, &pipelineResults, &currentEvent,
+					                         &currentProductGlobal, &currentGlobalFilterResult]() {
+						pipelineResults[pipelineIndex] = pipeline->RunEvent(*currentEvent, *currentProductGlobal,
+						                                                     *currentGlobalFilterResult);
+					});
+				}
+			}
+			pipelineResults.resize(pipelineTasks.size());
+			LOG(INFO) << "Running " << pipelineTasks.size() << " pipelines in " << nPipelineThreads << " threads.";
+		}
+
 		// apparently evtProvider.GetEntries() is not reliable. Therefore, if 'ProcessNEvents' is not set (=-1), the loop condition
 		// always evaluates to true (processNEvents<0) = (-1<0) and is terminated via the 'if (!evtProvider.GetEntry(i)) break' statement
+		long long batchEnd = firstEvent;
 		for (long long iEvent = firstEvent; (iEvent < (firstEvent + nEvents)); ++iEvent)
 		{
 			// quit here according to OS
@@ -152,6 +454,14 @@ public:
 				break;
 			}
 
+			// load the next batch of events, the batches are cut at the end of the event range
+			if (iEvent >= batchEnd)
+			{
+				batchEnd = std::min(std::max(evtProvider.GetBatchEnd(iEvent), iEvent + 1), firstEvent + nEvents);
+				if (!evtProvider.LoadBatch(iEvent, batchEnd))
+				break;
+			}
+
 			if (!evtProvider.GetEntry(iEvent))
 			break;
 			for (ProgressReportIterator it = m_progressReport.begin();
@@ -161,25 +471,28 @@ public:
 			}
 
 			product_type productGlobal;
-			// use the lit of filters to bootstrap the filter list names
-			FilterResult globalFilterResult ( globlalFilterIds, taggingFilters );
+			globalFilterResult = globalFilterResultTemplate;
 
-			for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
-			{
-				// variables for runtime measurement
-				timeval tStart, tEnd;
-				int runTime;
+			m_runTimeProfiler.StartEvent();
+			productGlobal.globalRunTimeProfiler = &m_runTimeProfiler;
+
+			m_quantityCache.StartEvent();
+			productGlobal.quantityCache = &m_quantityCache;
 
+			size_t nodeIndex = 0;
+			for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it, ++nodeIndex)
+			{
 				// stop processing as soon as one filter fails
 				// but the consumers will still be processed
 				if (! globalFilterResult.HasPassed())
 				break;
 
+				const RunTimeProfiler::clock_type::time_point tStart = m_runTimeProfiler.Start();
+
 				if ( it->GetProcessNodeType () == ProcessNodeType::Producer )
 				{
 					producer_base_type& prod = static_cast<producer_base_type&>(*it);
 					//LOG(DEBUG) << prod.GetProducerId() << "::Produce";
-					gettimeofday(&tStart, nullptr);
 					auto currentEvent = evtProvider.GetCurrentEvent();
 					productGlobal.newRun = evtProvider.NewRun();
 					productGlobal.newLumisection = evtProvider.NewLumisection();
@@ -189,15 +502,12 @@ public:
 						ProducerBaseAccess(prod).OnLumi(currentEvent, settings);
 					ProducerBaseAccess(prod).Produce(currentEvent,
 							productGlobal, settings);
-					gettimeofday(&tEnd, nullptr);
-					runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
-					productGlobal.processorRunTime[prod.GetProducerId()] = runTime;
+					m_runTimeProfiler.Stop(nodeIndex, tStart);
 				}
 				else if ( it->GetProcessNodeType () == ProcessNodeType::Filter )
 				{
 					filter_base_type& flt = static_cast<filter_base_type&>(*it);
 					//LOG(DEBUG) << flt.GetFilterId() << "::DoesEventPass";
-					gettimeofday(&tStart, nullptr);
 					auto currentEvent = evtProvider.GetCurrentEvent();
 					if(evtProvider.NewRun())
 						FilterBaseAccess(flt).OnRun(currentEvent, settings);
@@ -205,10 +515,8 @@ public:
 						FilterBaseAccess(flt).OnLumi(currentEvent, settings);
 					const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evtProvider.GetCurrentEvent(),
 							productGlobal, settings);
-					globalFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
-					gettimeofday(&tEnd, nullptr);
-					runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
-					productGlobal.processorRunTime[flt.GetFilterId()] = runTime;
+					globalFilterResult.SetFilterDecision(globalNodeFilterIndices[nodeIndex], filterResult);
+					m_runTimeProfiler.Stop(nodeIndex, tStart);
 				}
 				else
 				{
@@ -216,22 +524,78 @@ public:
 				}
 			}
 
+			// run the producers shared by several pipelines
+			for (typename SharedPrefixes::iterator it = m_sharedPrefixes.begin(); it != m_sharedPrefixes.end(); ++it)
+			{
+				it->RunEvent(evtProvider.GetCurrentEvent(), productGlobal, globalFilterResult);
+			}
+
 			// run the pipelines
-			FilterResult pipelineFilterRes(pipelineResultNames, taggingFilters);
+			pipelineFilterRes = pipelineFilterResTemplate;
 
-			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+			if (pipelineTaskPool)
 			{
-				if (it->GetSettings().GetLevel() == 1)
+				// the results of the other pipelines of this event are not known yet
+				productGlobal.PreviousPipelinesResult = pipelineFilterRes;
+				currentEvent = &(evtProvider.GetCurrentEvent());
+				currentProductGlobal = &productGlobal;
+				currentGlobalFilterResult = &globalFilterResult;
+
+				pipelineTaskPool->Run(pipelineTasks);
+
+				for (size_t pipelineIndex = 0; pipelineIndex < pipelineFilterIndices.size(); ++pipelineIndex)
 				{
-					productGlobal.PreviousPipelinesResult = pipelineFilterRes;
-					bool result = it->RunEvent(evtProvider.GetCurrentEvent(),
-							productGlobal, globalFilterResult);
 					pipelineFilterRes.SetFilterDecision(
-							it->GetSettings().GetName(), result);
+							pipelineFilterIndices[pipelineIndex], (pipelineResults[pipelineIndex] != 0));
+				}
+			}
+			else
+			{
+				size_t pipelineIndex = 0;
+				for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+				{
+					if (it->GetSettings().GetLevel() == 1)
+					{
+						productGlobal.PreviousPipelinesResult = pipelineFilterRes;
+						bool result = it->RunEvent(evtProvider.GetCurrentEvent(),
+								productGlobal, globalFilterResult);
+						pipelineFilterRes.SetFilterDecision(
+								pipelineFilterIndices[pipelineIndex], result);
+						++pipelineIndex;
+					}
 				}
 			}
 		}
 
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			it->SetConsumerMutex(nullptr);
+		}
+	}
+
+	/// the baskets of the output trees are compressed in parallel when they are filled
+	void EnableParallelCompression(setting_type const& settings)
+	{
+		const size_t nCompressionThreads = settings.GetNumberOfCompressionThreads();
+		if (nCompressionThreads > 0)
+		{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+			if (! ROOT::IsImplicitMTEnabled())
+			{
+				ROOT::EnableImplicitMT(static_cast<unsigned int>(nCompressionThreads));
+			}
+#else
+			LOG(WARNING) << "Parallel compression of the output requires ROOT 6.10 or newer.";
+#endif
+		}
+	}
+
+	// finish the level one pipelines and run the pipelines of higher levels
+	void FinishPipelines()
+	{
+		// the consumers write their outputs, when all pending writes are done
+		OutputWriter::GetInstance().Flush();
+
 		for (ProgressReportIterator it = m_progressReport.begin();
 				it != m_progressReport.end(); ++it)
 		{
@@ -276,31 +640,14 @@ public:
 		}
 	}
 
-	void AddProgressReport(ProgressReportBase * p)
-	{
-		m_progressReport.push_back(p);
-	}
-
-	void ClearProgressReports()
-	{
-		m_progressReport.clear();
-	}
-
-	Pipelines & GetPipelines()
-	{
-		return m_pipelines;
-	}
-
-	ProcessNodes & GetNodes()
-	{
-		return m_globalNodes;
-	}
-
-private:
-
 	Pipelines m_pipelines;
+	SharedPrefixes m_sharedPrefixes;
 	ProcessNodes m_globalNodes;
 	ProgressReportList m_progressReport;
+	Workers m_workers;
+	std::mutex m_consumerMutex;
+	RunTimeProfiler m_runTimeProfiler;
+	QuantityCache m_quantityCache;
 	bool m_registerSignalHandler;
 };
 
@@ -1,5 +1,9 @@
 
 #pragma once
+
+#include <string>
+#include <vector>
+
 #include <boost/noncopyable.hpp>
 
 enum class ProcessNodeType {
@@ -14,4 +18,10 @@ public:
 	virtual ~ProcessNodeBase();
 
 	virtual  ProcessNodeType GetProcessNodeType () const = 0;
+
+	/// Add the names of all input collections read from the event and return true. The names are
+	/// the ones of the settings configuring the collections in the event provider (e.g. "Muons").
+	/// Collections not read by any node are not read from the input (see PruneInputCollections).
+	/// The default is to read all collections. Derived classes must extend the list of their base.
+	virtual bool GetInputCollections(std::vector<std::string> & collectionNames) const;
 };
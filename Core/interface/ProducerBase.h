@@ -2,6 +2,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 
@@ -37,6 +38,13 @@ public:
 	/// Must return a unique id of the producer.
 	virtual std::string GetProducerId() const = 0;
 
+	/// Add the names of all settings read by this producer and return true, if its output only
+	/// depends on the event, the product and these settings. Leading producers of several
+	/// pipelines are then run only once per event, if they read identical settings
+	/// (see ShareProducerPrefixes). The default is not to share the producer. Objects created by a shared
+	/// producer are seen by all pipelines and must not be changed in place by the following producers.
+	virtual bool GetSettingDependencies(std::vector<std::string> & settingNames) const;
+
 protected:
 	// will be implemented by the ConsumerBase class
 	virtual void baseInit(SettingsBase const& settings) = 0;
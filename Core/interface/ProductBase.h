@@ -1,14 +1,20 @@
 #pragma once
 
-#include <map>
 #include "FilterResult.h"
+#include "QuantityCache.h"
+#include "RunTimeProfiler.h"
 
 struct ProductBase
 {
 	// TODO: Is PreviousPipelinesResult really necessary?
+	// if the pipelines are run in parallel, all decisions are still undefined
 	FilterResult PreviousPipelinesResult;
 	FilterResult fres;
-	std::map<std::string, int> processorRunTime;
+	// run times of the global nodes and of the nodes of the current pipeline
+	RunTimeProfiler const* globalRunTimeProfiler = nullptr;
+	RunTimeProfiler const* localRunTimeProfiler = nullptr;
+	// values of quantities, which do not depend on the pipeline, computed in the current event
+	QuantityCache* quantityCache = nullptr;
 	bool newLumisection;
 	bool newRun;
 };
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+/// Declares on which inputs the value of a quantity depends.
+enum class QuantityScope
+{
+	/// only the event content
+	Event,
+	/// the event content and products of global producers, which are not modified by the pipelines
+	GlobalProduct,
+	/// products of the pipeline (not cached)
+	PipelineProduct
+};
+
+
+/**
+   \brief Per-event cache for the values of quantities, which do not depend on the pipeline.
+
+   Quantities are addressed by process wide ids (see GetQuantityId). The runner owns one cache
+   and calls StartEvent for every event, the pipeline products point to it via the global product.
+   A value is computed by the first pipeline or consumer asking for it in the current event. The
+   cache can be used by pipelines running in parallel.
+*/
+class QuantityCache: public boost::noncopyable
+{
+public:
+
+	static const size_t UnknownQuantity;
+
+	/// returns the id of a quantity name, the name is registered if necessary
+	static size_t GetQuantityId(std::string const& quantityName);
+	/// returns UnknownQuantity if the name is not registered
+	static size_t FindQuantityId(std::string const& quantityName);
+	static std::string GetQuantityName(size_t quantityId);
+	static size_t GetNumberOfQuantities();
+
+	~QuantityCache();
+
+	/// provides slots for all quantities registered so far and invalidates all values
+	void Init();
+
+	/// to be called at the beginning of each event
+	void StartEvent()
+	{
+		++m_generation;
+	}
+
+	/// returns the cached value of the current event or computes and caches it
+	template<class T, class TComputation>
+	T const& Get(size_t quantityId, TComputation const& computation)
+	{
+		return GetInPlace<T>(quantityId, [&computation](T& value) {
+			value = computation();
+		});
+	}
+
+	/// same as Get, but the computation overwrites the value of the previous event,
+	/// such that the memory allocated by the value can be reused
+	template<class T, class TComputation>
+	T const& GetInPlace(size_t quantityId, TComputation const& computation)
+	{
+		Entry<T>* entry = GetEntry<T>(quantityId);
+		if (entry->generation.load(std::memory_order_acquire) != m_generation)
+		{
+			std::lock_guard<std::mutex> lock(entry->mutex);
+			if (entry->generation.load(std::memory_order_relaxed) != m_generation)
+			{
+				computation(entry->value);
+				entry->generation.store(m_generation, std::memory_order_release);
+			}
+		}
+		return entry->value;
+	}
+
+	/// false for quantities registered after Init, these are not cached
+	bool HasSlot(size_t quantityId) const
+	{
+		return (quantityId < m_nSlots);
+	}
+
+private:
+
+	struct EntryBase
+	{
+		explicit EntryBase(std::type_info const& type) : type(type) {}
+		virtual ~EntryBase() {}
+
+		std::type_info const& type;
+		std::mutex mutex;
+		std::atomic<unsigned long long> generation {0};
+	};
+
+	template<class T>
+	struct Entry: public EntryBase
+	{
+		Entry() : EntryBase(typeid(T)) {}
+		T value;
+	};
+
+	// the entries are created when a quantity is requested for the first time, since only the
+	// extractors know the types of the values
+	template<class T>
+	Entry<T>* GetEntry(size_t quantityId)
+	{
+		EntryBase* entry = m_entries[quantityId].load(std::memory_order_acquire);
+		if (entry == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			entry = m_entries[quantityId].load(std::memory_order_relaxed);
+			if (entry == nullptr)
+			{
+				entry = new Entry<T>();
+				m_entries[quantityId].store(entry, std::memory_order_release);
+			}
+		}
+		if (entry->type != typeid(T))
+		{
+			LOG(FATAL) << "Quantity \"" << GetQuantityName(quantityId) << "\" is requested from the cache with different types!";
+		}
+		return static_cast<Entry<T>*>(entry);
+	}
+
+	void Clear();
+
+	std::unique_ptr<std::atomic<EntryBase*>[]> m_entries;
+	size_t m_nSlots = 0;
+	std::mutex m_mutex;
+	unsigned long long m_generation = 0;
+};
+
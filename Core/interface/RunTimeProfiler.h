@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "Artus/Utility/interface/DefaultValues.h"
+
+/**
+   \brief Distribution of the run times of one process node.
+
+   The run times are filled into logarithmic bins (four bins per factor of two), such that
+   quantiles can be estimated with a relative precision of about 20% without storing the
+   single measurements.
+*/
+class RunTimeStatistics
+{
+public:
+
+	static const size_t NBins = 256;
+
+	void Add(unsigned long long nanoSeconds);
+	void Merge(RunTimeStatistics const& other);
+
+	unsigned long long GetCount() const;
+
+	/// all run times in microseconds
+	double GetMean() const;
+	double GetMax() const;
+	double GetQuantile(double quantile) const;
+
+private:
+
+	static size_t GetBin(unsigned long long nanoSeconds);
+	static double GetBinCentre(size_t bin);
+
+	std::array<unsigned long long, NBins> m_bins {{}};
+	unsigned long long m_count = 0;
+	unsigned long long m_sum = 0;
+	unsigned long long m_max = 0;
+};
+
+
+/**
+   \brief Measures the run times of the process nodes of a pipeline or of the global nodes.
+
+   Every node owns a preallocated slot, which is addressed by the position of the node. The
+   run times are only measured every SamplingInterval-th event. The run times of the current
+   event can be read by consumers via the pointers in the product.
+*/
+class RunTimeProfiler: public boost::noncopyable
+{
+public:
+
+	typedef std::chrono::steady_clock clock_type;
+
+	static const size_t UnknownNode;
+
+	/// one slot per node, this resets all measurements
+	void SetNodes(std::vector<std::string> const& nodeIds);
+	void SetSamplingInterval(size_t samplingInterval);
+
+	size_t GetNumberOfNodes() const;
+	std::string const& GetNodeId(size_t node) const;
+	/// slot of a node or UnknownNode
+	size_t FindNode(std::string const& nodeId) const;
+
+	/// profiler of the nodes, which are shared with other pipelines and run before
+	/// the nodes of this profiler (see SharedPrefix)
+	void SetSharedProfiler(RunTimeProfiler const* sharedProfiler);
+	RunTimeProfiler const* GetSharedProfiler() const;
+
+	/// to be called at the beginning of each event
+	void StartEvent()
+	{
+		m_sampling = ((m_eventCounter % m_samplingInterval) == 0);
+		++m_eventCounter;
+		if (m_sampling)
+		{
+			std::fill(m_runTimes.begin(), m_runTimes.end(), DefaultValues::UndefinedInt);
+		}
+	}
+
+	/// true, if the run times of the current event are measured
+	bool IsSampling() const
+	{
+		return m_sampling;
+	}
+
+	clock_type::time_point Start() const
+	{
+		return (m_sampling ? clock_type::now() : clock_type::time_point());
+	}
+
+	void Stop(size_t node, clock_type::time_point const& start)
+	{
+		if (m_sampling)
+		{
+			unsigned long long nanoSeconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+			m_runTimes[node] = static_cast<int>(nanoSeconds / 1000);
+			m_statistics[node].Add(nanoSeconds);
+		}
+	}
+
+	/// run time of the current event in microseconds, DefaultValues::UndefinedInt if the
+	/// node has not been run or the event has not been sampled
+	int GetRunTime(size_t node) const
+	{
+		return m_runTimes[node];
+	}
+
+	RunTimeStatistics const& GetStatistics(size_t node) const;
+
+private:
+
+	std::vector<std::string> m_nodeIds;
+	std::vector<int> m_runTimes;
+	std::vector<RunTimeStatistics> m_statistics;
+	RunTimeProfiler const* m_sharedProfiler = nullptr;
+
+	size_t m_samplingInterval = 1;
+	unsigned long long m_eventCounter = 0;
+	bool m_sampling = false;
+};
+
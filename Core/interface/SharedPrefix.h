@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "FilterResult.h"
+#include "ProducerBase.h"
+#include "RunTimeProfiler.h"
+
+/**
+   \brief Leading producers, which are identical for several pipelines and are run only once per event.
+
+   A shared prefix starts from the product of its parent prefix (or the global product) and runs
+   its producers on its own copy of the product. The pipelines sharing the prefix start from this
+   product and skip their first GetNumberOfNodes() nodes. The producers are owned by one of the
+   pipelines, the settings are the ones of this pipeline. The prefixes are built by
+   ArtusConfig::LoadPipelines, if ShareProducerPrefixes is enabled. The run times of the
+   producers are measured by the profiler of the prefix, which is the shared profiler of the
+   profilers of the pipelines and child prefixes.
+
+   The product is copied as the global product is, objects owned by shared pointers (e.g. the
+   corrected objects) are therefore shared by all pipelines of the prefix. Producers after the
+   prefix may replace them, but must not change them in place (e.g. apply further corrections),
+   since this would affect the other pipelines and race with them, if the pipelines run in parallel.
+*/
+template<class TTypes>
+class SharedPrefix: public boost::noncopyable {
+public:
+
+	typedef typename TTypes::event_type event_type;
+	typedef typename TTypes::product_type product_type;
+	typedef typename TTypes::setting_type setting_type;
+
+	typedef ProducerBase<TTypes> producer_type;
+
+	SharedPrefix(SharedPrefix<TTypes> const* parent,
+			std::vector<producer_type*> const& producers,
+			setting_type const& settings) :
+		m_parent(parent),
+		m_producers(producers),
+		m_settings(settings),
+		m_nNodes(producers.size() + ((parent != nullptr) ? parent->GetNumberOfNodes() : 0))
+	{
+		std::vector<std::string> nodeIds;
+		for (typename std::vector<producer_type*>::const_iterator it = m_producers.begin(); it != m_producers.end(); ++it) {
+			nodeIds.push_back((*it)->GetProducerId());
+		}
+		m_runTimeProfiler.SetNodes(nodeIds);
+		m_runTimeProfiler.SetSamplingInterval(m_settings.GetRunTimeSamplingInterval());
+		m_runTimeProfiler.SetSharedProfiler((parent != nullptr) ? &(parent->GetRunTimeProfiler()) : nullptr);
+	}
+
+	/// Must be called after the prefix of the parent has been run for this event.
+	void RunEvent(event_type const& evt,
+			product_type const& globalProduct,
+			FilterResult const& globalFilterResult) {
+
+		m_product = ((m_parent != nullptr) ? m_parent->GetProduct() : globalProduct);
+		m_runTimeProfiler.StartEvent();
+
+		// the producers of the pipelines are not run, if a global filter failed
+		if (! globalFilterResult.HasPassed())
+			return;
+
+		size_t nodeIndex = 0;
+		for (typename std::vector<producer_type*>::iterator it = m_producers.begin(); it != m_producers.end(); ++it, ++nodeIndex) {
+			const RunTimeProfiler::clock_type::time_point tStart = m_runTimeProfiler.Start();
+			if(globalProduct.newRun)
+				ProducerBaseAccess(**it).OnRun(evt, m_settings);
+			if(globalProduct.newLumisection)
+				ProducerBaseAccess(**it).OnLumi(evt, m_settings);
+			ProducerBaseAccess(**it).Produce(evt, m_product, m_settings);
+			m_runTimeProfiler.Stop(nodeIndex, tStart);
+		}
+	}
+
+	product_type const& GetProduct() const {
+		return m_product;
+	}
+
+	RunTimeProfiler const& GetRunTimeProfiler() const {
+		return m_runTimeProfiler;
+	}
+
+	/// number of nodes including the ones of the parent prefixes
+	size_t GetNumberOfNodes() const {
+		return m_nNodes;
+	}
+
+private:
+	SharedPrefix<TTypes> const* m_parent;
+	std::vector<producer_type*> m_producers;
+	setting_type m_settings;
+	size_t m_nNodes;
+
+	product_type m_product;
+	RunTimeProfiler m_runTimeProfiler;
+};
+
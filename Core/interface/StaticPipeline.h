@@ -0,0 +1,309 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+#include "Pipeline.h"
+
+/**
+   \brief Pipeline with a list of nodes fixed at compile time.
+
+   TNodes is a list of producers, filters and consumers for TTypes, which are default-constructed
+   by the pipeline. The producers and filters are run in the given order, followed by the
+   consumers. All calls to the nodes are qualified and therefore non-virtual, such that the
+   compiler can inline them. This saves the dispatch overhead for fixed production chains with
+   many light-weight producers.
+
+   The pipeline can be added to a PipelineRunner like any other Pipeline. Nodes added by the
+   PipelineInitilizer are run after the static nodes, consumers added by the PipelineInitilizer
+   after the static consumers.
+
+   The workers of multi-threaded runs only create the pipelines from the configuration, therefore
+   static pipelines require NumberOfThreads = 1. This is checked before the event loop starts.
+
+   typedef StaticPipeline<KappaTypes,
+                          ValidMuonsProducer<KappaTypes>,
+                          MinMuonsCountFilter,
+                          KappaLambdaNtupleConsumer<KappaTypes> > ZmmPipeline;
+   ZmmPipeline * pipeline = new ZmmPipeline();
+   pipeline->InitPipeline(pipelineSettings, pipelineInitializer);
+   pipelineRunner.AddPipeline(pipeline);
+
+   A compiled example is KappaValidMuonsPipeline in KappaAnalysis/interface/KappaStaticPipelines.h.
+*/
+template<class TTypes, class... TNodes>
+class StaticPipeline: public Pipeline<TTypes> {
+public:
+
+	typedef typename TTypes::event_type event_type;
+	typedef typename TTypes::product_type product_type;
+	typedef typename TTypes::setting_type setting_type;
+
+	static const size_t NNodes = sizeof...(TNodes);
+
+	void InitPipeline(setting_type pset,
+			PipelineInitilizerBase<TTypes> const& initializer) override {
+
+		Pipeline<TTypes>::InitPipeline(pset, initializer);
+
+		// the run time slots of the static nodes follow the ones of the other nodes
+		RunTimeProfiler & runTimeProfiler = this->GetRunTimeProfiler();
+		m_firstNodeSlot = runTimeProfiler.GetNumberOfNodes();
+		std::vector<std::string> nodeIds;
+		for (size_t slot = 0; slot < m_firstNodeSlot; ++slot) {
+			nodeIds.push_back(runTimeProfiler.GetNodeId(slot));
+		}
+
+		InitNodes<0>(this->GetSettings(), nodeIds);
+		runTimeProfiler.SetNodes(nodeIds);
+	}
+
+	void FinishPipeline() override {
+		FinishConsumers<0>(this->GetSettings());
+		Pipeline<TTypes>::FinishPipeline();
+	}
+
+	bool IsMergeable() const override {
+		return (AreConsumersMergeable<0>() && Pipeline<TTypes>::IsMergeable());
+	}
+
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override {
+		return (GetNodeInputCollections<0>(collectionNames) && Pipeline<TTypes>::GetInputCollections(collectionNames));
+	}
+
+	void MergePipeline(Pipeline<TTypes> & other) override {
+		StaticPipeline<TTypes, TNodes...> * specOther = dynamic_cast<StaticPipeline<TTypes, TNodes...> *>(&other);
+		if (specOther == nullptr) {
+			LOG(FATAL) << "Cannot merge static pipeline \"" << this->GetSettings().GetName() << "\" with a pipeline of a different type!";
+		}
+
+		MergeConsumers<0>(*specOther, this->GetSettings());
+		Pipeline<TTypes>::MergePipeline(other);
+	}
+
+	/// Access to the static nodes, e.g. to configure them before InitPipeline.
+	template<size_t I>
+	typename std::tuple_element<I, std::tuple<TNodes...> >::type & GetNode() {
+		return std::get<I>(m_nodes);
+	}
+
+protected:
+
+	void RunNodes(event_type const& evt,
+			product_type const& globalProduct,
+			product_type & localProduct,
+			FilterResult & localFilterResult) override {
+
+		RunNodes<0>(evt, globalProduct, localProduct, localFilterResult, this->GetSettings());
+		Pipeline<TTypes>::RunNodes(evt, globalProduct, localProduct, localFilterResult);
+	}
+
+	void RunConsumers(event_type const& evt,
+			product_type const& globalProduct,
+			product_type const& localProduct,
+			FilterResult const& localFilterResult) override {
+
+		RunConsumers<0>(evt, globalProduct, localProduct, localFilterResult, this->GetSettings());
+		Pipeline<TTypes>::RunConsumers(evt, globalProduct, localProduct, localFilterResult);
+	}
+
+private:
+
+	template<ProcessNodeType TNodeType>
+	using NodeTypeTag = std::integral_constant<ProcessNodeType, TNodeType>;
+
+	template<class TNode>
+	struct NodeType {
+		static_assert(std::is_base_of<ProducerBase<TTypes>, TNode>::value ||
+		              std::is_base_of<FilterBase<TTypes>, TNode>::value ||
+		              std::is_base_of<ConsumerBase<TTypes>, TNode>::value,
+		              "The nodes of a StaticPipeline must be producers, filters or consumers of the same types.");
+		typedef NodeTypeTag<std::is_base_of<ProducerBase<TTypes>, TNode>::value ? ProcessNodeType::Producer :
+		                    (std::is_base_of<FilterBase<TTypes>, TNode>::value ? ProcessNodeType::Filter :
+		                     ProcessNodeType::Consumer)> type;
+	};
+
+	template<size_t I>
+	using Node = typename std::tuple_element<I, std::tuple<TNodes...> >::type;
+
+	// initialisation
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes)>::type InitNodes(setting_type const& settings, std::vector<std::string> & nodeIds) {
+		m_staticFilterIndices[I] = FilterResult::UnknownFilter;
+		InitNode(std::get<I>(m_nodes), m_staticFilterIndices[I], settings, nodeIds, typename NodeType<Node<I> >::type());
+		InitNodes<I+1>(settings, nodeIds);
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes)>::type InitNodes(setting_type const&, std::vector<std::string> &) {}
+
+	template<class TNode>
+	void InitNode(TNode & node, FilterResult::FilterIndex &, setting_type const& settings,
+			std::vector<std::string> & nodeIds, NodeTypeTag<ProcessNodeType::Producer>) {
+		nodeIds.push_back(node.GetProducerId());
+		node.Init(settings);
+	}
+	template<class TNode>
+	void InitNode(TNode & node, FilterResult::FilterIndex & filterIndex, setting_type const& settings,
+			std::vector<std::string> & nodeIds, NodeTypeTag<ProcessNodeType::Filter>) {
+		nodeIds.push_back(node.GetFilterId());
+		filterIndex = FilterResult::GetFilterIndex(node.GetFilterId());
+		node.Init(settings);
+	}
+	template<class TNode>
+	void InitNode(TNode & node, FilterResult::FilterIndex &, setting_type const& settings,
+			std::vector<std::string> & nodeIds, NodeTypeTag<ProcessNodeType::Consumer>) {
+		// consumers have no run time slot, but the indices must match the nodes
+		nodeIds.push_back(node.GetConsumerId());
+		node.Init(settings);
+	}
+
+	// producers and filters
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes)>::type RunNodes(event_type const& evt, product_type const& globalProduct,
+			product_type & localProduct, FilterResult & localFilterResult, setting_type const& settings) {
+
+		// stop processing as soon as one filter fails
+		if (! localFilterResult.HasPassed())
+			return;
+
+		RunNode<I>(std::get<I>(m_nodes), evt, globalProduct, localProduct, localFilterResult, settings,
+		           typename NodeType<Node<I> >::type());
+		RunNodes<I+1>(evt, globalProduct, localProduct, localFilterResult, settings);
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes)>::type RunNodes(event_type const&, product_type const&,
+			product_type &, FilterResult &, setting_type const&) {}
+
+	template<size_t I, class TNode>
+	void RunNode(TNode & node, event_type const& evt, product_type const& globalProduct,
+			product_type & localProduct, FilterResult &, setting_type const& settings,
+			NodeTypeTag<ProcessNodeType::Producer>) {
+		RunTimeProfiler & runTimeProfiler = this->GetRunTimeProfiler();
+		const RunTimeProfiler::clock_type::time_point tStart = runTimeProfiler.Start();
+		if(globalProduct.newRun)
+			node.TNode::OnRun(evt, settings);
+		if(globalProduct.newLumisection)
+			node.TNode::OnLumi(evt, settings);
+		node.TNode::Produce(evt, localProduct, settings);
+		runTimeProfiler.Stop(m_firstNodeSlot + I, tStart);
+	}
+	template<size_t I, class TNode>
+	void RunNode(TNode & node, event_type const& evt, product_type const& globalProduct,
+			product_type & localProduct, FilterResult & localFilterResult, setting_type const& settings,
+			NodeTypeTag<ProcessNodeType::Filter>) {
+		RunTimeProfiler & runTimeProfiler = this->GetRunTimeProfiler();
+		const RunTimeProfiler::clock_type::time_point tStart = runTimeProfiler.Start();
+		if(globalProduct.newRun)
+			node.TNode::OnRun(evt, settings);
+		if(globalProduct.newLumisection)
+			node.TNode::OnLumi(evt, settings);
+		const bool filterResult = node.TNode::DoesEventPass(evt, localProduct, settings);
+		localFilterResult.SetFilterDecision(m_staticFilterIndices[I], filterResult);
+		runTimeProfiler.Stop(m_firstNodeSlot + I, tStart);
+	}
+	template<size_t I, class TNode>
+	void RunNode(TNode &, event_type const&, product_type const&,
+			product_type &, FilterResult &, setting_type const&,
+			NodeTypeTag<ProcessNodeType::Consumer>) {}
+
+	// consumers
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes)>::type RunConsumers(event_type const& evt, product_type const& globalProduct,
+			product_type const& localProduct, FilterResult const& localFilterResult, setting_type const& settings) {
+		RunConsumer(std::get<I>(m_nodes), evt, globalProduct, localProduct, localFilterResult, settings,
+		            typename NodeType<Node<I> >::type());
+		RunConsumers<I+1>(evt, globalProduct, localProduct, localFilterResult, settings);
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes)>::type RunConsumers(event_type const&, product_type const&,
+			product_type const&, FilterResult const&, setting_type const&) {}
+
+	template<class TNode, class TNodeTypeTag>
+	void RunConsumer(TNode &, event_type const&, product_type const&,
+			product_type const&, FilterResult const&, setting_type const&, TNodeTypeTag) {}
+	template<class TNode>
+	void RunConsumer(TNode & node, event_type const& evt, product_type const& globalProduct,
+			product_type const& localProduct, FilterResult const& localFilterResult, setting_type const& settings,
+			NodeTypeTag<ProcessNodeType::Consumer>) {
+		if(globalProduct.newRun)
+			node.TNode::OnRun(evt, settings);
+		if(globalProduct.newLumisection)
+			node.TNode::OnLumi(evt, settings);
+		if (localFilterResult.HasPassed()) {
+			node.TNode::ProcessFilteredEvent(evt, localProduct, settings);
+		}
+		// every consumer gets its own copy, which it may modify
+		m_consumerFilterResult = localFilterResult;
+		node.TNode::ProcessEvent(evt, localProduct, settings, m_consumerFilterResult);
+	}
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes)>::type FinishConsumers(setting_type const& settings) {
+		FinishConsumer(std::get<I>(m_nodes), settings, typename NodeType<Node<I> >::type());
+		FinishConsumers<I+1>(settings);
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes)>::type FinishConsumers(setting_type const&) {}
+
+	template<class TNode, class TNodeTypeTag>
+	void FinishConsumer(TNode &, setting_type const&, TNodeTypeTag) {}
+	template<class TNode>
+	void FinishConsumer(TNode & node, setting_type const& settings, NodeTypeTag<ProcessNodeType::Consumer>) {
+		node.Finish(settings);
+	}
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes), bool>::type AreConsumersMergeable() const {
+		return (IsConsumerMergeable(std::get<I>(m_nodes), typename NodeType<Node<I> >::type()) &&
+		        AreConsumersMergeable<I+1>());
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes), bool>::type AreConsumersMergeable() const {
+		return true;
+	}
+
+	template<class TNode, class TNodeTypeTag>
+	bool IsConsumerMergeable(TNode const&, TNodeTypeTag) const {
+		return true;
+	}
+	template<class TNode>
+	bool IsConsumerMergeable(TNode const& node, NodeTypeTag<ProcessNodeType::Consumer>) const {
+		return node.IsMergeable();
+	}
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes), bool>::type GetNodeInputCollections(std::vector<std::string> & collectionNames) const {
+		return (std::get<I>(m_nodes).GetInputCollections(collectionNames) && GetNodeInputCollections<I+1>(collectionNames));
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes), bool>::type GetNodeInputCollections(std::vector<std::string> &) const {
+		return true;
+	}
+
+	template<size_t I>
+	typename std::enable_if<(I < NNodes)>::type MergeConsumers(StaticPipeline<TTypes, TNodes...> & other,
+			setting_type const& settings) {
+		MergeConsumer(std::get<I>(m_nodes), std::get<I>(other.m_nodes), settings, typename NodeType<Node<I> >::type());
+		MergeConsumers<I+1>(other, settings);
+	}
+	template<size_t I>
+	typename std::enable_if<(I == NNodes)>::type MergeConsumers(StaticPipeline<TTypes, TNodes...> &,
+			setting_type const&) {}
+
+	template<class TNode, class TNodeTypeTag>
+	void MergeConsumer(TNode &, TNode &, setting_type const&, TNodeTypeTag) {}
+	template<class TNode>
+	void MergeConsumer(TNode & node, TNode & other, setting_type const& settings, NodeTypeTag<ProcessNodeType::Consumer>) {
+		node.Merge(other, settings);
+	}
+
+	std::tuple<TNodes...> m_nodes;
+	std::array<FilterResult::FilterIndex, NNodes> m_staticFilterIndices;
+	FilterResult m_consumerFilterResult;
+	size_t m_firstNodeSlot = 0;
+};
+
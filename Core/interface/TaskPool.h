@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+/**
+   \brief Pool of threads executing a list of independent tasks.
+
+   Run hands out the tasks one by one to the threads of the pool and to the calling thread,
+   such that idle threads pick up the remaining work, and returns after all tasks are done.
+   The threads are started once and are reused for every call of Run.
+*/
+class TaskPool: public boost::noncopyable
+{
+public:
+
+	typedef std::function<void()> Task;
+
+	/// nThreads is the total number of threads working on the tasks, including the calling thread
+	explicit TaskPool(size_t nThreads);
+	~TaskPool();
+
+	/// Execute all tasks and wait for them to finish.
+	void Run(std::vector<Task> const& tasks);
+
+	size_t GetNumberOfThreads() const;
+
+private:
+
+	void WorkerLoop();
+	void ProcessTasks();
+
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_startCondition;
+	std::condition_variable m_doneCondition;
+
+	std::vector<Task> const* m_tasks = nullptr;
+	std::atomic<size_t> m_nextTask;
+	unsigned long long m_generation = 0;
+	size_t m_activeWorkers = 0;
+	bool m_stop = false;
+};
@@ -15,25 +15,54 @@ void CutFlow::AddFilterResult(FilterResult const& fres)
 {
 	++m_overallEventCount;
 
-	auto const& dec = fres.GetFilterDecisions();
-	for (FilterResult::FilterDecisions::const_iterator it = dec.begin();
-	     it != dec.end(); ++it)
+	auto const& filterIndices = fres.GetFilterIndices();
+	for (FilterResult::FilterIndices::const_iterator it = filterIndices.begin();
+	     it != filterIndices.end(); ++it)
 	{
 		// only store, if passed
 		long addVal = 0;
-		if (it->filterDecision == FilterResult::Decision::Passed &&
-		    it->taggingMode == FilterResult::TaggingMode::Filtering) {
+		if (fres.GetFilterDecision(*it) == FilterResult::Decision::Passed &&
+		    fres.GetTaggingMode(*it) == FilterResult::TaggingMode::Filtering) {
 			addVal = 1;
 		}
 
-		CutFlow::CutStat * stat = CutFlow::GetCutEntry(it->filterName);
+		// the entries are looked up by name only once per filter
+		if (*it >= m_cutEntries.size())
+		{
+			m_cutEntries.resize(*it + 1, nullptr);
+		}
+		CutFlow::CutStat * stat = m_cutEntries[*it];
+		if (stat == nullptr)
+		{
+			std::string filterName = FilterResult::GetFilterName(*it);
+			stat = CutFlow::GetCutEntry(filterName);
+			if (stat == nullptr)
+			{
+				m_cutCount.push_back(std::make_pair(filterName, 0l));
+				stat = &(m_cutCount.back());
+			}
+			m_cutEntries[*it] = stat;
+		}
+		stat->second += addVal;
+	}
+}
+
+// add the counts of another cut flow, e.g. from another thread
+void CutFlow::Merge(CutFlow const& other)
+{
+	m_overallEventCount += other.m_overallEventCount;
+
+	for (CutFlow::CutCount::const_iterator it = other.m_cutCount.begin();
+	     it != other.m_cutCount.end(); ++it)
+	{
+		CutFlow::CutStat * stat = CutFlow::GetCutEntry(it->first);
 		if (stat == nullptr)
 		{
-			m_cutCount.push_back(std::make_pair(it->filterName, addVal));
+			m_cutCount.push_back(*it);
 		}
 		else
 		{
-			stat->second += addVal;
+			stat->second += it->second;
 		}
 	}
 }
@@ -1,10 +1,31 @@
 
-#include <algorithm>
+#include <deque>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #include "Artus/Core/interface/FilterResult.h"
 
 
+const FilterResult::FilterIndex FilterResult::UnknownFilter;
+
+namespace
+{
+	// process wide mapping of filter names to indices
+	struct FilterNameRegistry
+	{
+		std::mutex mutex;
+		std::unordered_map<std::string, FilterResult::FilterIndex> indices;
+		std::deque<std::string> names;
+	};
+
+	FilterNameRegistry & GetFilterNameRegistry()
+	{
+		static FilterNameRegistry registry;
+		return registry;
+	}
+}
+
 FilterResult::DecisionEntry::DecisionEntry() :
 		filterName(""),
 		filterDecision(Decision::Undefined),
@@ -19,37 +40,146 @@ FilterResult::DecisionEntry::DecisionEntry(std::string filterName, Decision filt
 {
 }
 
+FilterResult::FilterIndex FilterResult::GetFilterIndex(std::string const& filterName) {
+	FilterNameRegistry & registry = GetFilterNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	auto it = registry.indices.find(filterName);
+	if (it != registry.indices.end())
+		return it->second;
+
+	FilterIndex filterIndex = registry.names.size();
+	registry.names.push_back(filterName);
+	registry.indices[filterName] = filterIndex;
+	return filterIndex;
+}
+
+FilterResult::FilterIndices FilterResult::GetFilterIndices(FilterNames const& filterNames) {
+	FilterIndices filterIndices;
+	filterIndices.reserve(filterNames.size());
+	for (FilterNames::const_iterator it = filterNames.begin(); it != filterNames.end(); ++it) {
+		filterIndices.push_back(GetFilterIndex(*it));
+	}
+	return filterIndices;
+}
+
+FilterResult::FilterIndex FilterResult::FindFilterIndex(std::string const& filterName) {
+	FilterNameRegistry & registry = GetFilterNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	auto it = registry.indices.find(filterName);
+	return ((it != registry.indices.end()) ? it->second : UnknownFilter);
+}
+
+std::string FilterResult::GetFilterName(FilterIndex filterIndex) {
+	FilterNameRegistry & registry = GetFilterNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	if (filterIndex >= registry.names.size()) {
+		LOG(FATAL) << "Filter index " << filterIndex << " is not registered!";
+	}
+	return registry.names[filterIndex];
+}
+
 FilterResult::FilterResult() :
-		// has passed by default
-		m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
+		m_filterDecisionsValid(false),
+		m_filterDecisionsWritable(false) {
 }
 
 FilterResult::FilterResult(FilterNames const& initialFilterNames ) :
-		// has passed by default
-		m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
-
+		m_filterDecisionsValid(false),
+		m_filterDecisionsWritable(false) {
 	AddFilterNames ( initialFilterNames );
 }
 
 FilterResult::FilterResult(FilterNames const& initialFilterNames, FilterNames const& taggingFilters ) :
-		// has passed by default
-		m_taggingFilters(taggingFilters), m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
-	AddFilterNames ( initialFilterNames );
+		m_filterDecisionsValid(false),
+		m_filterDecisionsWritable(false) {
+	AddFilterNames ( initialFilterNames, taggingFilters );
+}
+
+FilterResult::FilterResult(FilterIndices const& initialFilterIndices, FilterIndices const& taggingFilterIndices) :
+		m_filterDecisionsValid(false),
+		m_filterDecisionsWritable(false) {
+	AddFilterIndices ( initialFilterIndices, taggingFilterIndices );
+}
+
+FilterResult::FilterResult(FilterResult const& other) :
+		m_filterDecisionsValid(false),
+		m_filterDecisionsWritable(false) {
+	*this = other;
+}
+
+FilterResult& FilterResult::operator=(FilterResult const& other) {
+	other.ApplyDecisionEntries();
+
+	// the containers keep their capacity, such that no memory is allocated here
+	m_filterIndices = other.m_filterIndices;
+	m_filters = other.m_filters;
+	m_decided = other.m_decided;
+	m_passed = other.m_passed;
+	m_taggingMode = other.m_taggingMode;
+	m_taggingFilters = other.m_taggingFilters;
+	m_vetoes = other.m_vetoes;
+	m_filterDecisionsValid = false;
+	m_filterDecisionsWritable = false;
+	return *this;
+}
+
+bool FilterResult::TestBit(FilterBits const& bits, FilterIndex filterIndex) {
+	return ((filterIndex < bits.size()) && bits.test(filterIndex));
+}
+
+void FilterResult::SetBit(FilterBits & bits, FilterIndex filterIndex, bool value) {
+	if (filterIndex >= bits.size()) {
+		if (! value)
+			return;
+		bits.resize(filterIndex + 1);
+	}
+	bits.set(filterIndex, value);
+}
+
+void FilterResult::ApplyDecisionEntries() const {
+	if (! m_filterDecisionsWritable)
+		return;
+
+	// the entries are in the order of the indices
+	FilterResult::FilterIndices::const_iterator filterIndex = m_filterIndices.begin();
+	for (FilterResult::FilterDecisions::const_iterator it = m_filterDecisions.begin();
+			it != m_filterDecisions.end(); ++it, ++filterIndex) {
+		SetBit(m_decided, *filterIndex, (it->filterDecision != Decision::Undefined));
+		SetBit(m_passed, *filterIndex, (it->filterDecision == Decision::Passed));
+		SetBit(m_taggingMode, *filterIndex, (it->taggingMode == TaggingMode::Tagging));
+		SetBit(m_vetoes, *filterIndex, (it->filterDecision == Decision::NotPassed) &&
+		                               (it->taggingMode == TaggingMode::Filtering));
+	}
 }
 
 FilterResult::DecisionEntry * FilterResult::GetDecisionEntry( std::string const& filterName ) {
-	for ( FilterResult::FilterDecisions::iterator it = m_filterDecisions.begin();
+	FilterResult::FilterIndex filterIndex = FindFilterIndex(filterName);
+	if ((filterIndex == UnknownFilter) || (! TestBit(m_filters, filterIndex)))
+		return nullptr;
+
+	GetFilterDecisions();
+	for (FilterResult::FilterDecisions::iterator it = m_filterDecisions.begin();
 			it != m_filterDecisions.end(); ++it) {
-		if ( filterName == it->filterName )
+		if ( filterName == it->filterName ) {
+			m_filterDecisionsWritable = true;
 			return & ( *it );
+		}
 	}
 
 	return nullptr;
 }
 
 FilterResult::DecisionEntry const* FilterResult::GetDecisionEntry( std::string const& filterName ) const {
-	for ( FilterResult::FilterDecisions::const_iterator it = m_filterDecisions.begin();
-			it != m_filterDecisions.end(); ++it) {
+	FilterResult::FilterIndex filterIndex = FindFilterIndex(filterName);
+	if ((filterIndex == UnknownFilter) || (! TestBit(m_filters, filterIndex)))
+		return nullptr;
+
+	FilterResult::FilterDecisions const& filterDecisions = GetFilterDecisions();
+	for (FilterResult::FilterDecisions::const_iterator it = filterDecisions.begin();
+			it != filterDecisions.end(); ++it) {
 		if ( filterName == it->filterName )
 			return & ( *it );
 	}
@@ -58,11 +188,19 @@ FilterResult::DecisionEntry const* FilterResult::GetDecisionEntry( std::string c
 }
 
 FilterResult::TaggingMode FilterResult::IsTaggingFilter(std::string const& filterName ) const {
-	if (std::find(m_taggingFilters.begin(), m_taggingFilters.end(), filterName) != m_taggingFilters.end())
-	{
-		return TaggingMode::Tagging;
-	}
-	return TaggingMode::Filtering;
+	FilterResult::FilterIndex filterIndex = FindFilterIndex(filterName);
+	if (filterIndex == UnknownFilter)
+		return TaggingMode::Filtering;
+	return IsTaggingFilter(filterIndex);
+}
+
+FilterResult::TaggingMode FilterResult::IsTaggingFilter(FilterIndex filterIndex) const {
+	return (TestBit(m_taggingFilters, filterIndex) ? TaggingMode::Tagging : TaggingMode::Filtering);
+}
+
+FilterResult::TaggingMode FilterResult::GetTaggingMode(FilterIndex filterIndex) const {
+	ApplyDecisionEntries();
+	return (TestBit(m_taggingMode, filterIndex) ? TaggingMode::Tagging : TaggingMode::Filtering);
 }
 
 // add a list of filter names
@@ -70,93 +208,123 @@ FilterResult::TaggingMode FilterResult::IsTaggingFilter(std::string const& filte
 // name is not in the list before
 //
 void FilterResult::AddFilterNames( FilterNames const& fn, FilterNames const& taggingFilters){
-	m_taggingFilters.insert(m_taggingFilters.end(), taggingFilters.begin(), taggingFilters.end());
-	AddFilterNames(fn);
+	AddFilterIndices(GetFilterIndices(fn), GetFilterIndices(taggingFilters));
 }
 
 void FilterResult::AddFilterNames( FilterNames const& fn ){
-	for (FilterResult::FilterNames::const_iterator it = fn.begin(); it != fn.end(); ++it) {
-		FilterResult::DecisionEntry * entr = GetDecisionEntry( * it );
-		if ( entr == nullptr ) {
-			m_filterDecisions.push_back( DecisionEntry(*it, Decision::Undefined, IsTaggingFilter(*it)));
+	AddFilterIndices(GetFilterIndices(fn));
+}
+
+void FilterResult::AddFilterIndices( FilterIndices const& filterIndices, FilterIndices const& taggingFilterIndices){
+	for (FilterResult::FilterIndices::const_iterator it = taggingFilterIndices.begin(); it != taggingFilterIndices.end(); ++it) {
+		SetBit(m_taggingFilters, *it, true);
+	}
+	AddFilterIndices(filterIndices);
+}
+
+void FilterResult::AddFilterIndices( FilterIndices const& filterIndices ){
+	for (FilterResult::FilterIndices::const_iterator it = filterIndices.begin(); it != filterIndices.end(); ++it) {
+		if (! TestBit(m_filters, *it)) {
+			AddFilterIndex(*it);
 		}
 	}
 }
 
+void FilterResult::AddFilterIndex(FilterIndex filterIndex) {
+	ApplyDecisionEntries();
+
+	m_filterIndices.push_back(filterIndex);
+	SetBit(m_filters, filterIndex, true);
+	SetBit(m_taggingMode, filterIndex, TestBit(m_taggingFilters, filterIndex));
+	m_filterDecisionsValid = false;
+	m_filterDecisionsWritable = false;
+}
+
 // list of all filter names as a vector of strings
 FilterResult::FilterNames FilterResult::GetFilterNames() const {
 	FilterNames filterNames;
-	filterNames.resize(m_filterDecisions.size());
-	transform(m_filterDecisions.begin(), m_filterDecisions.end(), filterNames.begin(),
-	          [](FilterResult::DecisionEntry decisionEntry) { return decisionEntry.filterName; });
+	filterNames.reserve(m_filterIndices.size());
+	for (FilterResult::FilterIndices::const_iterator it = m_filterIndices.begin(); it != m_filterIndices.end(); ++it) {
+		filterNames.push_back(GetFilterName(*it));
+	}
 	return filterNames;
 }
 
-bool FilterResult::HasPassed() const {
-	if (m_IsCachedHasPassed)
-		return m_cacheHasPassed;
-
-	m_cacheHasPassed = true;
-	for (FilterResult::FilterDecisions::const_iterator it = GetFilterDecisions().begin();
-			it != GetFilterDecisions().end(); ++it) {
-		if (it->filterDecision == FilterResult::Decision::NotPassed &&
-		    it->taggingMode == FilterResult::TaggingMode::Filtering)
-			m_cacheHasPassed = false;
-	}
+FilterResult::FilterIndices const& FilterResult::GetFilterIndices() const {
+	return m_filterIndices;
+}
 
-	m_IsCachedHasPassed = true;
-	return m_cacheHasPassed;
+bool FilterResult::HasPassed() const {
+	ApplyDecisionEntries();
+	return m_vetoes.none();
 }
 
 bool FilterResult::HasPassedIfExcludingFilter(std::string const& excludedFilter) const {
-	for (FilterResult::FilterDecisions::const_iterator it = GetFilterDecisions().begin();
-			it != GetFilterDecisions().end(); ++it) {
-		if (it->filterDecision == FilterResult::Decision::NotPassed &&
-		    it->taggingMode == FilterResult::TaggingMode::Filtering)
-		{
-			if (it->filterName != excludedFilter)
-				return false;
-		}
-	}
-	return true;
+	return HasPassedIfExcludingFilter(FindFilterIndex(excludedFilter));
+}
+
+bool FilterResult::HasPassedIfExcludingFilter(FilterIndex excludedFilter) const {
+	ApplyDecisionEntries();
+	if (m_vetoes.none())
+		return true;
+	return (TestBit(m_vetoes, excludedFilter) && (m_vetoes.count() == 1));
+}
+
+bool FilterResult::HasFilter(FilterIndex filterIndex) const {
+	return TestBit(m_filters, filterIndex);
 }
 
 FilterResult::Decision FilterResult::GetFilterDecision(std::string filterName) const {
-	FilterResult::DecisionEntry const* entr = GetDecisionEntry(filterName);
+	FilterResult::FilterIndex filterIndex = FindFilterIndex(filterName);
 
-	if ( entr == nullptr ){
+	if ((filterIndex == UnknownFilter) || (! TestBit(m_filters, filterIndex))) {
 		LOG(FATAL) << "Decision entry with name " << filterName << " not found!";
 	}
-	return entr->filterDecision;
+	return GetFilterDecision(filterIndex);
+}
+
+FilterResult::Decision FilterResult::GetFilterDecision(FilterIndex filterIndex) const {
+	ApplyDecisionEntries();
+	if (! TestBit(m_decided, filterIndex))
+		return Decision::Undefined;
+	return (TestBit(m_passed, filterIndex) ? Decision::Passed : Decision::NotPassed);
 }
 
 FilterResult::FilterDecisions const& FilterResult::GetFilterDecisions() const {
+	if (! m_filterDecisionsValid) {
+		m_filterDecisions.clear();
+		for (FilterResult::FilterIndices::const_iterator it = m_filterIndices.begin(); it != m_filterIndices.end(); ++it) {
+			m_filterDecisions.push_back(DecisionEntry(GetFilterName(*it), GetFilterDecision(*it), GetTaggingMode(*it)));
+		}
+		m_filterDecisionsValid = true;
+	}
 	return m_filterDecisions;
 }
 
 void FilterResult::SetFilterDecision(std::string filterName, bool passed) {
-	FilterResult::Decision desc = passed ? FilterResult::Decision::Passed : FilterResult::Decision::NotPassed;
-	FilterResult::DecisionEntry * entr = GetDecisionEntry(filterName);
+	SetFilterDecision(GetFilterIndex(filterName), passed);
+}
 
-	if ( entr == nullptr ) {
-		m_filterDecisions.push_back( DecisionEntry(filterName, desc, IsTaggingFilter(filterName)));
-	} else {
-		entr->filterDecision = desc;
+void FilterResult::SetFilterDecision(FilterIndex filterIndex, bool passed) {
+	ApplyDecisionEntries();
+	if (! TestBit(m_filters, filterIndex)) {
+		AddFilterIndex(filterIndex);
 	}
-	
-	// recompute the cached filter result, if the new filter
-	// decision might change this
-	if (m_IsCachedHasPassed && ( m_cacheHasPassed != passed ))
-		m_IsCachedHasPassed = false;
+
+	SetBit(m_decided, filterIndex, true);
+	SetBit(m_passed, filterIndex, passed);
+	SetBit(m_vetoes, filterIndex, (! passed) && (! TestBit(m_taggingMode, filterIndex)));
+	m_filterDecisionsValid = false;
+	m_filterDecisionsWritable = false;
 }
 
 std::string FilterResult::ToString() const {
 	std::stringstream s;
 	s << "== Filter Decision == " << std::endl;
 
-	for (FilterResult::FilterDecisions::const_iterator it = m_filterDecisions.begin();
-			it != m_filterDecisions.end(); ++it) {
-		s << it->filterName << " : " << FilterResult::DecisionToString( it->filterDecision ) << std::endl;
+	for (FilterResult::FilterIndices::const_iterator it = m_filterIndices.begin();
+			it != m_filterIndices.end(); ++it) {
+		s << GetFilterName(*it) << " : " << FilterResult::DecisionToString( GetFilterDecision(*it) ) << std::endl;
 	}
 
 	return s.str();
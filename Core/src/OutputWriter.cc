@@ -0,0 +1,83 @@
+
+#include <RVersion.h>
+#include <TROOT.h>
+
+#include "Artus/Core/interface/OutputWriter.h"
+
+
+OutputWriter& OutputWriter::GetInstance()
+{
+	static OutputWriter writer;
+	return writer;
+}
+
+OutputWriter::~OutputWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_taskCondition.notify_one();
+
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+}
+
+void OutputWriter::Submit(Task task)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (! m_thread.joinable())
+	{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+		// the output is written while the pipelines process the next events
+		ROOT::EnableThreadSafety();
+#endif
+		m_thread = std::thread(&OutputWriter::WriterLoop, this);
+	}
+	m_tasks.push_back(std::move(task));
+	m_taskCondition.notify_one();
+}
+
+void OutputWriter::Flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]() { return (m_tasks.empty() && (! m_busy)); });
+}
+
+std::unique_lock<std::mutex> OutputWriter::LockOutput()
+{
+	return std::unique_lock<std::mutex>(m_outputMutex);
+}
+
+void OutputWriter::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_taskCondition.wait(lock, [this]() { return (m_stop || (! m_tasks.empty())); });
+		if (m_tasks.empty())
+		{
+			return;
+		}
+
+		Task task = std::move(m_tasks.front());
+		m_tasks.pop_front();
+		m_busy = true;
+		lock.unlock();
+
+		{
+			std::lock_guard<std::mutex> outputLock(m_outputMutex);
+			task();
+		}
+
+		lock.lock();
+		m_busy = false;
+		if (m_tasks.empty())
+		{
+			m_doneCondition.notify_all();
+		}
+	}
+}
+
@@ -5,3 +5,8 @@ ProcessNodeBase::~ProcessNodeBase()
 {
 }
 
+bool ProcessNodeBase::GetInputCollections(std::vector<std::string> & collectionNames) const
+{
+	return false;
+}
+
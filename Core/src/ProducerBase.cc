@@ -6,6 +6,11 @@ ProducerBaseUntemplated::~ProducerBaseUntemplated()
 {
 }
 
+bool ProducerBaseUntemplated::GetSettingDependencies(std::vector<std::string> & settingNames) const
+{
+	return false;
+}
+
 ProducerBaseAccess::ProducerBaseAccess(ProducerBaseUntemplated& cb) :
 		m_cb(cb)
 {
@@ -0,0 +1,98 @@
+
+#include <deque>
+#include <unordered_map>
+
+#include "Artus/Core/interface/QuantityCache.h"
+
+
+const size_t QuantityCache::UnknownQuantity = std::numeric_limits<size_t>::max();
+
+namespace
+{
+	// process wide mapping of quantity names to ids
+	struct QuantityNameRegistry
+	{
+		std::mutex mutex;
+		std::unordered_map<std::string, size_t> ids;
+		std::deque<std::string> names;
+	};
+
+	QuantityNameRegistry & GetQuantityNameRegistry()
+	{
+		static QuantityNameRegistry registry;
+		return registry;
+	}
+}
+
+size_t QuantityCache::GetQuantityId(std::string const& quantityName)
+{
+	QuantityNameRegistry & registry = GetQuantityNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	auto it = registry.ids.find(quantityName);
+	if (it != registry.ids.end())
+	{
+		return it->second;
+	}
+
+	size_t quantityId = registry.names.size();
+	registry.names.push_back(quantityName);
+	registry.ids[quantityName] = quantityId;
+	return quantityId;
+}
+
+size_t QuantityCache::FindQuantityId(std::string const& quantityName)
+{
+	QuantityNameRegistry & registry = GetQuantityNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	auto it = registry.ids.find(quantityName);
+	return ((it != registry.ids.end()) ? it->second : UnknownQuantity);
+}
+
+std::string QuantityCache::GetQuantityName(size_t quantityId)
+{
+	QuantityNameRegistry & registry = GetQuantityNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	if (quantityId >= registry.names.size())
+	{
+		LOG(FATAL) << "Quantity id " << quantityId << " is not registered!";
+	}
+	return registry.names[quantityId];
+}
+
+size_t QuantityCache::GetNumberOfQuantities()
+{
+	QuantityNameRegistry & registry = GetQuantityNameRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	return registry.names.size();
+}
+
+QuantityCache::~QuantityCache()
+{
+	Clear();
+}
+
+void QuantityCache::Init()
+{
+	Clear();
+	m_nSlots = GetNumberOfQuantities();
+	m_entries.reset(new std::atomic<EntryBase*>[m_nSlots]);
+	for (size_t quantityId = 0; quantityId < m_nSlots; ++quantityId)
+	{
+		m_entries[quantityId].store(nullptr);
+	}
+	m_generation = 0;
+}
+
+void QuantityCache::Clear()
+{
+	for (size_t quantityId = 0; quantityId < m_nSlots; ++quantityId)
+	{
+		delete m_entries[quantityId].load();
+	}
+	m_entries.reset();
+	m_nSlots = 0;
+}
+
@@ -0,0 +1,144 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Artus/Core/interface/RunTimeProfiler.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+const size_t RunTimeStatistics::NBins;
+
+void RunTimeStatistics::Add(unsigned long long nanoSeconds)
+{
+	++m_bins[GetBin(nanoSeconds)];
+	++m_count;
+	m_sum += nanoSeconds;
+	m_max = std::max(m_max, nanoSeconds);
+}
+
+void RunTimeStatistics::Merge(RunTimeStatistics const& other)
+{
+	for (size_t bin = 0; bin < NBins; ++bin)
+	{
+		m_bins[bin] += other.m_bins[bin];
+	}
+	m_count += other.m_count;
+	m_sum += other.m_sum;
+	m_max = std::max(m_max, other.m_max);
+}
+
+unsigned long long RunTimeStatistics::GetCount() const
+{
+	return m_count;
+}
+
+double RunTimeStatistics::GetMean() const
+{
+	return ((m_count > 0) ? (static_cast<double>(m_sum) / m_count / 1000.0) : 0.0);
+}
+
+double RunTimeStatistics::GetMax() const
+{
+	return (m_max / 1000.0);
+}
+
+double RunTimeStatistics::GetQuantile(double quantile) const
+{
+	if (m_count == 0)
+	{
+		return 0.0;
+	}
+
+	unsigned long long target = static_cast<unsigned long long>(std::ceil(quantile * m_count));
+	target = std::max(target, 1ull);
+
+	unsigned long long cumulative = 0;
+	for (size_t bin = 0; bin < NBins; ++bin)
+	{
+		cumulative += m_bins[bin];
+		if (cumulative >= target)
+		{
+			return (std::min(GetBinCentre(bin), static_cast<double>(m_max)) / 1000.0);
+		}
+	}
+	return GetMax();
+}
+
+// the two bits below the most significant bit select one of four bins per power of two
+size_t RunTimeStatistics::GetBin(unsigned long long nanoSeconds)
+{
+	if (nanoSeconds < 4)
+	{
+		return static_cast<size_t>(nanoSeconds);
+	}
+
+	int msb = std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(nanoSeconds);
+	size_t bin = 4 * (msb - 1) + ((nanoSeconds >> (msb - 2)) & 3);
+	return std::min(bin, NBins - 1);
+}
+
+double RunTimeStatistics::GetBinCentre(size_t bin)
+{
+	if (bin < 4)
+	{
+		return static_cast<double>(bin);
+	}
+
+	int msb = static_cast<int>(bin / 4) + 1;
+	double lowerEdge = std::ldexp(4.0 + (bin % 4), msb - 2);
+	double upperEdge = std::ldexp(5.0 + (bin % 4), msb - 2);
+	return std::sqrt(lowerEdge * upperEdge);
+}
+
+
+const size_t RunTimeProfiler::UnknownNode = std::numeric_limits<size_t>::max();
+
+void RunTimeProfiler::SetNodes(std::vector<std::string> const& nodeIds)
+{
+	m_nodeIds = nodeIds;
+	m_runTimes.assign(nodeIds.size(), DefaultValues::UndefinedInt);
+	m_statistics.assign(nodeIds.size(), RunTimeStatistics());
+	m_eventCounter = 0;
+	m_sampling = false;
+}
+
+void RunTimeProfiler::SetSamplingInterval(size_t samplingInterval)
+{
+	if (samplingInterval == 0)
+	{
+		LOG(FATAL) << "The sampling interval of the run time measurement must be at least 1!";
+	}
+	m_samplingInterval = samplingInterval;
+}
+
+size_t RunTimeProfiler::GetNumberOfNodes() const
+{
+	return m_nodeIds.size();
+}
+
+std::string const& RunTimeProfiler::GetNodeId(size_t node) const
+{
+	return m_nodeIds.at(node);
+}
+
+size_t RunTimeProfiler::FindNode(std::string const& nodeId) const
+{
+	auto it = std::find(m_nodeIds.begin(), m_nodeIds.end(), nodeId);
+	return ((it != m_nodeIds.end()) ? static_cast<size_t>(it - m_nodeIds.begin()) : UnknownNode);
+}
+
+void RunTimeProfiler::SetSharedProfiler(RunTimeProfiler const* sharedProfiler)
+{
+	m_sharedProfiler = sharedProfiler;
+}
+
+RunTimeProfiler const* RunTimeProfiler::GetSharedProfiler() const
+{
+	return m_sharedProfiler;
+}
+
+RunTimeStatistics const& RunTimeProfiler::GetStatistics(size_t node) const
+{
+	return m_statistics.at(node);
+}
@@ -0,0 +1,86 @@
+
+#include "Artus/Core/interface/TaskPool.h"
+
+
+TaskPool::TaskPool(size_t nThreads) :
+	m_nextTask(0)
+{
+	for (size_t threadIndex = 1; threadIndex < nThreads; ++threadIndex)
+	{
+		m_threads.push_back(std::thread(&TaskPool::WorkerLoop, this));
+	}
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_startCondition.notify_all();
+
+	for (std::vector<std::thread>::iterator thread = m_threads.begin(); thread != m_threads.end(); ++thread)
+	{
+		thread->join();
+	}
+}
+
+void TaskPool::Run(std::vector<Task> const& tasks)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks = &tasks;
+		m_nextTask.store(0);
+		m_activeWorkers = m_threads.size();
+		++m_generation;
+	}
+	m_startCondition.notify_all();
+
+	// the calling thread also works on the tasks
+	ProcessTasks();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]() { return (m_activeWorkers == 0); });
+	m_tasks = nullptr;
+}
+
+size_t TaskPool::GetNumberOfThreads() const
+{
+	return m_threads.size() + 1;
+}
+
+void TaskPool::WorkerLoop()
+{
+	unsigned long long generation = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startCondition.wait(lock, [this, generation]() { return (m_stop || (m_generation != generation)); });
+			if (m_stop)
+			{
+				return;
+			}
+			generation = m_generation;
+		}
+
+		ProcessTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_activeWorkers;
+			if (m_activeWorkers == 0)
+			{
+				m_doneCondition.notify_one();
+			}
+		}
+	}
+}
+
+void TaskPool::ProcessTasks()
+{
+	for (size_t taskIndex = m_nextTask++; taskIndex < m_tasks->size(); taskIndex = m_nextTask++)
+	{
+		(*m_tasks)[taskIndex]();
+	}
+}
@@ -40,7 +40,7 @@ private:
 	{
 		bool passAllCuts = true;
 		
-		for (auto cut : m_cuts)
+		for (auto const& cut : m_cuts)
 		{
 			passAllCuts = passAllCuts && cut.second.IsInRange(cut.first(event, product));
 			if (! passAllCuts) {
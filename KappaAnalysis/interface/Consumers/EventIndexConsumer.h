@@ -0,0 +1,46 @@
+
+#pragma once
+
+#include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/Utility/interface/EventIndex.h"
+
+
+/**
+   \brief Writes an index of all processed events.
+
+   The index maps (run, lumi, event) to the input file and the entry in its Events tree and is
+   written into the file configured by EventIndexFile. Single events can then be processed again
+   without reading the whole dataset (see ReplayEventIndex).
+*/
+class EventIndexConsumer: public ConsumerBase<KappaTypes>
+{
+
+public:
+
+	typedef typename KappaTypes::event_type event_type;
+	typedef typename KappaTypes::product_type product_type;
+	typedef typename KappaTypes::setting_type setting_type;
+
+	std::string GetConsumerId() const override;
+
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
+
+	void Init(setting_type const& settings) override;
+
+	void ProcessEvent(event_type const& event, product_type const& product,
+	                  setting_type const& settings, FilterResult& result) override;
+
+	bool IsMergeable() const override;
+	void Merge(ConsumerBase<KappaTypes> & other, setting_type const& settings) override;
+
+	void Finish(setting_type const& settings) override;
+
+private:
+	std::string m_outputFileName;
+	EventIndex m_eventIndex;
+
+	std::string m_inputFileName;
+	int m_inputFileIndex = -1;
+};
+
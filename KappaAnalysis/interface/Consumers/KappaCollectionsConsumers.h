@@ -4,6 +4,7 @@
 #include <TTree.h>
 
 #include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/Core/interface/OutputWriter.h"
 #include "Artus/Utility/interface/RootFileHelper.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
@@ -160,6 +161,7 @@ public:
 				}
 			}
 			
+			std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
 			m_tree->Fill();
 		}
 	}
@@ -172,6 +174,34 @@ public:
 		m_tree->Write(m_tree->GetName());
 	}
 
+	bool IsMergeable() const override
+	{
+		return true;
+	}
+
+	void Merge(ConsumerBase<KappaTypes> & other, setting_type const& settings) override
+	{
+		auto & specOther = static_cast<KappaCollectionsConsumerBase<TObject, TObjectMetaInfo> &>(other);
+		for (Long64_t entry = 0; entry < specOther.m_tree->GetEntries(); ++entry)
+		{
+			specOther.m_tree->GetEntry(entry);
+
+			m_currentObject = specOther.m_currentObject;
+			m_currentObjectMetaInfo = specOther.m_currentObjectMetaInfo;
+			m_currentGenParticle = specOther.m_currentGenParticle;
+			m_currentGenParticleMatched = specOther.m_currentGenParticleMatched;
+			m_currentGenParticleMatchedDeltaR = specOther.m_currentGenParticleMatchedDeltaR;
+			m_currentGenTau = specOther.m_currentGenTau;
+			m_currentGenTauMatched = specOther.m_currentGenTauMatched;
+			m_currentGenTauMatchedDeltaR = specOther.m_currentGenTauMatchedDeltaR;
+			m_currentGenTauJet = specOther.m_currentGenTauJet;
+			m_currentGenTauJetMatched = specOther.m_currentGenTauJetMatched;
+			m_currentGenTauJetMatchedDeltaR = specOther.m_currentGenTauJetMatchedDeltaR;
+
+			m_tree->Fill();
+		}
+	}
+
 
 private:
 	std::string m_treeName;
@@ -12,5 +12,12 @@ class KappaCutFlowTreeConsumer: public CutFlowTreeConsumer<KappaTypes> {
 
 public:
 	
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
 	void Init(KappaSettings const& settings) override;
+
+	// no additional branches are filled
+	bool IsMergeable() const override
+	{
+		return true;
+	}
 };
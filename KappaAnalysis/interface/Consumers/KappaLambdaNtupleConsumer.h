@@ -23,48 +23,54 @@ public:
 		return "KappaLambdaNtupleConsumer";
 	}
 
+	// no additional branches are filled
+	bool IsMergeable() const override
+	{
+		return LambdaNtupleConsumer<TTypes>::IsOutputMergeable();
+	}
+
 	void Init(setting_type const& settings) override
 	{
 		// add possible quantities for the lambda ntuples consumers
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("input", [](event_type const& event, product_type const& product)
 		{
 			return static_cast<int>(event.m_input);
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddUInt64Quantity("run", [](event_type const& event, product_type const& product) -> uint64_t
 		{
 			return event.m_eventInfo->nRun;
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddUInt64Quantity("lumi", [](event_type const& event, product_type const& product) -> uint64_t
 		{
 			return event.m_eventInfo->nLumi;
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddUInt64Quantity("event", [](event_type const& event, product_type const& product) -> uint64_t
 		{
 			return event.m_eventInfo->nEvent;
-		});		
+		}, QuantityScope::Event);		
 		LambdaNtupleConsumer<TTypes>::AddUInt64Quantity("nbx", [](event_type const& event, product_type const& product) -> uint64_t
 		{
 			return event.m_eventInfo->nBX;
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("npv", [](event_type const& event, product_type const& product)
 		{
 			return event.m_vertexSummary->nVertices;
-		});
+		}, QuantityScope::Event);
 
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("firstPV_X", [](event_type const& event, product_type const& product)
 		{
 			return event.m_vertexSummary->pv.position.X();
-		});
+		}, QuantityScope::Event);
 
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("firstPV_Y", [](event_type const& event, product_type const& product)
 		{
 			return event.m_vertexSummary->pv.position.Y();
-		});
+		}, QuantityScope::Event);
 
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("firstPV_Z", [](event_type const& event, product_type const& product)
 		{
 			return event.m_vertexSummary->pv.position.Z();
-		});
+		}, QuantityScope::Event);
 
 		bool bInpData = settings.GetInputIsData();
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("npuMean", [bInpData](event_type const& event, product_type const& product)
@@ -72,39 +78,39 @@ public:
 			if (bInpData)
 				return DefaultValues::UndefinedFloat;
 			return static_cast<KGenEventInfo*>(event.m_eventInfo)->nPUMean;
-		});
+		}, QuantityScope::Event);
 
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("npu", [bInpData](event_type const& event, product_type const& product)
 		{
 			if (bInpData)
 				return DefaultValues::UndefinedInt;
 			return static_cast<int>(static_cast<KGenEventInfo*>(event.m_eventInfo)->nPU);
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("x1", [bInpData](event_type const& event, product_type const& product)
 		{
 			return (bInpData) ? DefaultValues::UndefinedFloat : float(static_cast<KGenEventInfo*>(event.m_eventInfo)->x1);
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("x2", [bInpData](event_type const& event, product_type const& product)
 		{
 			return (bInpData) ? DefaultValues::UndefinedFloat : float(static_cast<KGenEventInfo*>(event.m_eventInfo)->x2);
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("qScale", [bInpData](event_type const& event, product_type const& product)
 		{
 			return (bInpData) ? DefaultValues::UndefinedFloat : float(static_cast<KGenEventInfo*>(event.m_eventInfo)->qScale);
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("rho", [](event_type const& event, product_type const& product) {
 			return event.m_pileupDensity->rho;
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("PFMet", [](event_type const& event, product_type const& product) {
 			return event.m_met->p4.Pt();
-		});
+		}, QuantityScope::Event);
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("genNPartons", [](event_type const& event, product_type const& product) {
 			return product.m_genNPartons;
 		});
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("NPFCandidates", [](event_type const& event, product_type const& product)
 		{
 			return event.m_packedPFCandidates->size();
-		});
+		}, QuantityScope::Event);
 
 		// loop over all quantities containing "weight" (case-insensitive)
 		// and try to find them in the weights map to write them out
@@ -124,11 +130,12 @@ public:
 			   (LambdaNtupleConsumer<TTypes>::GetFloatQuantities().count(quantity) == 0))
 			{
 				LOG(DEBUG) << "\tQuantity \"" << quantity << "\" is tried to be taken from product.fres (FilterResult).";
-				LambdaNtupleConsumer<TTypes>::AddIntQuantity( quantity, [quantity](event_type const & event, product_type const & product)
+				FilterResult::FilterIndex filterIndex = FilterResult::GetFilterIndex(quantity);
+				LambdaNtupleConsumer<TTypes>::AddIntQuantity( quantity, [filterIndex](event_type const & event, product_type const & product)
 				{
-					if (product.fres.GetDecisionEntry(quantity) != nullptr)
+					if (product.fres.HasFilter(filterIndex))
 					{
-						return (product.fres.GetDecisionEntry(quantity)->filterDecision == FilterResult::Decision::Passed) ? 1 : 0;
+						return (product.fres.GetFilterDecision(filterIndex) == FilterResult::Decision::Passed) ? 1 : 0;
 					}
 					return -1;
 				} );
@@ -0,0 +1,66 @@
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/KappaAnalysis/interface/KappaTypes.h"
+
+
+/**
+   \brief Writes the events passing the pipeline into a Kappa skim.
+
+   The selected entries of the Events tree and the complete Lumis and Runs trees of all processed
+   input files (with the tree names of the FileInterface2 of the event provider) are copied with all their branches into the file configured by SkimOutputFile, such
+   that the skim can be read by the KappaEventProvider like the original input. The entries are
+   copied by the OutputWriter after the processing of each input file. Files, of which all entries
+   are selected, and the metadata trees are copied without decompressing their baskets.
+*/
+class KappaSkimConsumer: public ConsumerBase<KappaTypes>
+{
+
+public:
+
+	typedef typename KappaTypes::event_type event_type;
+	typedef typename KappaTypes::product_type product_type;
+	typedef typename KappaTypes::setting_type setting_type;
+
+	std::string GetConsumerId() const override;
+
+	/// the input is copied from the files, no collection has to be read
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
+
+	void Init(setting_type const& settings) override;
+
+	void ProcessEvent(event_type const& event, product_type const& product,
+	                  setting_type const& settings, FilterResult& result) override;
+
+	void Finish(setting_type const& settings) override;
+
+private:
+
+	/// hand the selected entries of the current input file to the OutputWriter
+	void SubmitInputFile();
+
+	/// executed by the OutputWriter
+	void CopyInputFile(std::string const& inputFileName, std::string const& eventsTreeName,
+	                   std::vector<std::string> const& metadataTreeNames, std::vector<long long> const& entries);
+	void CopyTree(TTree* inputTree, std::vector<long long> const& entries, bool allEntries);
+
+	std::string m_outputFileName;
+	std::string m_inputFileName;
+	std::string m_eventsTreeName;
+	std::vector<std::string> m_metadataTreeNames;
+	std::vector<long long> m_selectedEntries;
+
+	// only accessed by the OutputWriter
+	std::unique_ptr<TFile> m_outputFile;
+	std::map<std::string, TTree*> m_outputTrees;
+};
+
@@ -10,6 +10,7 @@ class HCALNoiseFilter: public FilterBase<KappaTypes>
 {
 public:
 	std::string GetFilterId() const override;
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
 	void Init(setting_type const& settings) override;
 	bool DoesEventPass(KappaEvent const& event, KappaProduct const& product,
 	                           KappaSettings const& settings) const override;
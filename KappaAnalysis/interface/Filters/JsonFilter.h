@@ -21,6 +21,8 @@ public:
 
 	std::string GetFilterId() const override;
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
+
 	void Init(KappaSettings const& settings) override;
 	bool DoesEventPass(KappaEvent const& event, KappaProduct const& product,
 	                           KappaSettings const& settings) const override;
@@ -3,11 +3,11 @@
 #include <limits>
 
 #include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
 
 #include "Artus/Filter/interface/CutFilterBase.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerNameMatcher.h"
 
 
 /** Abstract Lepton Pt Filter
@@ -30,15 +30,16 @@ protected:
 	void Initialise(std::vector<std::string> const& leptonLowerPtCutsVector) {
 		std::map<std::string, std::vector<std::string> > leptonLowerPtCuts = Utility::ParseVectorToMap(leptonLowerPtCutsVector);
 	
-		std::vector<int> defaultIndices = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+		const size_t nDefaultLeptons = 21;
 		for (std::map<std::string, std::vector<std::string> >::const_iterator leptonLowerPtCut = leptonLowerPtCuts.begin();
 		     leptonLowerPtCut != leptonLowerPtCuts.end(); ++leptonLowerPtCut)
 		{
 			std::vector<int> indices;
 			std::vector<std::string> hltNames;
+			bool defaultLeptons = false;
 			if (leptonLowerPtCut->first == "default") {
-				indices = defaultIndices;
-				LOG(WARNING) << "No lepton index for the Filter \"" << this->GetFilterId() << "\" specified. Check the possible " << defaultIndices.size() << " hardest leptons.";
+				defaultLeptons = true;
+				LOG(WARNING) << "No lepton index for the Filter \"" << this->GetFilterId() << "\" specified. Check the possible " << nDefaultLeptons << " hardest leptons.";
 			}
 			else {
 				try {
@@ -54,6 +55,17 @@ protected:
 			{
 				double ptCutValue = std::stod(*ptCut);
 				
+				// the cut has to be passed by all of the hardest leptons, which is decided by the lowest pt of them
+				if (defaultLeptons)
+				{
+					this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
+							[this, nDefaultLeptons](KappaEvent const& event, KappaProduct const& product) -> double {
+								return KappaProduct::GetLowestPt((product.*m_validLeptonsMember), nDefaultLeptons, 0.99*std::numeric_limits<double>::max());
+							},
+							CutRange::LowerThresholdCut(ptCutValue)
+					));
+				}
+				
 				for (std::vector<int>::iterator index = indices.begin(); index != indices.end(); ++index)
 				{
 					size_t tmpIndex(*index); // TODO
@@ -69,24 +81,15 @@ protected:
 				
 				for (std::vector<std::string>::iterator hltName = hltNames.begin(); hltName != hltNames.end(); ++hltName)
 				{
-					std::string tmpHltName(*hltName); // TODO
-					boost::regex pattern(tmpHltName, boost::regex::icase | boost::regex::extended);
-					for (std::vector<int>::iterator index = defaultIndices.begin(); index != defaultIndices.end(); ++index)
-					{
-						size_t tmpIndex(*index);
-						this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
-								[this, tmpHltName, pattern, tmpIndex](KappaEvent const& event, KappaProduct const& product) -> double {
-									bool hasMatch = false;
-									for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-										hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), pattern);
-
-									return (((product.*m_validLeptonsMember).size() > tmpIndex && hasMatch) ?
-									        (product.*m_validLeptonsMember).at(tmpIndex)->p4.Pt() :
-									        0.99*std::numeric_limits<double>::max());
-								},
-								CutRange::LowerThresholdCut(ptCutValue)
-						));
-					}
+					size_t hltPattern = m_hltNameMatcher.AddPattern(*hltName);
+					this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
+							[this, hltPattern, nDefaultLeptons](KappaEvent const& event, KappaProduct const& product) -> double {
+								return (m_hltNameMatcher.MatchesAny(hltPattern, product.m_selectedHltNames) ?
+								        KappaProduct::GetLowestPt((product.*m_validLeptonsMember), nDefaultLeptons, 0.99*std::numeric_limits<double>::max()) :
+								        0.99*std::numeric_limits<double>::max());
+							},
+							CutRange::LowerThresholdCut(ptCutValue)
+					));
 				}
 			}
 		}	
@@ -95,6 +98,7 @@ protected:
 
 private:
 	std::vector<TLepton*> KappaProduct::*m_validLeptonsMember;
+	TriggerNameMatcher m_hltNameMatcher;
 };
 
 
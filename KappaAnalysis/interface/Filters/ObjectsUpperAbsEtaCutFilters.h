@@ -4,11 +4,11 @@
 #include <limits>
 
 #include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
 
 #include "Artus/Filter/interface/CutFilterBase.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerNameMatcher.h"
 
 
 /** Abstract Lepton Eta Filter
@@ -31,15 +31,16 @@ protected:
 	void Initialise(std::vector<std::string> const& leptonUpperAbsEtaCutsVector) {
 		std::map<std::string, std::vector<std::string> > leptonUpperAbsEtaCuts = Utility::ParseVectorToMap(leptonUpperAbsEtaCutsVector);
 	
-		std::vector<int> defaultIndices = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+		const size_t nDefaultLeptons = 21;
 		for (std::map<std::string, std::vector<std::string> >::const_iterator leptonUpperAbsEtaCut = leptonUpperAbsEtaCuts.begin();
 		     leptonUpperAbsEtaCut != leptonUpperAbsEtaCuts.end(); ++leptonUpperAbsEtaCut)
 		{
 			std::vector<int> indices;
 			std::vector<std::string> hltNames;
+			bool defaultLeptons = false;
 			if (leptonUpperAbsEtaCut->first == "default") {
-				indices = defaultIndices;
-				LOG(WARNING) << "No lepton index for the Filter \"" << this->GetFilterId() << "\" specified. Check the possible " << defaultIndices.size() << " hardest leptons.";
+				defaultLeptons = true;
+				LOG(WARNING) << "No lepton index for the Filter \"" << this->GetFilterId() << "\" specified. Check the possible " << nDefaultLeptons << " hardest leptons.";
 			}
 			else {
 				try {
@@ -55,6 +56,17 @@ protected:
 			{
 				double absEtaCutValue = std::stod(*absEtaCut);
 				
+				// the cut has to be passed by all of the hardest leptons, which is decided by the highest |eta| of them
+				if (defaultLeptons)
+				{
+					this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
+							[this, nDefaultLeptons](KappaEvent const& event, KappaProduct const& product) -> double {
+								return KappaProduct::GetHighestAbsEta((product.*m_validLeptonsMember), nDefaultLeptons, -1.0);
+							},
+							CutRange::UpperThresholdCut(absEtaCutValue)
+					));
+				}
+				
 				for (std::vector<int>::iterator index = indices.begin(); index != indices.end(); ++index)
 				{
 					size_t tmpIndex(*index); // TODO
@@ -70,24 +82,15 @@ protected:
 				
 				for (std::vector<std::string>::iterator hltName = hltNames.begin(); hltName != hltNames.end(); ++hltName)
 				{
-					std::string tmpHltName(*hltName); // TODO
-					boost::regex pattern(tmpHltName, boost::regex::icase | boost::regex::extended);
-					for (std::vector<int>::iterator index = defaultIndices.begin(); index != defaultIndices.end(); ++index)
-					{
-						size_t tmpIndex(*index);
-						this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
-								[this, tmpHltName, pattern, tmpIndex](KappaEvent const& event, KappaProduct const& product) -> double {
-									bool hasMatch = false;
-									for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-										hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), pattern);
-
-									return (((product.*m_validLeptonsMember).size() > tmpIndex && hasMatch) ?
-									        std::abs((product.*m_validLeptonsMember).at(tmpIndex)->p4.Eta()) :
-									        -1.0);
-								},
-								CutRange::UpperThresholdCut(absEtaCutValue)
-						));
-					}
+					size_t hltPattern = m_hltNameMatcher.AddPattern(*hltName);
+					this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
+							[this, hltPattern, nDefaultLeptons](KappaEvent const& event, KappaProduct const& product) -> double {
+								return (m_hltNameMatcher.MatchesAny(hltPattern, product.m_selectedHltNames) ?
+								        KappaProduct::GetHighestAbsEta((product.*m_validLeptonsMember), nDefaultLeptons, -1.0) :
+								        -1.0);
+							},
+							CutRange::UpperThresholdCut(absEtaCutValue)
+					));
 				}
 			}
 		}	
@@ -96,6 +99,7 @@ protected:
 
 private:
 	std::vector<TLepton*> KappaProduct::*m_validLeptonsMember;
+	TriggerNameMatcher m_hltNameMatcher;
 };
 
 
@@ -6,6 +6,7 @@
 
 #include "Artus/Core/interface/FilterBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/Utility/interface/RunLumiEventSet.h"
 
 
 /** Filter events by white/black lists for run/lumi/event numbers
@@ -17,6 +18,9 @@
  *   - EventWhitelist
  *   - EventBlacklist
  *   - MatchRunLumiEventTuples (optional)
+ *
+ *  The lists are converted in Init into hash sets of (run, lumi, event) tuples
+ *  or into sorted sets of intervals, such that long lists can be used.
  */
 class RunLumiEventFilter: public FilterBase<KappaTypes>
 {
@@ -25,12 +29,26 @@ public:
 
 
 	std::string GetFilterId() const override;
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
 
+	void Init(KappaSettings const& settings) override;
 	bool DoesEventPass(KappaEvent const& event, KappaProduct const& product,
 	                           KappaSettings const& settings) const override;
 
 
 private:
 	
-	bool MatchWhiteBlackLists(uint64_t item, std::vector<uint64_t> const& whitelist, std::vector<uint64_t> const& blacklist) const;
+	bool MatchWhiteBlackLists(uint64_t item, IntervalSet const& whitelist, IntervalSet const& blacklist) const;
+
+	bool m_matchTuples = false;
+
+	RunLumiEventSet m_tupleWhitelist;
+	RunLumiEventSet m_tupleBlacklist;
+
+	IntervalSet m_runWhitelist;
+	IntervalSet m_runBlacklist;
+	IntervalSet m_lumiWhitelist;
+	IntervalSet m_lumiBlacklist;
+	IntervalSet m_eventWhitelist;
+	IntervalSet m_eventBlacklist;
 };
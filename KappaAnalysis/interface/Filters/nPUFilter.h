@@ -25,6 +25,7 @@ public:
 
 
 	std::string GetFilterId() const override;
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
 
 	bool DoesEventPass(KappaEvent const& event, KappaProduct const& product,
 	                           KappaSettings const& settings) const override;
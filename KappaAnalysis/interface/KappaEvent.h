@@ -19,6 +19,15 @@ public:
 
 	long m_input = 0;
 
+	/// file and entry in the tree of this file, from which the event has been read
+	std::string m_inputFileName;
+	long long m_inputEntry = -1;
+
+	/// names of the event and metadata trees of the input files (see FileInterface2)
+	std::string m_eventsTreeName = "Events";
+	std::string m_lumisTreeName = "Lumis";
+	std::string m_runsTreeName = "Runs";
+
 	/// pointer to electron collection
 	KElectrons* m_electrons = nullptr;
 	KElectronMetadata* m_electronMetadata = nullptr;
@@ -152,6 +152,36 @@ public:
 		if (! settings.GetJetMetadata().empty())
 			this->m_event.m_jetMetadata = this->template SecureFileInterfaceGetMeta<KJetMetadata>(settings.GetJetMetadata());
 
+		// the event metadata is always read
+		this->m_collectionBranches = {
+			{ "Electrons", settings.GetElectrons() },
+			{ "Muons", settings.GetMuons() },
+			{ "Taus", settings.GetTaus() },
+			{ "GenTaus", settings.GetGenTaus() },
+			{ "GenTauJets", settings.GetGenTauJets() },
+			{ "BasicJets", settings.GetBasicJets() },
+			{ "GenJets", settings.GetGenJets() },
+			{ "TaggedJets", settings.GetTaggedJets() },
+			{ "PileupDensity", settings.GetPileupDensity() },
+			{ "Met", settings.GetMet() },
+			{ "PuppiMet", settings.GetPuppiMet() },
+			{ "GenMet", settings.GetGenMet() },
+			{ "PFChargedHadronsPileUp", settings.GetPFChargedHadronsPileUp() },
+			{ "PFChargedHadronsNoPileUp", settings.GetPFChargedHadronsNoPileUp() },
+			{ "PFNeutralHadronsNoPileUp", settings.GetPFNeutralHadronsNoPileUp() },
+			{ "PFPhotonsNoPileUp", settings.GetPFPhotonsNoPileUp() },
+			{ "PFAllChargedParticlesNoPileUp", settings.GetPFAllChargedParticlesNoPileUp() },
+			{ "PFAllChargedParticlesPileUp", settings.GetPFAllChargedParticlesPileUp() },
+			{ "PackedPFCandidates", settings.GetPackedPFCandidates() },
+			{ "TriggerObjects", settings.GetTriggerObjects() },
+			{ "GenParticles", settings.GetGenParticles() },
+			{ "LheParticles", settings.GetLheParticles() },
+			{ "BeamSpot", settings.GetBeamSpot() },
+			{ "VertexSummary", settings.GetVertexSummary() },
+			{ "TrackSummary", settings.GetTrackSummary() },
+			{ "HCALNoiseSummary", settings.GetHCALNoiseSummary() }
+		};
+
 		KappaEventProviderBase<TTypes>::WireEvent(settings);
 	}
 
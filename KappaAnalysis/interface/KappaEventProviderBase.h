@@ -1,14 +1,27 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
-#include <future>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include <RVersion.h>
+#include <TBranch.h>
+#include <TObjArray.h>
+#include <TROOT.h>
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 #include "Kappa/DataFormats/interface/KDebug.h"
 
 #include "Artus/Core/interface/PipelineRunner.h"
+#include "Artus/Utility/interface/EventIndex.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
 #include "KappaTools/RootTools/interface/FileInterface2.h"
 #include "KappaTools/Toolbox/interface/ProgressMonitor.h"
 
@@ -18,6 +31,14 @@
    Defines the basic functionality expected by PipelineRunner. EventProviderBase::WireEvent is a
    purely virtual function that needs to be implemented by any derived class. This function needs
    to be called after the derived EventProvider is instantiated in the main executable.
+
+   All accesses to the input trees are done by one persistent I/O thread. With ReadAheadEntries > 0,
+   this thread reads and decompresses the baskets of the whole TTree cluster containing the entry
+   ReadAheadEntries entries ahead, as soon as the read entries approach this cluster, while the
+   pipelines process the current entry. The objects themselves are still filled by GetEntry, since
+   the branches of the FileInterface2 are bound to the objects wired into the event.
+   With ReadInClusters, the events are processed in batches of one TTree cluster each, the baskets
+   of a whole cluster are loaded at once before its first event.
 */
 
 
@@ -29,10 +50,16 @@ public:
 
 	KappaEventProviderBase(FileInterface2 & fi, InputTypeEnum inpType, bool batchMode=false) :
 			EventProviderBase<TTypes>(),
-			m_prevRun(-1), m_prevLumi(-1), m_prevTree(-1), m_inpType(inpType), m_fi(fi), m_batchMode(batchMode), m_mon(nullptr)
+			m_prevRun(-1), m_prevLumi(-1), m_prevTree(-1), m_inpType(inpType), m_fi(fi), m_batchMode(batchMode), m_mon(nullptr),
+			m_readAheadEntries(0), m_readInClusters(false),
+			m_ioRequest(IORequest::None), m_ioEntry(-1), m_ioEndEntry(-1), m_ioResult(0), m_ioTreeNumber(-1), m_ioDone(false)
 	{
 		m_fi.SpeedupTree(128*1024*1024); // in units of bytes
 
+		this->m_event.m_eventsTreeName = m_fi.eventdata.GetName();
+		this->m_event.m_lumisTreeName = m_fi.lumidata.GetName();
+		this->m_event.m_runsTreeName = m_fi.rundata.GetName();
+
 		// auto-delete objects when moving to a new object. Not default root behaviour
 		// RF: Deactivated since it caused trouble when running on multiple files
 		//m_fi.eventdata.SetAutoDelete(true);
@@ -40,10 +67,78 @@ public:
 		m_mon.reset(new ProgressMonitor(GetEntries()));
 	}
 
+	virtual ~KappaEventProviderBase()
+	{
+		if (m_ioThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_ioMutex);
+				m_ioRequest = IORequest::Stop;
+			}
+			m_ioRequestCondition.notify_one();
+			m_ioThread.join();
+		}
+	}
+
 	/// overwrite and load the Kappa products into your event structure call yourself after 
 	/// creating the provider
 	virtual void WireEvent(setting_type const& settings)
 	{
+		m_readAheadEntries = static_cast<size_t>(std::max(settings.GetReadAheadEntries(), 0));
+		m_readInClusters = settings.GetReadInClusters();
+
+		if (! settings.GetReplayEventIndex().empty())
+		{
+			SetupReplay(settings.GetReplayEventIndex(), settings.GetReplayEvents());
+		}
+	}
+
+	long long GetBatchEnd(long long lEvent) override {
+		if (! m_readInClusters)
+		{
+			return EventProviderBase<TTypes>::GetBatchEnd(lEvent);
+		}
+		return RunIORequest(IORequest::GetClusterEnd, lEvent, -1, "Timeout: Could not read cluster range from Events tree!");
+	}
+
+	bool LoadBatch(long long lFirstEvent, long long lEndEvent) override {
+		if (m_readInClusters)
+		{
+			RunIORequest(IORequest::LoadBaskets, lFirstEvent, lEndEvent, "Timeout: Could not read cluster from Events tree!");
+		}
+		return true;
+	}
+
+	/// disable the branches of the collections in m_collectionBranches, which are not required
+	void SetRequiredInputCollections(std::vector<std::string> const& collectionNames) override {
+		std::vector<std::string> prunedCollections;
+		for (std::map<std::string, std::string>::const_iterator collection = m_collectionBranches.begin();
+		     collection != m_collectionBranches.end(); ++collection)
+		{
+			if (collection->second.empty() ||
+			    (std::find(collectionNames.begin(), collectionNames.end(), collection->first) != collectionNames.end()))
+			{
+				continue;
+			}
+
+			TBranch* branch = m_fi.eventdata.GetBranch(collection->second.c_str());
+			if (branch == nullptr)
+			{
+				continue;
+			}
+			m_fi.eventdata.SetBranchStatus(collection->second.c_str(), false);
+			if (branch->GetListOfBranches()->GetEntriesFast() > 0)
+			{
+				m_fi.eventdata.SetBranchStatus((collection->second + ".*").c_str(), false);
+			}
+			prunedCollections.push_back(collection->first + " (" + collection->second + ")");
+		}
+
+		if (! prunedCollections.empty())
+		{
+			LOG(INFO) << "Not reading the input collections, which are not used by any node: "
+			          << boost::algorithm::join(prunedCollections, ", ");
+		}
 	}
 
 	bool GetEntry(long long lEvent) override {
@@ -53,26 +148,27 @@ public:
 		if (!m_mon->Update())
 			return false;
 		
-		// lood entries asynchronously and exit the program, if looding the entry takes unreasonably long (dCache, ...)
-		TTree* eventdata = &(m_fi.eventdata);
-		std::future<long> futureGetEntry = std::async(std::launch::async, [eventdata, lEvent] () -> long
+		if (m_replay)
 		{
-			return eventdata->GetEntry(lEvent);
-		});
-		std::chrono::minutes timeout(5);
-		if (futureGetEntry.wait_for(timeout) != std::future_status::ready)
-		{
-			LOG(FATAL) << "Timeout: Could not read entry from Events tree!";
+			if ((lEvent < 0) || (lEvent >= static_cast<long long>(m_replayEntries.size())))
+			{
+				return false;
+			}
+			lEvent = m_replayEntries[lEvent];
 		}
-		long resultGetEntry = futureGetEntry.get();
-		
-		m_event.m_input = m_fi.eventdata.GetTreeNumber();
 
-		if (m_prevTree != m_fi.eventdata.GetTreeNumber())
+		// the entry is read by the I/O thread, exit the program, if reading the entry takes unreasonably long (dCache, ...)
+		long resultGetEntry = RunIORequest(IORequest::GetEntry, lEvent, -1, "Timeout: Could not read entry from Events tree!");
+
+		m_event.m_input = m_ioTreeNumber;
+		m_event.m_inputEntry = m_ioLocalEntry;
+
+		if (m_prevTree != m_ioTreeNumber)
 		{
-			m_prevTree = m_fi.eventdata.GetTreeNumber();
+			m_prevTree = m_ioTreeNumber;
 			m_prevLumi = -1;
-			LOG(INFO) << "\nProcessing " << m_fi.eventdata.GetFile()->GetName() << " ...";
+			m_event.m_inputFileName = m_ioFileName;
+			LOG(INFO) << "\nProcessing " << m_ioFileName << " ...";
 		}
 
 		if (  m_prevRun != m_event.m_eventInfo->nRun ) {
@@ -86,17 +182,8 @@ public:
 		if ( m_prevLumi != m_event.m_eventInfo->nLumi ) {
 			m_prevLumi = m_event.m_eventInfo->nLumi;
 			
-			// lood entries asynchronously and exit the program, if looding the entry takes unreasonably long (dCache, ...)
-			FileInterface2* fi = &m_fi;
-			std::future<void> futureGetMetaEntry = std::async(std::launch::async, [fi] ()
-			{
-				fi->GetMetaEntry();
-			});
-			if (futureGetMetaEntry.wait_for(timeout) != std::future_status::ready)
-			{
-				LOG(FATAL) << "Timeout: Could not read entry from Lumis tree!";
-			}
-			
+			RunIORequest(IORequest::GetMetaEntry, -1, -1, "Timeout: Could not read entry from Lumis tree!");
+
 			m_newLumisection = true;
 		}
 		else
@@ -113,6 +200,10 @@ public:
 	virtual bool NewRun() const override { return m_newRun; }
 
 	long long GetEntries() const override {
+		if (m_replay)
+		{
+			return static_cast<long long>(m_replayEntries.size());
+		}
 		return (m_batchMode ? m_fi.eventdata.GetEntriesFast() : m_fi.eventdata.GetEntries());
 	}
 
@@ -127,6 +218,10 @@ protected:
 
 	FileInterface2& m_fi;
 	bool m_batchMode;
+
+	/// branches of the event collections, which may be disabled if no node reads them,
+	/// keyed by the names of their settings (see ProcessNodeBase::GetInputCollections)
+	std::map<std::string, std::string> m_collectionBranches;
 	boost::scoped_ptr<ProgressMonitor> m_mon;
 
 	template<typename T>
@@ -158,5 +253,207 @@ protected:
 		}
 		return result;
 	}
+
+private:
+	/// process only the given events, whose entries are looked up in the event index
+	void SetupReplay(std::string const& eventIndexFileName, std::vector<std::string> const& eventIds)
+	{
+		EventIndex eventIndex;
+		if (! eventIndex.Read(eventIndexFileName))
+		{
+			LOG(FATAL) << "Cannot read event index \"" << eventIndexFileName << "\"!";
+		}
+
+		// tree numbers of the input files, the offsets of the trees are known after GetEntries
+		std::map<std::string, int> treeNumbers;
+		TObjArray* inputFiles = m_fi.eventdata.GetListOfFiles();
+		for (int inputFile = 0; inputFile < inputFiles->GetEntriesFast(); ++inputFile)
+		{
+			treeNumbers[inputFiles->At(inputFile)->GetTitle()] = inputFile;
+		}
+		m_fi.eventdata.GetEntries();
+		Long64_t* treeOffsets = m_fi.eventdata.GetTreeOffset();
+
+		m_replayEntries.clear();
+		for (std::vector<std::string>::const_iterator eventId = eventIds.begin(); eventId != eventIds.end(); ++eventId)
+		{
+			unsigned int run = 0;
+			unsigned int lumi = 0;
+			unsigned long long event = 0;
+			if (! EventIndex::ParseEvent(*eventId, run, lumi, event))
+			{
+				LOG(FATAL) << "Cannot parse event \"" << *eventId << "\"! Use \"run:lumi:event\".";
+			}
+
+			EventIndex::Entry const* indexEntry = eventIndex.Find(run, lumi, event);
+			if (indexEntry == nullptr)
+			{
+				LOG(WARNING) << "Event " << *eventId << " is not contained in the event index \"" << eventIndexFileName << "\".";
+				continue;
+			}
+
+			std::string const& fileName = eventIndex.GetFiles()[indexEntry->file];
+			std::map<std::string, int>::const_iterator treeNumber = treeNumbers.find(fileName);
+			if (treeNumber == treeNumbers.end())
+			{
+				LOG(WARNING) << "Event " << *eventId << " is contained in \"" << fileName << "\", which is not an input file.";
+				continue;
+			}
+			m_replayEntries.push_back(treeOffsets[treeNumber->second] + indexEntry->entry);
+		}
+
+		// reading ahead is useless for single events
+		m_replay = true;
+		m_readAheadEntries = 0;
+		m_readInClusters = false;
+		m_mon.reset(new ProgressMonitor(GetEntries()));
+		LOG(INFO) << "Replaying " << m_replayEntries.size() << " of " << eventIds.size() << " requested events.";
+	}
+
+	enum class IORequest : int
+	{
+		None = 0,
+		GetEntry = 1,
+		GetMetaEntry = 2,
+		GetClusterEnd = 3,
+		LoadBaskets = 4,
+		Stop = 5
+	};
+
+	/// hand a request to the I/O thread and wait for its result
+	long long RunIORequest(IORequest request, long long entry, long long endEntry, std::string const& timeoutMessage)
+	{
+		if (! m_ioThread.joinable())
+		{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+			if (m_readAheadEntries > 0)
+			{
+				// the input is read while the pipelines write their output
+				ROOT::EnableThreadSafety();
+			}
+#endif
+			m_ioThread = std::thread(&KappaEventProviderBase<TTypes>::ProcessIORequests, this);
+		}
+
+		std::unique_lock<std::mutex> lock(m_ioMutex);
+		m_ioRequest = request;
+		m_ioEntry = entry;
+		m_ioEndEntry = endEntry;
+		m_ioDone = false;
+		m_ioRequestCondition.notify_one();
+
+		if (! m_ioDoneCondition.wait_for(lock, std::chrono::minutes(5), [this] () { return m_ioDone; }))
+		{
+			LOG(FATAL) << timeoutMessage;
+		}
+		return m_ioResult;
+	}
+
+	void ProcessIORequests()
+	{
+		std::unique_lock<std::mutex> lock(m_ioMutex);
+		while (true)
+		{
+			m_ioRequestCondition.wait(lock, [this] () { return (m_ioRequest != IORequest::None); });
+			IORequest request = m_ioRequest;
+			m_ioRequest = IORequest::None;
+			if (request == IORequest::Stop)
+			{
+				return;
+			}
+
+			if (request == IORequest::GetEntry)
+			{
+				m_ioResult = m_fi.eventdata.GetEntry(m_ioEntry);
+				m_ioTreeNumber = m_fi.eventdata.GetTreeNumber();
+				m_ioLocalEntry = ((m_fi.eventdata.GetTree() != nullptr) ? m_fi.eventdata.GetTree()->GetReadEntry() : -1);
+				if (m_ioTreeNumber != m_prevIOTreeNumber)
+				{
+					m_prevIOTreeNumber = m_ioTreeNumber;
+					m_ioFileName = m_fi.eventdata.GetFile()->GetName();
+				}
+			}
+			else if (request == IORequest::GetMetaEntry)
+			{
+				m_fi.GetMetaEntry();
+				m_ioResult = 0;
+			}
+			else if (request == IORequest::GetClusterEnd)
+			{
+				m_ioResult = RootFileHelper::GetClusterEnd(&(m_fi.eventdata), m_ioEntry);
+			}
+			else if (request == IORequest::LoadBaskets)
+			{
+				long long localEntry = m_fi.eventdata.LoadTree(m_ioEntry);
+				if ((localEntry >= 0) && (m_fi.eventdata.GetTree() != nullptr))
+				{
+					RootFileHelper::LoadBaskets(m_fi.eventdata.GetTree(), localEntry, localEntry + (m_ioEndEntry - m_ioEntry));
+				}
+				m_ioResult = 0;
+			}
+
+			m_ioDone = true;
+			m_ioDoneCondition.notify_one();
+
+			if ((request == IORequest::GetEntry) && (m_readAheadEntries > 0))
+			{
+				// read ahead while the pipelines process the current entry
+				lock.unlock();
+				ReadAhead();
+				lock.lock();
+			}
+		}
+	}
+
+	/// load the baskets of the cluster containing the entry ReadAheadEntries entries after the current
+	/// one of the current tree, once per cluster, the next tree is opened by GetEntry when it is needed
+	void ReadAhead()
+	{
+		TTree* tree = m_fi.eventdata.GetTree();
+		if ((tree == nullptr) || (tree->GetReadEntry() < 0))
+		{
+			return;
+		}
+
+		Long64_t entry = tree->GetReadEntry() + m_readAheadEntries;
+		int treeNumber = m_fi.eventdata.GetTreeNumber();
+		if ((entry >= tree->GetEntries()) || ((treeNumber == m_readAheadTreeNumber) && (entry < m_readAheadEnd)))
+		{
+			return;
+		}
+
+		TTree::TClusterIterator clusterIterator = tree->GetClusterIterator(entry);
+		clusterIterator();
+		m_readAheadTreeNumber = treeNumber;
+		m_readAheadEnd = std::max(clusterIterator.GetNextEntry(), entry + 1);
+		RootFileHelper::LoadBaskets(tree, entry, m_readAheadEnd);
+	}
+
+	size_t m_readAheadEntries;
+	// end of the entries of the current tree, which have been read ahead, only used by the I/O thread
+	int m_readAheadTreeNumber = -1;
+	Long64_t m_readAheadEnd = -1;
+	bool m_readInClusters;
+
+	bool m_replay = false;
+	std::vector<long long> m_replayEntries;
+
+	std::thread m_ioThread;
+	std::mutex m_ioMutex;
+	std::condition_variable m_ioRequestCondition;
+	std::condition_variable m_ioDoneCondition;
+
+	// guarded by m_ioMutex
+	IORequest m_ioRequest;
+	long long m_ioEntry;
+	long long m_ioEndEntry;
+	long long m_ioResult;
+	int m_ioTreeNumber;
+	long long m_ioLocalEntry = -1;
+	std::string m_ioFileName;
+	bool m_ioDone;
+
+	// only accessed by the I/O thread
+	int m_prevIOTreeNumber = -1;
 };
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "KappaTools/RootTools/interface/HLTTools.h"
@@ -231,4 +234,38 @@ public:
 	{
 		return (KappaProduct::GetLastJetAbovePtThreshold(jets, lowerPtThreshold) - jets.begin());
 	}
+
+	// functions to reduce the kinematics of the leading objects to the value, which decides on a cut on all of them
+	// undefined values are returned immediately, such that they fail the cut as they would do for single objects
+	template<class TObject>
+	static double GetLowestPt(std::vector<TObject*> const& objects, size_t nLeadingObjects, double defaultValue)
+	{
+		double lowestPt = defaultValue;
+		size_t nObjects = std::min(objects.size(), nLeadingObjects);
+		for (size_t objectIndex = 0; (objectIndex < nObjects) && (! std::isnan(lowestPt)); ++objectIndex)
+		{
+			double pt = objects[objectIndex]->p4.Pt();
+			if (! (pt >= lowestPt))
+			{
+				lowestPt = pt;
+			}
+		}
+		return lowestPt;
+	}
+
+	template<class TObject>
+	static double GetHighestAbsEta(std::vector<TObject*> const& objects, size_t nLeadingObjects, double defaultValue)
+	{
+		double highestAbsEta = defaultValue;
+		size_t nObjects = std::min(objects.size(), nLeadingObjects);
+		for (size_t objectIndex = 0; (objectIndex < nObjects) && (! std::isnan(highestAbsEta)); ++objectIndex)
+		{
+			double absEta = std::abs(objects[objectIndex]->p4.Eta());
+			if (! (absEta <= highestAbsEta))
+			{
+				highestAbsEta = absEta;
+			}
+		}
+		return highestAbsEta;
+	}
 };
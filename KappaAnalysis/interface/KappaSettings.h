@@ -17,6 +17,23 @@ public:
 
 	IMPL_SETTING_DEFAULT(bool, BatchMode, false);
 
+	/// distance in entries, from which on the baskets of the following cluster are read ahead
+	/// by the I/O thread (0: no read-ahead), see KappaEventProviderBase
+	IMPL_SETTING_DEFAULT(int, ReadAheadEntries, 0);
+
+	/// process the events in batches of one TTree cluster, whose baskets are loaded at once
+	IMPL_SETTING_DEFAULT(bool, ReadInClusters, false);
+
+	/// output file of the KappaSkimConsumer (default: <output file>_<pipeline>_skim.root)
+	IMPL_SETTING_DEFAULT(std::string, SkimOutputFile, "");
+
+	/// output file of the EventIndexConsumer (default: <output file>_<pipeline>_eventindex.root)
+	IMPL_SETTING_DEFAULT(std::string, EventIndexFile, "");
+
+	/// process only the events ("run:lumi:event") of ReplayEvents, which are looked up in this event index
+	IMPL_SETTING_DEFAULT(std::string, ReplayEventIndex, "");
+	IMPL_SETTING_STRINGLIST_DEFAULT(ReplayEvents, {});
+
 	IMPL_SETTING(std::string, Nickname);
 
 	/// name of electron collection in kappa tupl
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Artus/Core/interface/StaticPipeline.h"
+
+#include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/KappaAnalysis/interface/Producers/ValidMuonsProducer.h"
+#include "Artus/KappaAnalysis/interface/Filters/MinObjectsCountFilters.h"
+#include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
+
+
+/**
+   \brief Static pipeline selecting events with valid muons and writing them to a lambda ntuple.
+
+   Needs the settings of ValidMuonsProducer, MinMuonsCountFilter and KappaLambdaNtupleConsumer.
+   The pipeline is instantiated once in KappaStaticPipelines.cc.
+*/
+typedef StaticPipeline<KappaTypes,
+                       ValidMuonsProducer<KappaTypes>,
+                       MinMuonsCountFilter,
+                       KappaLambdaNtupleConsumer<KappaTypes> > KappaValidMuonsPipeline;
+
+extern template class StaticPipeline<KappaTypes,
+                                     ValidMuonsProducer<KappaTypes>,
+                                     MinMuonsCountFilter,
+                                     KappaLambdaNtupleConsumer<KappaTypes> >;
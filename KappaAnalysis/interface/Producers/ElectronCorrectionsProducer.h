@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
@@ -17,6 +19,8 @@ class ElectronCorrectionsProducer: public KappaProducerBase
 public:
 
 	std::string GetProducerId() const override;
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
 	
 	void Init(KappaSettings const& settings)  override;
 
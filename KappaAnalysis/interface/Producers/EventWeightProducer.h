@@ -20,6 +20,8 @@ class EventWeightProducer: public KappaProducerBase {
 public:
 
 	std::string GetProducerId() const override;
+
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
 	
 	~EventWeightProducer();
 	
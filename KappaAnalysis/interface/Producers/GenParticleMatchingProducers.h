@@ -9,6 +9,7 @@
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatcher.h"
 #include "Artus/Utility/interface/Utility.h"
 
 
@@ -46,6 +47,13 @@ public:
 	KGenParticle* Match(event_type const& event, product_type const& product,
                         setting_type const& settings, KLV* const recoJet) const;
 
+	/// matching against the partons collected by FillPartons, which only needs to be done once per event
+	KGenParticle* Match(event_type const& event, product_type const& product,
+                        setting_type const& settings, KLV* const recoJet,
+                        DeltaRMatcher const& partonMatcher, std::vector<KGenParticle*> const& partons) const;
+
+	static void FillPartons(event_type const& event, DeltaRMatcher& partonMatcher, std::vector<KGenParticle*>& partons);
+
 private:
 	JetMatchingAlgorithm m_jetMatchingAlgorithm;
 	float m_DeltaRMatchingRecoJetGenParticle;
@@ -138,6 +146,24 @@ public:
 					++leptonIndex;
 				}
 			}
+			
+			// only use genParticles that will decay into comparable particles and have the required status if requested
+			DeltaRMatcher genParticleMatcher;
+			std::vector<KGenParticle*> genParticles;
+			for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
+				genParticle != event.m_genParticles->end(); ++genParticle)
+			{
+				if (((settings.*GetRecoLeptonMatchingGenParticlePdgIds)().empty() ||
+				     Utility::Contains((settings.*GetRecoLeptonMatchingGenParticlePdgIds)(), std::abs(genParticle->pdgId))) &&
+				    ((settings.*GetRecoLeptonMatchingGenParticleStatus)() == -1 ||
+				     (settings.*GetRecoLeptonMatchingGenParticleStatus)() == genParticle->status()))
+				{
+					genParticleMatcher.Add(genParticle->p4);
+					genParticles.push_back(&(*genParticle));
+				}
+			}
+			std::vector<size_t> matchingGenParticleIndices;
+			
 			// loop over all chosen leptons to check
 			for (typename std::vector<TLepton*>::iterator lepton = leptons.begin();
 				 lepton != leptons.end();)
@@ -145,34 +171,41 @@ public:
 				bool leptonMatched = false;
 				float deltaR = 0.0f;
 				float deltaRmin = std::numeric_limits<float>::max();
+				bool lastGenParticleMatched = false;
 
-				// loop over all genParticles
-				for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-					genParticle != event.m_genParticles->end(); ++genParticle)
+				// loop over all genParticles within the cone
+				genParticleMatcher.FindMatches((*lepton)->p4, (settings.*GetDeltaRMatchingRecoLeptonsGenParticle)(), matchingGenParticleIndices);
+				for (std::vector<size_t>::const_iterator genParticleIndex = matchingGenParticleIndices.begin();
+				     genParticleIndex != matchingGenParticleIndices.end(); ++genParticleIndex)
 				{
-					// only use genParticles that will decay into comparable particles
-					if ((settings.*GetRecoLeptonMatchingGenParticlePdgIds)().empty() ||
-					    Utility::Contains((settings.*GetRecoLeptonMatchingGenParticlePdgIds)(), std::abs(genParticle->pdgId)))
+					KGenParticle* genParticle = genParticles[*genParticleIndex];
+					deltaR = std::sqrt(DeltaRMatcher::DeltaR2((*lepton)->p4.Eta(), (*lepton)->p4.Phi(), genParticle->p4.Eta(), genParticle->p4.Phi()));
+					lastGenParticleMatched = false;
+					if (deltaR < deltaRmin)
+					{
+						(product.*m_genParticleMatchedLeptons)[*lepton] = genParticle;
+						ratioGenParticleMatched += (1.0f / leptons.size());
+						deltaRmin = deltaR;
+						leptonMatched = true;
+						lastGenParticleMatched = true;
+						//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*lepton)->p4 << " --> " << genParticle->p4 << ", pdg=" << genParticle->pdgId << ", status=" << genParticle->status();
+					}
+				}
+
+				// the stored Delta R is the one of the last genParticle in the event, if it has improved the matching
+				// (lastGenParticleMatched deliberately reproduces this behaviour of the previous loop over all
+				// genParticles, although the Delta R of the best match would be more meaningful)
+				if (! event.m_genParticles->empty())
+				{
+					if (lastGenParticleMatched && (matchingGenParticleIndices.back() == genParticles.size() - 1) &&
+					    (genParticles.back() == &event.m_genParticles->back()))
+					{
+						product.m_genParticleMatchDeltaR = deltaRmin;
+					}
+					else
 					{
-						// only use genParticles with the required status if requested
-						if ((settings.*GetRecoLeptonMatchingGenParticleStatus)() == -1 ||
-						    (settings.*GetRecoLeptonMatchingGenParticleStatus)() == genParticle->status())
-						{
-							deltaR = ROOT::Math::VectorUtil::DeltaR((*lepton)->p4, genParticle->p4);
-							if(deltaR<(settings.*GetDeltaRMatchingRecoLeptonsGenParticle)() && deltaR<deltaRmin)
-							{
-								(product.*m_genParticleMatchedLeptons)[*lepton] = &(*genParticle);
-								ratioGenParticleMatched += (1.0f / leptons.size());
-								product.m_genParticleMatchDeltaR = deltaR;
-								deltaRmin = deltaR;
-								leptonMatched = true;
-								//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*lepton)->p4 << " --> " << genParticle->p4 << ", pdg=" << genParticle->pdgId << ", status=" << genParticle->status();
-							}
-							else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
-						}
-						else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
+						product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
 					}
-					else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
 				}
 				// invalidate (non) matching lepton if requested
 				if (!(settings.*GetRecoLeptonMatchingGenParticleMatchAllLeptons)() &&
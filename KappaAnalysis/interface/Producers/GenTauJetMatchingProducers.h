@@ -5,6 +5,7 @@
 
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatcher.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 
@@ -60,29 +61,28 @@ public:
 		
 		if ((settings.*GetDeltaRMatchingRecoObjectGenTauJet)() > 0.0)
 		{
+			// TODO: maybe need to match to visible component of genTauJet
+			// depends on setting for TauGenJetProducer.includeNeutrinos
+			// PhysicsTools/JetMCAlgos/python/TauGenJets_cfi.py
+			DeltaRMatcher genTauJetMatcher;
+			genTauJetMatcher.Reserve(event.m_genTauJets->size());
+			for (typename std::vector<KGenJet>::const_iterator genTauJet = event.m_genTauJets->begin();
+				genTauJet != event.m_genTauJets->end(); ++genTauJet)
+			{
+				genTauJetMatcher.Add(genTauJet->p4);
+			}
+			
 			// loop over all valid objects to check
 			for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
 				 validObject != (product.*m_validObjects).end();)
 			{
-				bool objectMatched = false;
-				float deltaR = 0;
-				float deltaRmin = std::numeric_limits<float>::max();
-				
-				// loop over all genTauJets
-				for (typename std::vector<KGenJet>::iterator genTauJet = event.m_genTauJets->begin();
-					genTauJet != event.m_genTauJets->end(); ++genTauJet) 
+				// closest genTauJet
+				int genTauJetIndex = genTauJetMatcher.FindBestMatch((*validObject)->p4, (settings.*GetDeltaRMatchingRecoObjectGenTauJet)());
+				bool objectMatched = (genTauJetIndex >= 0);
+				if (objectMatched)
 				{
-					// TODO: maybe need to match to visible component of genTauJet
-					// depends on setting for TauGenJetProducer.includeNeutrinos
-					// PhysicsTools/JetMCAlgos/python/TauGenJets_cfi.py
-					deltaR = ROOT::Math::VectorUtil::DeltaR((*validObject)->p4, genTauJet->p4);
-					if(deltaR<(settings.*GetDeltaRMatchingRecoObjectGenTauJet)() && deltaR<deltaRmin)
-					{
-						(product.*m_genTauJetMatchedObjects)[*validObject] = &(*genTauJet);
-						deltaRmin = deltaR;
-						objectMatched = true;
-						//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*validObject)->p4 << " --> " << genTauJet->p4;
-					}
+					(product.*m_genTauJetMatchedObjects)[*validObject] = &(event.m_genTauJets->at(genTauJetIndex));
+					//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*validObject)->p4 << " --> " << event.m_genTauJets->at(genTauJetIndex).p4;
 				}
 				// invalidate the object if it has not matched
 				if (((! objectMatched) && (settings.*GetInvalidateNonGenTauJetMatchingObjects)()) ||
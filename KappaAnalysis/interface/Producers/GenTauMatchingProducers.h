@@ -5,6 +5,7 @@
 
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatcher.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 
@@ -100,6 +101,21 @@ public:
 					++objectIndex;
 				}
 			}
+			
+			// if configured: only use genTaus that will decay into comparable particles
+			DeltaRMatcher genTauMatcher;
+			std::vector<KGenTau*> genTaus;
+			for (typename std::vector<KGenTau>::iterator genTau = event.m_genTaus->begin();
+				genTau != event.m_genTaus->end(); ++genTau)
+			{
+				if (!(settings.*GetMatchGenTauDecayMode)() || ((settings.*GetMatchGenTauDecayMode)() && MatchDecayMode(*genTau, tauDecayMode)))
+				{
+					genTauMatcher.Add(genTau->visible.p4);
+					genTaus.push_back(&(*genTau));
+				}
+			}
+			std::vector<size_t> matchingGenTauIndices;
+			
 			// loop over all chosen objects to check
 			for (typename std::vector<TValidObject*>::iterator object = objects.begin();
 				 object != objects.end();)
@@ -107,28 +123,41 @@ public:
 				bool objectMatched = false;
 				float deltaR = 0;
 				float deltaRmin = std::numeric_limits<float>::max();
+				bool lastGenTauMatched = false;
 				
-				// loop over all genTaus
-				for (typename std::vector<KGenTau>::iterator genTau = event.m_genTaus->begin(); 
-					genTau != event.m_genTaus->end(); ++genTau) 
+				// loop over all genTaus within the cone
+				genTauMatcher.FindMatches((*object)->p4, (settings.*GetDeltaRMatchingRecoObjectGenTau)(), matchingGenTauIndices);
+				for (std::vector<size_t>::const_iterator genTauIndex = matchingGenTauIndices.begin();
+				     genTauIndex != matchingGenTauIndices.end(); ++genTauIndex)
 				{
-					// if configured: only use genTaus that will decay into comparable particles
-					if (!(settings.*GetMatchGenTauDecayMode)() || ((settings.*GetMatchGenTauDecayMode)() && MatchDecayMode(*genTau, tauDecayMode)))
+					KGenTau* genTau = genTaus[*genTauIndex];
+					deltaR = std::sqrt(DeltaRMatcher::DeltaR2((*object)->p4.Eta(), (*object)->p4.Phi(), genTau->visible.p4.Eta(), genTau->visible.p4.Phi()));
+					lastGenTauMatched = false;
+					if (deltaR < deltaRmin)
+					{
+						(product.*m_genTauMatchedObjects)[*object] = genTau;
+						product.m_genTauMatchedLeptons[*object] = genTau;
+						ratioGenTauMatched += 1.0 / objects.size();
+						deltaRmin = deltaR;
+						objectMatched = true;
+						lastGenTauMatched = true;
+						//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*object)->p4 << " --> " << genTau->visible.p4;
+					}
+				}
+				
+				// the stored Delta R is the one of the last genTau in the event, if it has improved the matching
+				// (kept for compatibility with the previous loop over all genTaus, as for the genParticles)
+				if (! event.m_genTaus->empty())
+				{
+					if (lastGenTauMatched && (matchingGenTauIndices.back() == genTaus.size() - 1) &&
+					    (genTaus.back() == &event.m_genTaus->back()))
+					{
+						product.m_genTauMatchDeltaR = deltaRmin;
+					}
+					else
 					{
-						deltaR = static_cast<float>(ROOT::Math::VectorUtil::DeltaR((*object)->p4, genTau->visible.p4));
-						if(deltaR<(settings.*GetDeltaRMatchingRecoObjectGenTau)() && deltaR<deltaRmin)
-						{
-							(product.*m_genTauMatchedObjects)[*object] = &(*genTau);
-							product.m_genTauMatchedLeptons[*object] = &(*genTau);
-							ratioGenTauMatched += 1.0 / objects.size();
-							product.m_genTauMatchDeltaR = deltaR;
-							deltaRmin = deltaR;
-							objectMatched = true;
-							//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*object)->p4 << " --> " << genTau->visible.p4;
-						}
-						else product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
+						product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
 					}
-					else product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
 				}
 				// invalidate the object if it has not matched
 				if (!(settings.*GetMatchAllObjectsGenTau)() &&
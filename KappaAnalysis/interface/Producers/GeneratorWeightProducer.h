@@ -7,6 +7,10 @@ public:
 
 	std::string GetProducerId() const override;
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
+
 	void Produce(KappaEvent const& event,
 			KappaProduct& product,
 			KappaSettings const& settings) const override;
@@ -18,6 +18,7 @@ class HltProducer: public KappaProducerBase
 {
 public:
 	std::string GetProducerId() const override;
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
 
 	void Init(KappaSettings const& settings) override;
 
@@ -2,6 +2,9 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
+#include <typeinfo>
+#include <utility>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -107,16 +110,11 @@ public:
 		assert(event.m_pileupDensity);
 		assert(event.m_vertexSummary);
 		
-		// create a copy of all jets in the event (first temporarily for the JEC)
 		(product.*m_correctedJetsMember).clear();
-		std::vector<TJet> correctJetsForJecTools((event.*m_basicJetsMember)->size());
-		size_t jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = (event.*m_basicJetsMember)->begin();
-			 jet != (event.*m_basicJetsMember)->end(); ++jet)
-		{
-			correctJetsForJecTools[jetIndex] = *jet;
-			++jetIndex;
-		}
+		
+		// create a copy of all jets in the event (first temporarily for the JEC), the buffer keeps its capacity
+		std::vector<TJet> const& jets = *(event.*m_basicJetsMember);
+		correctJetsForJecTools.assign(jets.begin(), jets.end());
 		
 		// apply jet energy corrections and uncertainty shift (if uncertainties are not to be splitted into individual contributions)
 		float shift = settings.GetJetEnergyCorrectionSplitUncertainty() ? 0.0 : settings.GetJetEnergyCorrectionUncertaintyShift();
@@ -124,16 +122,28 @@ public:
 		            event.m_pileupDensity->rho, event.m_vertexSummary->nVertices, -1,
 		            shift);
 		
-		// create the shared pointers to store in the product
-		(product.*m_correctedJetsMember).clear();
+		// move the corrected jets into the pooled shared pointers to store in the product
+		// a pooled jet is only reused, if it is not referenced anymore outside of the pool
+		if (correctedJetsPool.size() < correctJetsForJecTools.size())
+		{
+			correctedJetsPool.resize(correctJetsForJecTools.size());
+		}
 		(product.*m_correctedJetsMember).resize(correctJetsForJecTools.size());
-		jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = correctJetsForJecTools.begin();
-			 jet != correctJetsForJecTools.end(); ++jet)
+		for (size_t jetIndex = 0; jetIndex < correctJetsForJecTools.size(); ++jetIndex)
 		{
-			(product.*m_correctedJetsMember)[jetIndex] = std::shared_ptr<TJet>(new TJet(*jet));
-			product.m_originalJets[(product.*m_correctedJetsMember)[jetIndex].get()] = &(*jet);
-			++jetIndex;
+			std::shared_ptr<TJet>& pooledJet = correctedJetsPool[jetIndex];
+			if (pooledJet && (pooledJet.use_count() == 1))
+			{
+				std::swap(*pooledJet, correctJetsForJecTools[jetIndex]);
+			}
+			else
+			{
+				pooledJet = std::make_shared<TJet>(std::move(correctJetsForJecTools[jetIndex]));
+			}
+			(product.*m_correctedJetsMember)[jetIndex] = pooledJet;
+			
+			// the JEC tools correct the jets in place, such that the indices correspond to the ones of the input jets
+			product.m_originalJets[pooledJet.get()] = &(jets[jetIndex]);
 		}
 		
 		// perform corrections on copied jets
@@ -148,12 +158,22 @@ public:
 		
 		// sort vectors of corrected jets by pt
 		std::sort((product.*m_correctedJetsMember).begin(), (product.*m_correctedJetsMember).end(),
-		          [](std::shared_ptr<TJet> jet1, std::shared_ptr<TJet> jet2) -> bool
+		          [](std::shared_ptr<TJet> const& jet1, std::shared_ptr<TJet> const& jet2) -> bool
 		          { return jet1->p4.Pt() > jet2->p4.Pt(); });
 	}
 
 
 protected:
+	// settings read by this base class, see GetSettingDependencies
+	void AddJetCorrectionsSettingDependencies(std::vector<std::string> & settingNames) const
+	{
+		settingNames.push_back("JetEnergyCorrectionParameters");
+		settingNames.push_back("JetEnergyCorrectionUncertaintyParameters");
+		settingNames.push_back("JetEnergyCorrectionUncertaintySource");
+		settingNames.push_back("JetEnergyCorrectionUncertaintyShift");
+		settingNames.push_back("JetEnergyCorrectionSplitUncertainty");
+	}
+
 	// Can be overwritten for analysis-specific use cases
 	virtual void AdditionalCorrections(TJet* jet, KappaEvent const& event,
 	                                   KappaProduct& product, KappaSettings const& settings) const
@@ -167,6 +187,10 @@ private:
 
 	FactorizedJetCorrector* factorizedJetCorrector = nullptr;
 	JetCorrectionUncertainty* jetCorrectionUncertainty = nullptr;
+
+	// memory reused in every event
+	mutable std::vector<TJet> correctJetsForJecTools;
+	mutable std::vector<std::shared_ptr<TJet> > correctedJetsPool;
 };
 
 
@@ -182,6 +206,8 @@ public:
 	JetCorrectionsProducer();
 
 	std::string GetProducerId() const override;
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
 };
 
 
@@ -198,6 +224,8 @@ public:
 	TaggedJetCorrectionsProducer();
 	
 	std::string GetProducerId() const override;
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
 };
 
 
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
@@ -21,6 +23,8 @@ class MuonCorrectionsProducer: public KappaProducerBase
 public:
 	std::string GetProducerId() const override;
 
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
+
 	void Init(setting_type const& settings) override;
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
@@ -14,6 +14,10 @@ public:
 
 	std::string GetProducerId() const override;
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
+
 	void Init(KappaSettings const& settings) override;
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
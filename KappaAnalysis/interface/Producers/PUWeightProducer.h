@@ -22,6 +22,8 @@ public:
 
 	std::string GetProducerId() const override;
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override;
+
 	void Init(KappaSettings const& settings) override;
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
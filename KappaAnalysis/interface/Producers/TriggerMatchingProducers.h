@@ -4,14 +4,21 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerNameMatcher.h"
+#include "Artus/Utility/interface/DeltaRMatcher.h"
 
-#include <boost/regex.hpp>
+#include <limits>
+#include <utility>
 
 
 
 /** Abstract Producer class for trigger matching valid objects
  *
  *	Needs to run after the valid object producers.
+ *
+ *	The HLT and filter name patterns are compiled once. For each lumi section, the fired HLT paths
+ *	are resolved into the indices of their filters matching the patterns, when they occur first.
+ *	The trigger objects of a filter are matched to all valid objects at once using a DeltaRMatcher.
  */
 template<class TValidObject>
 class TriggerMatchingProducerBase: public KappaProducerBase
@@ -77,6 +84,7 @@ public:
 	{
 		assert(event.m_triggerObjects);
 		assert(event.m_triggerObjectMetadata);
+		assert(event.m_eventInfo);
 		
 		if ((product.*m_settingsObjectTriggerFiltersByIndex).empty())
 		{
@@ -93,76 +101,86 @@ public:
 		(product.*m_detailedTriggerMatchedObjects).clear();
 		if ((! product.m_selectedHltNames.empty()) && ((settings.*GetDeltaRTriggerMatchingObjects)() > 0.0))
 		{
+			UpdateTriggerNameResolution(event, product);
+			
+			DeltaRMatcher validObjectMatcher;
+			validObjectMatcher.Reserve((product.*m_validObjects).size());
+			for (typename std::vector<TValidObject*>::const_iterator validObject = (product.*m_validObjects).begin();
+			     validObject != (product.*m_validObjects).end(); ++validObject)
+			{
+				validObjectMatcher.Add((*validObject)->p4);
+			}
+			std::vector<size_t> matchedValidObjectIndices;
+			
 			bool hasAllHltMatches = true;
 			bool hasHltAndFilterMatch = false;
 			
-			// loop over the hlt names given in the config file
-			for (std::map<std::string, std::vector<std::string>>::const_iterator objectTriggerFilterByHltName = (product.*m_settingsObjectTriggerFiltersByHltName).begin();
-			     objectTriggerFilterByHltName != (product.*m_settingsObjectTriggerFiltersByHltName).end();
-			     ++objectTriggerFilterByHltName)
+			// loop over the hlt names given in the config file, as resolved for this lumi section
+			size_t hltPatternIndex = 0;
+			for (std::map<std::string, std::vector<std::string>>::const_iterator objectTriggerFilterByHltName = m_resolvedTriggerFiltersByHltName.begin();
+			     objectTriggerFilterByHltName != m_resolvedTriggerFiltersByHltName.end();
+			     ++objectTriggerFilterByHltName, ++hltPatternIndex)
 			{
 				//LOG(DEBUG) << "objectTriggerFilterByHltName->first = " << objectTriggerFilterByHltName->first;
 				
 				// loop over all fired HLT paths
 				for (unsigned int firedHltIndex = 0; firedHltIndex < product.m_selectedHltNames.size(); ++firedHltIndex)
 				{
-					std::string firedHltName = product.m_selectedHltNames.at(firedHltIndex);
+					std::string const& firedHltName = product.m_selectedHltNames.at(firedHltIndex);
 					int firedHltPosition = product.m_selectedHltPositions.at(firedHltIndex);
 					//LOG(DEBUG) << "\tfiredFilterIndex, firedHltName, firedHltPosition = " << firedHltIndex << ", " << firedHltName << ", " << firedHltPosition;
 					
+					ResolvedHlt const& resolvedHlt = ResolveHlt(event, firedHltPosition, firedHltName);
+					
 					// check that the hlt name given in the config matches the hlt which fired in the event
-					if (boost::regex_search(firedHltName, boost::regex(objectTriggerFilterByHltName->first, boost::regex::icase | boost::regex::extended)))
+					if (resolvedHlt.hltMatches[hltPatternIndex])
 					{
 						//LOG(DEBUG) << "\t\thltMatched";
 						
 						// loop over the filter regexp associated with the given hlt in the config
-						for (std::vector<std::string>::const_iterator filterName = objectTriggerFilterByHltName->second.begin();
-						     filterName != objectTriggerFilterByHltName->second.end();
-						     ++filterName)
+						for (std::vector<std::vector<size_t> >::const_iterator matchingFilterIndices = resolvedHlt.filterIndices[hltPatternIndex].begin();
+						     matchingFilterIndices != resolvedHlt.filterIndices[hltPatternIndex].end();
+						     ++matchingFilterIndices)
 						{
-							//LOG(DEBUG) << "\t\t\tfilterName = " << *filterName;
-							
-							// loop over all filters for the fired HLT
-							for (size_t firedFilterIndex = event.m_triggerObjectMetadata->getMinFilterIndex(firedHltPosition);
-							     firedFilterIndex < event.m_triggerObjectMetadata->getMaxFilterIndex(firedHltPosition);
-							     ++firedFilterIndex)
+							// loop over all filters for the fired HLT, which match the filter regexp given in the config
+							for (std::vector<size_t>::const_iterator matchingFilterIndex = matchingFilterIndices->begin();
+							     matchingFilterIndex != matchingFilterIndices->end();
+							     ++matchingFilterIndex)
 							{
-								std::string firedFilterName = event.m_triggerObjectMetadata->toFilter[firedFilterIndex];
+								size_t firedFilterIndex = *matchingFilterIndex;
+								std::string const& firedFilterName = event.m_triggerObjectMetadata->toFilter[firedFilterIndex];
 								//LOG(DEBUG) << "\t\t\t\tfiredFilterIndex, firedFilterName = " << firedFilterIndex << ", " << firedFilterName;
 								
-								// check that the filter regexp given in the config matches the fired filter
-								if (boost::regex_search(firedFilterName, boost::regex(*filterName, boost::regex::icase | boost::regex::extended)))
+								hasHltAndFilterMatch = true;
+								//LOG(DEBUG) << "\t\t\t\t\tfilterMatched";
+								
+								std::vector<std::vector<KLV*> > matchedTriggerObjects((product.*m_validObjects).size());
+								
+								// loop over all trigger objects for the fired filter
+								for (std::vector<int>::const_iterator triggerObjectIndex = event.m_triggerObjects->toIdxFilter[firedFilterIndex].begin();
+								     triggerObjectIndex != event.m_triggerObjects->toIdxFilter[firedFilterIndex].end();
+								     ++triggerObjectIndex)
 								{
-									hasHltAndFilterMatch = true;
-									//LOG(DEBUG) << "\t\t\t\t\tfilterMatched";
+									KLV* triggerObject = &event.m_triggerObjects->trgObjects.at(*triggerObjectIndex);
+									//LOG(DEBUG) << "\t\t\t\t\ttriggerObjectIndex, triggerObject = " << *triggerObjectIndex << ", " << triggerObject << ", (pt, eta, phi) = (" << triggerObject->p4.Pt() << ", " << triggerObject->p4.Eta() << ", " << triggerObject->p4.Phi() << ")";
 									
-									// loop over all valid objects to check
-									for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
-									     validObject != (product.*m_validObjects).end(); ++validObject)
+									// check the matching to all valid objects
+									if (triggerObject->p4.Pt() > settings.GetTriggerObjectLowerPtCut())
 									{
-										std::vector<KLV*> matchedTriggerObjects;
-										//LOG(DEBUG) << "\t\t\t\t\t\tvalidObject = " << *validObject << ", (pt, eta, phi) = (" << (*validObject)->p4.Pt() << ", " << (*validObject)->p4.Eta() << ", " << (*validObject)->p4.Phi() << ")";
-										
-										// loop over all trigger objects for the fired filter
-										for (std::vector<int>::const_iterator triggerObjectIndex = event.m_triggerObjects->toIdxFilter[firedFilterIndex].begin();
-										     triggerObjectIndex != event.m_triggerObjects->toIdxFilter[firedFilterIndex].end();
-										     ++triggerObjectIndex)
+										validObjectMatcher.FindMatches(triggerObject->p4, (settings.*GetDeltaRTriggerMatchingObjects)(), matchedValidObjectIndices);
+										for (std::vector<size_t>::const_iterator validObjectIndex = matchedValidObjectIndices.begin();
+										     validObjectIndex != matchedValidObjectIndices.end(); ++validObjectIndex)
 										{
-											KLV* triggerObject = &event.m_triggerObjects->trgObjects.at(*triggerObjectIndex);
-											//LOG(DEBUG) << "\t\t\t\t\t\t\ttriggerObjectIndex, triggerObject = " << *triggerObjectIndex << ", " << triggerObject << ", (pt, eta, phi) = (" << triggerObject->p4.Pt() << ", " << triggerObject->p4.Eta() << ", " << triggerObject->p4.Phi() << ")";
-											
-											// check the matching
-											if (ROOT::Math::VectorUtil::DeltaR(triggerObject->p4, (*validObject)->p4) < (settings.*GetDeltaRTriggerMatchingObjects)() && triggerObject->p4.Pt() > settings.GetTriggerObjectLowerPtCut())
-											{
-												//LOG(DEBUG) << "\t\t\t\t\t\t\t\tobjectMatched";
-												
-												matchedTriggerObjects.push_back(triggerObject);
-											}
+											//LOG(DEBUG) << "\t\t\t\t\t\tobjectMatched: " << (product.*m_validObjects)[*validObjectIndex];
+											matchedTriggerObjects[*validObjectIndex].push_back(triggerObject);
 										}
-										
-										(product.*m_detailedTriggerMatchedObjects)[*validObject][firedHltName][firedFilterName] = matchedTriggerObjects;
 									}
 								}
+								
+								for (size_t validObjectIndex = 0; validObjectIndex < (product.*m_validObjects).size(); ++validObjectIndex)
+								{
+									(product.*m_detailedTriggerMatchedObjects)[(product.*m_validObjects)[validObjectIndex]][firedHltName][firedFilterName] = std::move(matchedTriggerObjects[validObjectIndex]);
+								}
 							}
 						}
 					}
@@ -221,6 +239,88 @@ public:
 
 
 private:
+
+	/// filters of a fired HLT path matching the patterns
+	struct ResolvedHlt
+	{
+		bool resolved = false;
+		/// by index of the HLT pattern
+		std::vector<char> hltMatches;
+		/// by index of the HLT pattern and index of the filter pattern
+		std::vector<std::vector<std::vector<size_t> > > filterIndices;
+	};
+
+	/// forget the resolved HLT paths in a new lumi section and compile the patterns, if they have changed,
+	/// the patterns in the product are expected not to change within a lumi section
+	void UpdateTriggerNameResolution(KappaEvent const& event, KappaProduct const& product) const
+	{
+		if ((event.m_eventInfo->nRun == m_resolvedRun) && (event.m_eventInfo->nLumi == m_resolvedLumi) &&
+		    (event.m_triggerObjectMetadata == m_resolvedTriggerObjectMetadata))
+		{
+			return;
+		}
+		m_resolvedRun = event.m_eventInfo->nRun;
+		m_resolvedLumi = event.m_eventInfo->nLumi;
+		m_resolvedTriggerObjectMetadata = event.m_triggerObjectMetadata;
+		m_resolvedHlts.clear();
+		
+		if ((product.*m_settingsObjectTriggerFiltersByHltName) != m_resolvedTriggerFiltersByHltName)
+		{
+			m_resolvedTriggerFiltersByHltName = (product.*m_settingsObjectTriggerFiltersByHltName);
+			m_hltPatterns.clear();
+			m_filterPatterns.clear();
+			for (std::map<std::string, std::vector<std::string> >::const_iterator objectTriggerFilterByHltName = m_resolvedTriggerFiltersByHltName.begin();
+			     objectTriggerFilterByHltName != m_resolvedTriggerFiltersByHltName.end(); ++objectTriggerFilterByHltName)
+			{
+				m_hltPatterns.push_back(m_triggerNameMatcher.AddPattern(objectTriggerFilterByHltName->first));
+				m_filterPatterns.push_back(std::vector<size_t>());
+				for (std::vector<std::string>::const_iterator filterName = objectTriggerFilterByHltName->second.begin();
+				     filterName != objectTriggerFilterByHltName->second.end(); ++filterName)
+				{
+					m_filterPatterns.back().push_back(m_triggerNameMatcher.AddPattern(*filterName));
+				}
+			}
+		}
+	}
+
+	ResolvedHlt const& ResolveHlt(KappaEvent const& event, int hltPosition, std::string const& hltName) const
+	{
+		if (static_cast<size_t>(hltPosition) >= m_resolvedHlts.size())
+		{
+			m_resolvedHlts.resize(hltPosition + 1);
+		}
+		
+		ResolvedHlt& resolvedHlt = m_resolvedHlts[hltPosition];
+		if (! resolvedHlt.resolved)
+		{
+			resolvedHlt.hltMatches.assign(m_hltPatterns.size(), 0);
+			resolvedHlt.filterIndices.assign(m_hltPatterns.size(), std::vector<std::vector<size_t> >());
+			for (size_t hltPatternIndex = 0; hltPatternIndex < m_hltPatterns.size(); ++hltPatternIndex)
+			{
+				if (m_triggerNameMatcher.Matches(m_hltPatterns[hltPatternIndex], hltName))
+				{
+					resolvedHlt.hltMatches[hltPatternIndex] = 1;
+					resolvedHlt.filterIndices[hltPatternIndex].resize(m_filterPatterns[hltPatternIndex].size());
+					for (size_t filterPatternIndex = 0; filterPatternIndex < m_filterPatterns[hltPatternIndex].size(); ++filterPatternIndex)
+					{
+						for (size_t filterIndex = event.m_triggerObjectMetadata->getMinFilterIndex(hltPosition);
+						     filterIndex < event.m_triggerObjectMetadata->getMaxFilterIndex(hltPosition);
+						     ++filterIndex)
+						{
+							if (m_triggerNameMatcher.Matches(m_filterPatterns[hltPatternIndex][filterPatternIndex],
+							                                 event.m_triggerObjectMetadata->toFilter[filterIndex]))
+							{
+								resolvedHlt.filterIndices[hltPatternIndex][filterPatternIndex].push_back(filterIndex);
+							}
+						}
+					}
+				}
+			}
+			resolvedHlt.resolved = true;
+		}
+		return resolvedHlt;
+	}
+
 	std::map<TValidObject*, KLV*> KappaProduct::*m_triggerMatchedObjects;
 	std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > KappaProduct::*m_detailedTriggerMatchedObjects;
 	std::vector<TValidObject*> KappaProduct::*m_validObjects;
@@ -234,6 +334,18 @@ private:
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndexFromSettings;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltNameFromSettings;
 
+	// patterns, for which the HLT paths are resolved
+	mutable std::map<std::string, std::vector<std::string> > m_resolvedTriggerFiltersByHltName;
+	mutable TriggerNameMatcher m_triggerNameMatcher;
+	mutable std::vector<size_t> m_hltPatterns;
+	mutable std::vector<std::vector<size_t> > m_filterPatterns;
+
+	// resolved HLT paths of the current lumi section by their positions
+	mutable unsigned int m_resolvedRun = std::numeric_limits<unsigned int>::max();
+	mutable unsigned int m_resolvedLumi = std::numeric_limits<unsigned int>::max();
+	mutable KTriggerObjectMetadata const* m_resolvedTriggerObjectMetadata = nullptr;
+	mutable std::vector<ResolvedHlt> m_resolvedHlts;
+
 };
 
 
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/regex.hpp>
@@ -25,6 +27,8 @@ public:
 
 	std::string GetProducerId() const override;
 
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
+
 	void Init(KappaSettings const& settings) override;
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -143,6 +144,31 @@ public:
 		return "ValidElectronsProducer";
 	}
 
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override {
+		// derived producers can read further settings in AdditionalCriteria
+		// and only the names of the settings read by the default getters are known
+		if ((typeid(*this) != typeid(ValidElectronsProducer<TTypes>)) ||
+		    (m_validElectronsMember != &product_type::m_validElectrons) ||
+		    (m_invalidElectronsMember != &product_type::m_invalidElectrons) ||
+		    (GetElectronID != &setting_type::GetElectronID) ||
+		    (GetElectronIsoType != &setting_type::GetElectronIsoType) ||
+		    (GetElectronIso != &setting_type::GetElectronIso) ||
+		    (GetElectronReco != &setting_type::GetElectronReco) ||
+		    (! this->ReadsKinematicCuts(&setting_type::GetElectronLowerPtCuts, &setting_type::GetElectronUpperAbsEtaCuts)))
+		{
+			return false;
+		}
+		settingNames.push_back("ValidElectronsInput");
+		settingNames.push_back("ElectronID");
+		settingNames.push_back("ElectronIsoType");
+		settingNames.push_back("ElectronIso");
+		settingNames.push_back("ElectronReco");
+		settingNames.push_back("DirectIso");
+		settingNames.push_back("ElectronLowerPtCuts");
+		settingNames.push_back("ElectronUpperAbsEtaCuts");
+		return true;
+	}
+
 	ValidElectronsProducer(std::vector<KElectron*> product_type::*validElectrons=&product_type::m_validElectrons,
 	                       std::vector<KElectron*> product_type::*invalidElectrons=&product_type::m_invalidElectrons,
 	                       std::string (setting_type::*GetElectronID)(void) const=&setting_type::GetElectronID,
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
@@ -16,6 +18,7 @@ public:
 	ValidGenJetsProducer();
 	
 	virtual std::string GetProducerId() const override;
+	virtual bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
 	virtual void Init(KappaSettings const& settings) override;
 	virtual void Produce(KappaEvent const& event, KappaProduct& product, KappaSettings const& settings) const override;
 
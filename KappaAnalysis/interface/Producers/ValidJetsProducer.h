@@ -2,6 +2,7 @@
 #pragma once
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -14,6 +15,7 @@
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
+#include "Artus/Utility/interface/DeltaRMatcher.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/KappaAnalysis/interface/KappaProduct.h"
 
@@ -217,6 +219,14 @@ public:
 			}
 		}
 
+		DeltaRMatcher leptonMatcher;
+		leptonMatcher.Reserve(product.m_validLeptons.size());
+		for (std::vector<KLepton*>::const_iterator lepton = product.m_validLeptons.begin();
+		     lepton != product.m_validLeptons.end(); ++lepton)
+		{
+			leptonMatcher.Add((*lepton)->p4);
+		}
+
 		for (typename std::vector<TJet*>::iterator jet = jets.begin(); jet != jets.end(); ++jet)
 		{
 			bool validJet = true;
@@ -224,11 +234,7 @@ public:
 			validJet = validJet && passesJetID(*jet, jetIDVersion, jetID);
 
 			// remove leptons from list of jets via simple DeltaR isolation
-			for (std::vector<KLepton*>::const_iterator lepton = product.m_validLeptons.begin();
-			     validJet && lepton != product.m_validLeptons.end(); ++lepton)
-			{
-				validJet = validJet && ROOT::Math::VectorUtil::DeltaR((*jet)->p4, (*lepton)->p4) > settings.GetJetLeptonLowerDeltaRCut();
-			}
+			validJet = validJet && (! leptonMatcher.HasMatch((*jet)->p4, settings.GetJetLeptonLowerDeltaRCut()));
 
 			// kinematic cuts
 			validJet = validJet && this->PassKinematicCuts(*jet, event, product);
@@ -399,6 +405,17 @@ public:
 
 
 protected:
+	// settings read by this base class, see GetSettingDependencies
+	void AddValidJetsSettingDependencies(std::vector<std::string> & settingNames) const
+	{
+		settingNames.push_back("ValidJetsInput");
+		settingNames.push_back("JetIDVersion");
+		settingNames.push_back("JetID");
+		settingNames.push_back("JetLeptonLowerDeltaRCut");
+		settingNames.push_back("JetLowerPtCuts");
+		settingNames.push_back("JetUpperAbsEtaCuts");
+	}
+
 	// Can be overwritten for analysis-specific use cases
 	virtual bool AdditionalCriteria(TJet* jet, KappaEvent const& event,
 	                                KappaProduct& product, KappaSettings const& settings) const
@@ -429,6 +446,8 @@ public:
 	ValidJetsProducer();
 
 	std::string GetProducerId() const override;
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
 };
 
 
@@ -447,6 +466,7 @@ class ValidTaggedJetsProducer: public ValidJetsProducerBase<KJet, KBasicJet>
 public:
 	ValidTaggedJetsProducer();
 	std::string GetProducerId() const override;
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
 	void Init(KappaSettings const& settings) override;
 
 protected:
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
 
@@ -14,6 +16,8 @@ class ValidLeptonsProducer: public KappaProducerBase
 public:
 	std::string GetProducerId() const override;
 
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override;
+
 	void Produce(KappaEvent const& event, KappaProduct& product,
 	                     KappaSettings const& settings) const override;
 
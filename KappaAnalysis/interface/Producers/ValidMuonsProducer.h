@@ -2,6 +2,7 @@
 #pragma once
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -123,6 +124,35 @@ public:
 		return "ValidMuonsProducer";
 	}
 
+	bool GetInputCollections(std::vector<std::string> & collectionNames) const override {
+		collectionNames.push_back("Muons");
+		return true;
+	}
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override {
+		// derived producers can read further settings in AdditionalCriteria
+		// and only the names of the settings read by the default getters are known
+		if ((typeid(*this) != typeid(ValidMuonsProducer<TTypes>)) ||
+		    (m_validMuonsMember != &product_type::m_validMuons) ||
+		    (m_invalidMuonsMember != &product_type::m_invalidMuons) ||
+		    (GetMuonID != &setting_type::GetMuonID) ||
+		    (GetMuonIsoType != &setting_type::GetMuonIsoType) ||
+		    (GetMuonIso != &setting_type::GetMuonIso) ||
+		    (! this->ReadsKinematicCuts(&setting_type::GetMuonLowerPtCuts, &setting_type::GetMuonUpperAbsEtaCuts)))
+		{
+			return false;
+		}
+		settingNames.push_back("ValidMuonsInput");
+		settingNames.push_back("Year");
+		settingNames.push_back("MuonID");
+		settingNames.push_back("MuonIsoType");
+		settingNames.push_back("MuonIso");
+		settingNames.push_back("DirectIso");
+		settingNames.push_back("MuonLowerPtCuts");
+		settingNames.push_back("MuonUpperAbsEtaCuts");
+		return true;
+	}
+
 	ValidMuonsProducer(std::vector<KMuon*> product_type::*validMuons=&product_type::m_validMuons,
 	                   std::vector<KMuon*> product_type::*invalidMuons=&product_type::m_invalidMuons,
 	                   std::string (setting_type::*GetMuonID)(void) const=&setting_type::GetMuonID,
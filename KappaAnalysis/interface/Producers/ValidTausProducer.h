@@ -2,6 +2,7 @@
 #pragma once
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -61,6 +62,21 @@ public:
 	std::string GetProducerId() const override {
 		return "ValidTausProducer";
 	}
+
+	bool GetSettingDependencies(std::vector<std::string> & settingNames) const override {
+		// derived producers can read further settings in AdditionalCriteria
+		if (typeid(*this) != typeid(ValidTausProducer))
+		{
+			return false;
+		}
+		settingNames.push_back("ValidTausInput");
+		settingNames.push_back("TauDiscriminators");
+		settingNames.push_back("TauID");
+		settingNames.push_back("TauUseOldDMs");
+		settingNames.push_back("TauLowerPtCuts");
+		settingNames.push_back("TauUpperAbsEtaCuts");
+		return true;
+	}
 	
 	ValidTausProducer() :
 		KappaProducerBase(),
@@ -81,6 +97,12 @@ public:
 		// parse additional config tags
 		discriminatorsByIndex = Utility::ParseMapTypes<size_t, std::string>(Utility::ParseVectorToMap(settings.GetTauDiscriminators()),
 		                                                                    discriminatorsByHltName);
+		discriminatorHltPatterns.clear();
+		for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
+		     discriminatorByHltName != discriminatorsByHltName.end(); ++discriminatorByHltName)
+		{
+			discriminatorHltPatterns.push_back(discriminatorHltNameMatcher.AddPattern(discriminatorByHltName->first));
+		}
 		tauID = ToTauID(settings.GetTauID());
 		oldTauDMs = settings.GetTauUseOldDMs();
 
@@ -233,6 +255,14 @@ public:
 			}
 		}
 		
+		// the HLT paths do not depend on the tau
+		std::vector<char> discriminatorHltMatches(discriminatorHltPatterns.size());
+		for (size_t discriminatorHltPattern = 0; discriminatorHltPattern < discriminatorHltPatterns.size(); ++discriminatorHltPattern)
+		{
+			discriminatorHltMatches[discriminatorHltPattern] = discriminatorHltNameMatcher.MatchesAny(discriminatorHltPatterns[discriminatorHltPattern],
+			                                                                                          product.m_selectedHltNames);
+		}
+		
 		for (std::vector<KTau*>::iterator tau = taus.begin(); tau != taus.end(); ++tau)
 		{
 			bool validTau = true;
@@ -247,14 +277,11 @@ public:
 				}
 			}
 			
+			std::vector<char>::const_iterator discriminatorHltMatch = discriminatorHltMatches.begin();
 			for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
-				 validTau && (discriminatorByHltName != discriminatorsByHltName.end()); ++discriminatorByHltName)
+				 validTau && (discriminatorByHltName != discriminatorsByHltName.end()); ++discriminatorByHltName, ++discriminatorHltMatch)
 			{
-				bool hasMatch = false;
-				for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-					hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(discriminatorByHltName->first, boost::regex::icase | boost::regex::extended));
-
-				if ((discriminatorByHltName->first == "default") || hasMatch)
+				if ((discriminatorByHltName->first == "default") || *discriminatorHltMatch)
 				{
 					validTau = validTau && ApplyDiscriminators(*tau, discriminatorByHltName->second, event);
 				}
@@ -298,6 +325,8 @@ private:
 	
 	std::map<size_t, std::vector<std::string> > discriminatorsByIndex;
 	std::map<std::string, std::vector<std::string> > discriminatorsByHltName;
+	TriggerNameMatcher discriminatorHltNameMatcher;
+	std::vector<size_t> discriminatorHltPatterns;
 	
 	bool ApplyDiscriminators(KTau* tau, std::vector<std::string> const& discriminators,
 	                         KappaEvent const& event) const
@@ -2,6 +2,7 @@
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 #include "Artus/Utility/interface/Utility.h"
+#include "Artus/Utility/interface/DeltaRMatcher.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
@@ -215,10 +216,14 @@ class ZProducerBase : public KappaProducerBase
 
 			if(pf_candidate_collection != nullptr)
 			{
+				// only one or two queries per event: a linear scan is cheaper than sorting the candidates for a DeltaRMatcher
+				double maxDeltaR2 = double(settings.GetdeltaRTolleranceForPF()) * double(settings.GetdeltaRTolleranceForPF());
 				for(unsigned int i = 0; i < pf_candidate_collection->size(); i++)
 				{
-					if(ROOT::Math::VectorUtil::DeltaR(reference_lepton->p4,pf_candidate_collection->at(i)->p4) < settings.GetdeltaRTolleranceForPF()
-						&& std::abs(reference_lepton->p4.Pt() - pf_candidate_collection->at(i)->p4.Pt()) < settings.GetPtTolleranceForPF())
+					if(settings.GetdeltaRTolleranceForPF() > 0.0f
+						&& std::abs(reference_lepton->p4.Pt() - pf_candidate_collection->at(i)->p4.Pt()) < settings.GetPtTolleranceForPF()
+						&& DeltaRMatcher::DeltaR2(reference_lepton->p4.Eta(), reference_lepton->p4.Phi(),
+						                          pf_candidate_collection->at(i)->p4.Eta(), pf_candidate_collection->at(i)->p4.Phi()) < maxDeltaR2)
 							return pf_candidate_collection->at(i);
 				}
 				return nullptr;
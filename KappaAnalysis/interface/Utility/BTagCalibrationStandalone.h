@@ -140,19 +140,71 @@ protected:
 #define BTagCalibrationReader_H
 
 /**
- * BTagCalibrationReader
+ * BTagFormula
  *
- * Helper class to pull out a specific set of BTagEntry's out of a
- * BTagCalibration. TF1 functions are set up at initialization time.
+ * Formula string of a BTagEntry compiled into a small stack machine program
+ * depending on x. Supported are numbers, x, + - * / ^, comparisons, && ||,
+ * the ternary operator (as produced by th1ToFormula*) and the common
+ * mathematical functions. Formulas without x are folded into a constant.
+ * Compiled formulas are compared with a TF1 at the ends of their range, at
+ * their constants within the range (the bin edges of step formulas) and in
+ * the middle between them. Anything else, or a formula differing from the TF1, is
+ * evaluated by the TF1 as before. A default-constructed formula is 0.
  *
  ************************************************************/
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <TF1.h>
 
 
+class BTagFormula
+{
+public:
+	BTagFormula() {}
+	BTagFormula(const std::string &formula, double xMin, double xMax);
+
+	double Eval(double x) const;
+
+	static const size_t maxStackDepth = 64;
+
+protected:
+	enum OpCode {
+		OP_CONST, OP_X,
+		OP_NEG, OP_NOT,
+		OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,
+		OP_LT, OP_LE, OP_GT, OP_GE, OP_EQ, OP_NE, OP_AND, OP_OR,
+		OP_JUMP, OP_JUMP_IF_FALSE,
+		OP_LOG, OP_LOG10, OP_EXP, OP_SQRT, OP_ABS, OP_ERF,
+		OP_MIN, OP_MAX,
+	};
+	struct Instruction {
+		OpCode opCode;
+		double constant;
+		size_t jump;
+	};
+	class Compiler;
+
+	std::vector<Instruction> program;
+	std::shared_ptr<TF1> fallback;
+};
+
+
+/**
+ * BTagCalibrationReader
+ *
+ * Helper class to pull out a specific set of BTagEntry's out of a
+ * BTagCalibration. Formulas are compiled at initialization time.
+ *
+ * Several systematic types can be read at once; for each flavour, the
+ * (eta, pt, discr) bin boundaries of all entries define a grid of cells
+ * which stores the first matching entry per systematic type, so that an
+ * evaluation needs one binary search per axis.
+ *
+ ************************************************************/
+
 class BTagCalibrationReader
 {
 public:
@@ -161,29 +213,42 @@ public:
 	                      BTagEntry::OperatingPoint op,
 	                      std::string measurementType="comb",
 	                      std::string sysType="central");
+	BTagCalibrationReader(const BTagCalibration* c,
+	                      BTagEntry::OperatingPoint op,
+	                      std::string measurementType,
+	                      std::vector<std::string> const& sysTypes);
 	~BTagCalibrationReader() {}
 
+	// evaluates the first systematic type
 	double eval(BTagEntry::JetFlavor jf,
 	            float eta,
 	            float pt,
 	            float discr=0.) const;
 
+	// evaluates all systematic types in the order given to the constructor
+	void eval(BTagEntry::JetFlavor jf,
+	          float eta,
+	          float pt,
+	          float discr,
+	          double* values) const;
+
 protected:
-	struct TmpEntry {
-		float etaMin;
-		float etaMax;
-		float ptMin;
-		float ptMax;
-		float discrMin;
-		float discrMax;
-		TF1 func;
+	struct FlavourIndex {
+		std::vector<float> etaEdges;
+		std::vector<float> ptEdges;
+		std::vector<float> discrEdges;
+		std::vector<int> cells;  // formula index per cell and systematic type, -1 if none
+		std::vector<bool> hasEntries;  // per systematic type
+		std::vector<bool> useAbsEta;  // per systematic type
 	};
 	void setupTmpData(const BTagCalibration* c);
+	size_t findCell(const FlavourIndex &index, float eta, float pt, float discr) const;
+	double evalCell(const FlavourIndex &index, size_t cell, size_t sys, float pt, float discr) const;
 
 	BTagEntry::Parameters params;
-	std::map<BTagEntry::JetFlavor, std::vector<TmpEntry> > tmpData_;
-	std::vector<bool> useAbsEta;
+	std::vector<std::string> sysTypes_;
+	std::vector<BTagFormula> formulas_;
+	std::map<BTagEntry::JetFlavor, FlavourIndex> index_;
 };
 
 #endif  // BTagCalibrationReader_H
-
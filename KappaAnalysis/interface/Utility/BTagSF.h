@@ -34,10 +34,7 @@ private:
 	mutable TRandom3 randm;
 	BTagCalibration calib;
 	TFile* effFile = nullptr;
+	// central, up and down scale factors are read at once
 	BTagCalibrationReader reader_mujets;
-	BTagCalibrationReader reader_mujets_up;
-	BTagCalibrationReader reader_mujets_do;
 	BTagCalibrationReader reader_incl;
-	BTagCalibrationReader reader_incl_up;
-	BTagCalibrationReader reader_incl_do;
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+
+/**
+   \brief Matches HLT path and filter names against the regular expressions of the settings
+
+   The patterns are compiled once, when they are added (case insensitive, extended syntax).
+   The results of matching a name against a pattern are cached, since the names only change
+   with the trigger menu.
+*/
+class TriggerNameMatcher
+{
+public:
+
+	/// returns the index of the pattern, which is compiled if it is not yet known
+	size_t AddPattern(std::string const& pattern);
+
+	bool Matches(size_t patternIndex, std::string const& name) const;
+
+	/// true, if one of the names matches the pattern
+	bool MatchesAny(size_t patternIndex, std::vector<std::string> const& names) const;
+
+private:
+	std::map<std::string, size_t> m_patternIndices;
+	std::vector<boost::regex> m_patterns;
+
+	mutable std::vector<std::unordered_map<std::string, bool> > m_results;
+};
+
@@ -4,11 +4,13 @@
 #include "Artus/Utility/interface/ArtusLogging.h"
 
 #include <algorithm>
-
-#include <boost/regex.hpp>
+#include <cstdint>
+#include <limits>
+#include <utility>
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 
+#include "Artus/KappaAnalysis/interface/Utility/TriggerNameMatcher.h"
 #include "Artus/Utility/interface/Utility.h"
 
 
@@ -34,85 +36,224 @@ public:
 	}
 
 	virtual void Init(setting_type const& settings) {
-		lowerPtCutsByIndex = Utility::ParseMapTypes<size_t, float>(Utility::ParseVectorToMap((settings.*GetLowerPtCuts)()),
-		                                                           lowerPtCutsByHltName);
-		upperAbsEtaCutsByIndex = Utility::ParseMapTypes<size_t, float>(Utility::ParseVectorToMap((settings.*GetUpperAbsEtaCuts)()),
-		                                                               upperAbsEtaCutsByHltName);
+		std::map<std::string, std::vector<float> > lowerPtCutsByHltName;
+		std::map<size_t, std::vector<float> > lowerPtCutsByIndex = Utility::ParseMapTypes<size_t, float>(
+				Utility::ParseVectorToMap((settings.*GetLowerPtCuts)()), lowerPtCutsByHltName);
+		std::map<std::string, std::vector<float> > upperAbsEtaCutsByHltName;
+		std::map<size_t, std::vector<float> > upperAbsEtaCutsByIndex = Utility::ParseMapTypes<size_t, float>(
+				Utility::ParseVectorToMap((settings.*GetUpperAbsEtaCuts)()), upperAbsEtaCutsByHltName);
+
+		// only the tightest cut of each index or HLT name is relevant
+		lowerPtCutByIndex.clear();
+		for (std::map<size_t, std::vector<float> >::const_iterator lowerPtCuts = lowerPtCutsByIndex.begin();
+		     lowerPtCuts != lowerPtCutsByIndex.end(); ++lowerPtCuts)
+		{
+			lowerPtCutByIndex[lowerPtCuts->first] = *std::max_element(lowerPtCuts->second.begin(), lowerPtCuts->second.end());
+		}
+		upperAbsEtaCutByIndex.clear();
+		for (std::map<size_t, std::vector<float> >::const_iterator upperAbsEtaCuts = upperAbsEtaCutsByIndex.begin();
+		     upperAbsEtaCuts != upperAbsEtaCutsByIndex.end(); ++upperAbsEtaCuts)
+		{
+			upperAbsEtaCutByIndex[upperAbsEtaCuts->first] = *std::min_element(upperAbsEtaCuts->second.begin(), upperAbsEtaCuts->second.end());
+		}
+
+		// the default cuts apply to all objects, the HLT name patterns are compiled once
+		// and each one is represented by a bit of the masks of the HLT paths
+		nHltPatterns = 0;
+		lowerPtCut = -std::numeric_limits<float>::infinity();
+		lowerPtCutsByHltPattern.clear();
+		for (std::map<std::string, std::vector<float> >::const_iterator lowerPtCuts = lowerPtCutsByHltName.begin();
+		     lowerPtCuts != lowerPtCutsByHltName.end(); ++lowerPtCuts)
+		{
+			float cut = *std::max_element(lowerPtCuts->second.begin(), lowerPtCuts->second.end());
+			if (lowerPtCuts->first == "default")
+			{
+				lowerPtCut = std::max(lowerPtCut, cut);
+			}
+			else
+			{
+				size_t hltPattern = hltNameMatcher.AddPattern(lowerPtCuts->first);
+				nHltPatterns = std::max(nHltPatterns, hltPattern + 1);
+				lowerPtCutsByHltPattern.push_back(std::make_pair(hltPattern, cut));
+			}
+		}
+		upperAbsEtaCut = std::numeric_limits<float>::infinity();
+		upperAbsEtaCutsByHltPattern.clear();
+		for (std::map<std::string, std::vector<float> >::const_iterator upperAbsEtaCuts = upperAbsEtaCutsByHltName.begin();
+		     upperAbsEtaCuts != upperAbsEtaCutsByHltName.end(); ++upperAbsEtaCuts)
+		{
+			float cut = *std::min_element(upperAbsEtaCuts->second.begin(), upperAbsEtaCuts->second.end());
+			if (upperAbsEtaCuts->first == "default")
+			{
+				upperAbsEtaCut = std::min(upperAbsEtaCut, cut);
+			}
+			else
+			{
+				size_t hltPattern = hltNameMatcher.AddPattern(upperAbsEtaCuts->first);
+				nHltPatterns = std::max(nHltPatterns, hltPattern + 1);
+				upperAbsEtaCutsByHltPattern.push_back(std::make_pair(hltPattern, cut));
+			}
+		}
+		if (nHltPatterns > 64)
+		{
+			LOG(FATAL) << "Kinematic cuts for at most 64 different HLT paths are supported, " << nHltPatterns << " are configured!";
+		}
+		hltPatternMasksInput = -1;
+		hltPatternMasksRun = std::numeric_limits<unsigned int>::max();
+		hltPatternMasksLumi = std::numeric_limits<unsigned int>::max();
+		hltPatternMasksLumiInfo = nullptr;
+		hltPatternMasks.clear();
 	}
 
 
 protected:
+
+	/// true, if the cuts are read by the given getters
+	bool ReadsKinematicCuts(std::vector<std::string>& (setting_type::*getLowerPtCuts)(void) const,
+	                        std::vector<std::string>& (setting_type::*getUpperAbsEtaCuts)(void) const) const
+	{
+		return ((GetLowerPtCuts == getLowerPtCuts) && (GetUpperAbsEtaCuts == getUpperAbsEtaCuts));
+	}
 	
 	bool PassKinematicCuts(TPhysicsObject* physicsObject, event_type const& event, product_type& product) const
 	{
-		bool validObject = true;
-		
-		for (std::map<size_t, std::vector<float> >::const_iterator lowerPtCutByIndex = lowerPtCutsByIndex.begin();
-		     lowerPtCutByIndex != lowerPtCutsByIndex.end() && validObject; ++lowerPtCutByIndex)
+		float pt = physicsObject->p4.Pt();
+		float absEta = std::abs(physicsObject->p4.Eta());
+
+		if ((pt < lowerPtCut) || (absEta > upperAbsEtaCut))
+		{
+			return false;
+		}
+
+		// cuts by index apply to the object, which would be the next valid one
+		size_t index = (product.*m_validPhysicsObjectsMember).size();
+		std::map<size_t, float>::const_iterator lowerPtCutForIndex = lowerPtCutByIndex.find(index);
+		if ((lowerPtCutForIndex != lowerPtCutByIndex.end()) && (pt < lowerPtCutForIndex->second))
 		{
-			if ((physicsObject->p4.Pt() < *std::max_element(lowerPtCutByIndex->second.begin(), lowerPtCutByIndex->second.end()))
-			    && (lowerPtCutByIndex->first == (product.*m_validPhysicsObjectsMember).size()))
+			return false;
+		}
+		std::map<size_t, float>::const_iterator upperAbsEtaCutForIndex = upperAbsEtaCutByIndex.find(index);
+		if ((upperAbsEtaCutForIndex != upperAbsEtaCutByIndex.end()) && (absEta > upperAbsEtaCutForIndex->second))
+		{
+			return false;
+		}
+
+		if (lowerPtCutsByHltPattern.empty() && upperAbsEtaCutsByHltPattern.empty())
+		{
+			return true;
+		}
+
+		// patterns matching one of the selected HLT paths
+		uint64_t hltPatternMask = 0;
+		UpdateHltPatternMasks(event);
+		for (size_t hltIndex = 0; hltIndex < product.m_selectedHltNames.size(); ++hltIndex)
+		{
+			hltPatternMask |= GetHltPatternMask(product, hltIndex);
+		}
+
+		for (std::vector<std::pair<size_t, float> >::const_iterator lowerPtCutByHltPattern = lowerPtCutsByHltPattern.begin();
+		     lowerPtCutByHltPattern != lowerPtCutsByHltPattern.end(); ++lowerPtCutByHltPattern)
+		{
+			if ((pt < lowerPtCutByHltPattern->second) && (((hltPatternMask >> lowerPtCutByHltPattern->first) & 1) != 0))
 			{
-				validObject = false;
+				return false;
 			}
 		}
-		
-		for (std::map<size_t, std::vector<float> >::const_iterator upperAbsEtaCutByIndex = upperAbsEtaCutsByIndex.begin();
-		     upperAbsEtaCutByIndex != upperAbsEtaCutsByIndex.end() && validObject; ++upperAbsEtaCutByIndex)
+
+		for (std::vector<std::pair<size_t, float> >::const_iterator upperAbsEtaCutByHltPattern = upperAbsEtaCutsByHltPattern.begin();
+		     upperAbsEtaCutByHltPattern != upperAbsEtaCutsByHltPattern.end(); ++upperAbsEtaCutByHltPattern)
 		{
-			if (std::abs(physicsObject->p4.Eta()) > *std::min_element(upperAbsEtaCutByIndex->second.begin(), upperAbsEtaCutByIndex->second.end())
-			    && (upperAbsEtaCutByIndex->first == (product.*m_validPhysicsObjectsMember).size()))
+			if ((absEta > upperAbsEtaCutByHltPattern->second) && (((hltPatternMask >> upperAbsEtaCutByHltPattern->first) & 1) != 0))
 			{
-				validObject = false;
+				return false;
 			}
 		}
 
-		for (std::map<std::string, std::vector<float> >::const_iterator lowerPtCutByHltName = lowerPtCutsByHltName.begin();
-		     lowerPtCutByHltName != lowerPtCutsByHltName.end() && validObject; ++lowerPtCutByHltName)
+		return true;
+	}
+
+private:
+
+	/// match the HLT paths of a new lumi section against the patterns
+	/// (files of a chain can share run and lumi section, but have different HLT menus)
+	void UpdateHltPatternMasks(event_type const& event) const
+	{
+		if ((event.m_input == hltPatternMasksInput) &&
+		    (event.m_eventInfo->nRun == hltPatternMasksRun) && (event.m_eventInfo->nLumi == hltPatternMasksLumi) &&
+		    (event.m_lumiInfo == hltPatternMasksLumiInfo))
+		{
+			return;
+		}
+		hltPatternMasksInput = event.m_input;
+		hltPatternMasksRun = event.m_eventInfo->nRun;
+		hltPatternMasksLumi = event.m_eventInfo->nLumi;
+		hltPatternMasksLumiInfo = event.m_lumiInfo;
+
+		hltPatternMasks.clear();
+		if (event.m_lumiInfo == nullptr)
 		{
-			bool hasMatch = false;
-			for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-				hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(lowerPtCutByHltName->first, boost::regex::icase | boost::regex::extended));
+			return;
+		}
 
-			if ((physicsObject->p4.Pt() < *std::max_element(lowerPtCutByHltName->second.begin(), lowerPtCutByHltName->second.end()))
-			    && (lowerPtCutByHltName->first == "default" || hasMatch)
-			   )
+		hltPatternMasks.assign(event.m_lumiInfo->hltNames.size(), 0);
+		for (size_t hltPosition = 0; hltPosition < event.m_lumiInfo->hltNames.size(); ++hltPosition)
+		{
+			for (size_t hltPattern = 0; hltPattern < nHltPatterns; ++hltPattern)
 			{
-				validObject = false;
+				if (hltNameMatcher.Matches(hltPattern, event.m_lumiInfo->hltNames[hltPosition]))
+				{
+					hltPatternMasks[hltPosition] |= (uint64_t(1) << hltPattern);
+				}
 			}
 		}
+	}
 
-		for (std::map<std::string, std::vector<float> >::const_iterator upperAbsEtaCutByHltName = upperAbsEtaCutsByHltName.begin();
-		     upperAbsEtaCutByHltName != upperAbsEtaCutsByHltName.end() && validObject; ++upperAbsEtaCutByHltName)
+	/// bits of the patterns matching the selected HLT path with the given index,
+	/// the name is matched directly, if its position is not covered by the masks
+	uint64_t GetHltPatternMask(product_type const& product, size_t hltIndex) const
+	{
+		if (hltIndex < product.m_selectedHltPositions.size())
 		{
-			bool hasMatch = false;
-			for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-				hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(upperAbsEtaCutByHltName->first, boost::regex::icase | boost::regex::extended));
-
-			if ((std::abs(physicsObject->p4.Eta()) > *std::min_element(upperAbsEtaCutByHltName->second.begin(), upperAbsEtaCutByHltName->second.end()))
-			    &&
-			    (
-			    	(upperAbsEtaCutByHltName->first == "default") || hasMatch
-			    )
-			   )
+			int hltPosition = product.m_selectedHltPositions[hltIndex];
+			if ((hltPosition >= 0) && (static_cast<size_t>(hltPosition) < hltPatternMasks.size()))
 			{
-				validObject = false;
+				return hltPatternMasks[hltPosition];
 			}
 		}
 
-		return validObject;
+		uint64_t hltPatternMask = 0;
+		for (size_t hltPattern = 0; hltPattern < nHltPatterns; ++hltPattern)
+		{
+			if (hltNameMatcher.Matches(hltPattern, product.m_selectedHltNames[hltIndex]))
+			{
+				hltPatternMask |= (uint64_t(1) << hltPattern);
+			}
+		}
+		return hltPatternMask;
 	}
 
-
-private:
 	std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const;
 	std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const;
 	std::vector<TPhysicsObject*> product_type::*m_validPhysicsObjectsMember;
 
-	std::map<size_t, std::vector<float> > lowerPtCutsByIndex;
-	std::map<std::string, std::vector<float> > lowerPtCutsByHltName;
-	std::map<size_t, std::vector<float> > upperAbsEtaCutsByIndex;
-	std::map<std::string, std::vector<float> > upperAbsEtaCutsByHltName;
+	// tightest cuts, prepared in Init
+	std::map<size_t, float> lowerPtCutByIndex;
+	std::map<size_t, float> upperAbsEtaCutByIndex;
+	float lowerPtCut;
+	float upperAbsEtaCut;
+
+	// cuts by the index of their HLT name pattern, which is the bit in the masks of the HLT paths
+	TriggerNameMatcher hltNameMatcher;
+	size_t nHltPatterns = 0;
+	std::vector<std::pair<size_t, float> > lowerPtCutsByHltPattern;
+	std::vector<std::pair<size_t, float> > upperAbsEtaCutsByHltPattern;
+
+	// bits of the matching patterns by the position of the HLT path in the current lumi section
+	mutable long hltPatternMasksInput = -1;
+	mutable unsigned int hltPatternMasksRun = std::numeric_limits<unsigned int>::max();
+	mutable unsigned int hltPatternMasksLumi = std::numeric_limits<unsigned int>::max();
+	mutable KLumiInfo const* hltPatternMasksLumiInfo = nullptr;
+	mutable std::vector<uint64_t> hltPatternMasks;
 
 };
 
@@ -0,0 +1,79 @@
+
+#include <memory>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <TFile.h>
+
+#include "Artus/Core/interface/OutputWriter.h"
+#include "Artus/KappaAnalysis/interface/Consumers/EventIndexConsumer.h"
+
+
+std::string EventIndexConsumer::GetConsumerId() const
+{
+	return "EventIndexConsumer";
+}
+
+bool EventIndexConsumer::GetInputCollections(std::vector<std::string> & collectionNames) const
+{
+	collectionNames.push_back("EventMetadata");
+	return true;
+}
+
+void EventIndexConsumer::Init(setting_type const& settings)
+{
+	ConsumerBase<KappaTypes>::Init(settings);
+
+	m_outputFileName = settings.GetEventIndexFile();
+	if (m_outputFileName.empty())
+	{
+		m_outputFileName = settings.GetRootOutFile()->GetName();
+		if (boost::algorithm::ends_with(m_outputFileName, ".root"))
+		{
+			m_outputFileName = m_outputFileName.substr(0, m_outputFileName.size() - 5);
+		}
+		m_outputFileName += "_" + settings.GetName() + "_eventindex.root";
+	}
+}
+
+void EventIndexConsumer::ProcessEvent(event_type const& event, product_type const& product,
+                                      setting_type const& settings, FilterResult& result)
+{
+	if (event.m_inputFileName != m_inputFileName)
+	{
+		m_inputFileName = event.m_inputFileName;
+		m_inputFileIndex = m_eventIndex.AddFile(m_inputFileName);
+	}
+
+	m_eventIndex.Add(event.m_eventInfo->nRun, event.m_eventInfo->nLumi, event.m_eventInfo->nEvent,
+	                 m_inputFileIndex, event.m_inputEntry);
+}
+
+bool EventIndexConsumer::IsMergeable() const
+{
+	return true;
+}
+
+void EventIndexConsumer::Merge(ConsumerBase<KappaTypes> & other, setting_type const& settings)
+{
+	m_eventIndex.Merge(static_cast<EventIndexConsumer&>(other).m_eventIndex);
+}
+
+void EventIndexConsumer::Finish(setting_type const& settings)
+{
+	std::unique_lock<std::mutex> outputLock = OutputWriter::GetInstance().LockOutput();
+
+	TDirectory* tmpDirectory = gDirectory;
+	std::unique_ptr<TFile> outputFile(new TFile(m_outputFileName.c_str(), "RECREATE"));
+	gDirectory = tmpDirectory;
+	if (outputFile->IsZombie())
+	{
+		LOG(FATAL) << "Cannot create event index file \"" << m_outputFileName << "\"!";
+	}
+
+	m_eventIndex.Write(outputFile.get());
+	outputFile->Close();
+	LOG(INFO) << "Event index of " << m_eventIndex.GetSize() << " events in " << m_eventIndex.GetFiles().size()
+	          << " files written to \"" << m_outputFileName << "\".";
+}
+
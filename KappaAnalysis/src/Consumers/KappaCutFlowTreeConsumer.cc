@@ -2,6 +2,12 @@
 #include "Artus/KappaAnalysis/interface/Consumers/KappaCutFlowTreeConsumer.h"
 
 
+bool KappaCutFlowTreeConsumer::GetInputCollections(std::vector<std::string> & collectionNames) const
+{
+	collectionNames.push_back("EventMetadata");
+	return true;
+}
+
 void KappaCutFlowTreeConsumer::Init(KappaSettings const& settings)
 {
 	CutFlowTreeConsumer<KappaTypes>::Init(settings);
@@ -0,0 +1,174 @@
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "Artus/Core/interface/OutputWriter.h"
+#include "Artus/KappaAnalysis/interface/Consumers/KappaSkimConsumer.h"
+
+
+std::string KappaSkimConsumer::GetConsumerId() const
+{
+	return "KappaSkimConsumer";
+}
+
+bool KappaSkimConsumer::GetInputCollections(std::vector<std::string> & collectionNames) const
+{
+	return true;
+}
+
+void KappaSkimConsumer::Init(setting_type const& settings)
+{
+	ConsumerBase<KappaTypes>::Init(settings);
+
+	m_outputFileName = settings.GetSkimOutputFile();
+	if (m_outputFileName.empty())
+	{
+		m_outputFileName = settings.GetRootOutFile()->GetName();
+		if (boost::algorithm::ends_with(m_outputFileName, ".root"))
+		{
+			m_outputFileName = m_outputFileName.substr(0, m_outputFileName.size() - 5);
+		}
+		m_outputFileName += "_" + settings.GetName() + "_skim.root";
+	}
+}
+
+void KappaSkimConsumer::ProcessEvent(event_type const& event, product_type const& product,
+                                     setting_type const& settings, FilterResult& result)
+{
+	// the metadata of input files without selected events is needed for the normalisation
+	if (event.m_inputFileName != m_inputFileName)
+	{
+		SubmitInputFile();
+		m_inputFileName = event.m_inputFileName;
+		m_eventsTreeName = event.m_eventsTreeName;
+		m_metadataTreeNames = { event.m_lumisTreeName, event.m_runsTreeName };
+	}
+
+	if (result.HasPassed())
+	{
+		m_selectedEntries.push_back(event.m_inputEntry);
+	}
+}
+
+void KappaSkimConsumer::Finish(setting_type const& settings)
+{
+	SubmitInputFile();
+
+	std::string eventsTreeName = m_eventsTreeName;
+	OutputWriter::GetInstance().Submit([this, eventsTreeName]() {
+		if (! m_outputFile)
+		{
+			LOG(WARNING) << "No input has been processed, the skim \"" << m_outputFileName << "\" is not written.";
+			return;
+		}
+		for (std::map<std::string, TTree*>::iterator outputTree = m_outputTrees.begin();
+		     outputTree != m_outputTrees.end(); ++outputTree)
+		{
+			outputTree->second->Write(outputTree->first.c_str(), TObject::kOverwrite);
+		}
+		LOG(INFO) << "Skim with " << m_outputTrees[eventsTreeName]->GetEntries() << " events written to \"" << m_outputFileName << "\".";
+		m_outputTrees.clear();
+		m_outputFile->Close();
+		m_outputFile.reset();
+	});
+	OutputWriter::GetInstance().Flush();
+}
+
+void KappaSkimConsumer::SubmitInputFile()
+{
+	if (m_inputFileName.empty())
+	{
+		return;
+	}
+
+	std::string inputFileName = m_inputFileName;
+	std::string eventsTreeName = m_eventsTreeName;
+	std::vector<std::string> metadataTreeNames = m_metadataTreeNames;
+	std::vector<long long> entries;
+	entries.swap(m_selectedEntries);
+	OutputWriter::GetInstance().Submit([this, inputFileName, eventsTreeName, metadataTreeNames, entries]() {
+		CopyInputFile(inputFileName, eventsTreeName, metadataTreeNames, entries);
+	});
+	m_inputFileName.clear();
+}
+
+void KappaSkimConsumer::CopyInputFile(std::string const& inputFileName, std::string const& eventsTreeName,
+                                      std::vector<std::string> const& metadataTreeNames, std::vector<long long> const& entries)
+{
+	// the file is opened again, since the event provider does not read all branches
+	std::unique_ptr<TFile> inputFile(TFile::Open(inputFileName.c_str(), "READ"));
+	if ((! inputFile) || inputFile->IsZombie())
+	{
+		LOG(FATAL) << "Cannot open input file \"" << inputFileName << "\" for the skim!";
+	}
+
+	if (! m_outputFile)
+	{
+		// keep the compression of the input, such that the baskets can be copied
+		TDirectory* tmpDirectory = gDirectory;
+		m_outputFile.reset(new TFile(m_outputFileName.c_str(), "RECREATE", "", inputFile->GetCompressionSettings()));
+		if (m_outputFile->IsZombie())
+		{
+			LOG(FATAL) << "Cannot create skim output file \"" << m_outputFileName << "\"!";
+		}
+		LOG(INFO) << "Skim output file \"" << m_outputFileName << "\" created.";
+		gDirectory = tmpDirectory;
+	}
+
+	TTree* events = dynamic_cast<TTree*>(inputFile->Get(eventsTreeName.c_str()));
+	if (events == nullptr)
+	{
+		LOG(FATAL) << "Input file \"" << inputFileName << "\" does not contain the tree \"" << eventsTreeName << "\"!";
+	}
+	CopyTree(events, entries, (static_cast<long long>(entries.size()) == events->GetEntries()));
+
+	for (std::vector<std::string>::const_iterator metadataTreeName = metadataTreeNames.begin();
+	     metadataTreeName != metadataTreeNames.end(); ++metadataTreeName)
+	{
+		TTree* metadataTree = dynamic_cast<TTree*>(inputFile->Get(metadataTreeName->c_str()));
+		if (metadataTree != nullptr)
+		{
+			CopyTree(metadataTree, std::vector<long long>(), true);
+		}
+		else
+		{
+			LOG(WARNING) << "Input file \"" << inputFileName << "\" does not contain the tree \"" << *metadataTreeName
+			             << "\", which is therefore missing in the skim \"" << m_outputFileName << "\".";
+		}
+	}
+
+	inputFile->Close();
+}
+
+void KappaSkimConsumer::CopyTree(TTree* inputTree, std::vector<long long> const& entries, bool allEntries)
+{
+	TTree*& outputTree = m_outputTrees[inputTree->GetName()];
+	if (outputTree == nullptr)
+	{
+		TDirectory* tmpDirectory = gDirectory;
+		m_outputFile->cd();
+		outputTree = inputTree->CloneTree(0);
+		outputTree->SetDirectory(m_outputFile.get());
+		gDirectory = tmpDirectory;
+	}
+	else
+	{
+		inputTree->CopyAddresses(outputTree);
+	}
+
+	if (allEntries)
+	{
+		outputTree->CopyEntries(inputTree, -1, "fast");
+	}
+	else
+	{
+		for (std::vector<long long>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+		{
+			inputTree->GetEntry(*entry);
+			outputTree->Fill();
+		}
+	}
+
+	// the buffers belong to the input tree, which is deleted with its file
+	inputTree->CopyAddresses(outputTree, true);
+}
+
@@ -9,6 +9,11 @@ std::string BeamScrapingFilter::GetFilterId() const {
 	return "BeamScrapingFilter";
 }
 
+bool BeamScrapingFilter::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("TrackSummary");
+	return true;
+}
+
 void BeamScrapingFilter::Init(setting_type const& settings)
 {
 	FilterBase<KappaTypes>::Init(settings);
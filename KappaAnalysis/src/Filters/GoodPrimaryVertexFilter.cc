@@ -9,6 +9,11 @@ std::string GoodPrimaryVertexFilter::GetFilterId() const {
 	return "GoodPrimaryVertexFilter";
 }
 
+bool GoodPrimaryVertexFilter::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("VertexSummary");
+	return true;
+}
+
 void GoodPrimaryVertexFilter::Init(setting_type const& settings)
 {
 	FilterBase<KappaTypes>::Init(settings);
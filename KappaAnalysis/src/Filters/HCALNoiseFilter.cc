@@ -9,6 +9,11 @@ std::string HCALNoiseFilter::GetFilterId() const {
 	return "HCALNoiseFilter";
 }
 
+bool HCALNoiseFilter::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("HCALNoiseSummary");
+	return true;
+}
+
 void HCALNoiseFilter::Init(setting_type const& settings)
 {
 	FilterBase<KappaTypes>::Init(settings);
@@ -11,6 +11,11 @@
 		return "JsonFilter";
 	}
 
+	bool JsonFilter::GetInputCollections(std::vector<std::string> & collectionNames) const {
+		collectionNames.push_back("EventMetadata");
+		return true;
+	}
+
 	void JsonFilter::Init(KappaSettings const& settings)
 	{
 		FilterBase<KappaTypes>::Init(settings);
@@ -4,6 +4,32 @@ std::string RunLumiEventFilter::GetFilterId() const {
 	return "RunLumiEventFilter";
 }
 
+bool RunLumiEventFilter::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("EventMetadata");
+	return true;
+}
+
+void RunLumiEventFilter::Init(KappaSettings const& settings)
+{
+	FilterBase<KappaTypes>::Init(settings);
+
+	m_matchTuples = settings.GetMatchRunLumiEventTuples();
+	if (m_matchTuples)
+	{
+		m_tupleWhitelist.Build(settings.GetRunWhitelist(), settings.GetLumiWhitelist(), settings.GetEventWhitelist());
+		m_tupleBlacklist.Build(settings.GetRunBlacklist(), settings.GetLumiBlacklist(), settings.GetEventBlacklist());
+	}
+	else
+	{
+		m_runWhitelist.Build(settings.GetRunWhitelist());
+		m_runBlacklist.Build(settings.GetRunBlacklist());
+		m_lumiWhitelist.Build(settings.GetLumiWhitelist());
+		m_lumiBlacklist.Build(settings.GetLumiBlacklist());
+		m_eventWhitelist.Build(settings.GetEventWhitelist());
+		m_eventBlacklist.Build(settings.GetEventBlacklist());
+	}
+}
+
 bool RunLumiEventFilter::DoesEventPass(KappaEvent const& event, KappaProduct const& product,
                                        KappaSettings const& settings) const 
 {
@@ -11,43 +37,16 @@ bool RunLumiEventFilter::DoesEventPass(KappaEvent const& event, KappaProduct con
 	
 	bool match = false;
 	
-	if (settings.GetMatchRunLumiEventTuples())
+	if (m_matchTuples)
 	{
-		match = true;
-		for (size_t index = 0; index < std::min(std::min(settings.GetRunBlacklist().size(),
-		                                                 settings.GetLumiBlacklist().size()),
-		                                        settings.GetEventBlacklist().size()); ++index)
-		{
-			if ((event.m_eventInfo->nRun == settings.GetRunBlacklist()[index]) &&
-			    (event.m_eventInfo->nLumi == settings.GetLumiBlacklist()[index]) &&
-			    (event.m_eventInfo->nEvent == settings.GetEventBlacklist()[index]))
-			{
-				match = false;
-				break;
-			}
-		}
-		if (match)
-		{
-			match = false;
-			for (size_t index = 0; index < std::min(std::min(settings.GetRunWhitelist().size(),
-			                                                 settings.GetLumiWhitelist().size()),
-			                                        settings.GetEventWhitelist().size()); ++index)
-			{
-				if ((event.m_eventInfo->nRun == settings.GetRunWhitelist()[index]) &&
-					(event.m_eventInfo->nLumi == settings.GetLumiWhitelist()[index]) &&
-					(event.m_eventInfo->nEvent == settings.GetEventWhitelist()[index]))
-				{
-					match = true;
-					break;
-				}
-			}
-		}
+		match = ((! m_tupleBlacklist.Contains(event.m_eventInfo->nRun, event.m_eventInfo->nLumi, event.m_eventInfo->nEvent)) &&
+		         m_tupleWhitelist.Contains(event.m_eventInfo->nRun, event.m_eventInfo->nLumi, event.m_eventInfo->nEvent));
 	}
 	else
 	{
-		match = (MatchWhiteBlackLists(event.m_eventInfo->nRun, settings.GetRunWhitelist(), settings.GetRunBlacklist()) &&
-		         MatchWhiteBlackLists(event.m_eventInfo->nLumi, settings.GetLumiWhitelist(), settings.GetLumiBlacklist()) &&
-		         MatchWhiteBlackLists(event.m_eventInfo->nEvent, settings.GetEventWhitelist(), settings.GetEventBlacklist()));
+		match = (MatchWhiteBlackLists(event.m_eventInfo->nRun, m_runWhitelist, m_runBlacklist) &&
+		         MatchWhiteBlackLists(event.m_eventInfo->nLumi, m_lumiWhitelist, m_lumiBlacklist) &&
+		         MatchWhiteBlackLists(event.m_eventInfo->nEvent, m_eventWhitelist, m_eventBlacklist));
 	}
 	if (match)
 	{
@@ -59,13 +58,13 @@ bool RunLumiEventFilter::DoesEventPass(KappaEvent const& event, KappaProduct con
 	return match;
 }
 
-bool RunLumiEventFilter::MatchWhiteBlackLists(uint64_t item, std::vector<uint64_t> const& whitelist, std::vector<uint64_t> const& blacklist) const
+bool RunLumiEventFilter::MatchWhiteBlackLists(uint64_t item, IntervalSet const& whitelist, IntervalSet const& blacklist) const
 {
-	if ((whitelist.size() > 0) && (std::find(whitelist.begin(), whitelist.end(), item) == whitelist.end()))
+	if ((! whitelist.IsEmpty()) && (! whitelist.Contains(item)))
 	{
 		return false;
 	}
-	if ((blacklist.size() > 0) && (std::find(blacklist.begin(), blacklist.end(), item) != blacklist.end()))
+	if ((! blacklist.IsEmpty()) && blacklist.Contains(item))
 	{
 		return false;
 	}
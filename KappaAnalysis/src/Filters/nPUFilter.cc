@@ -4,6 +4,11 @@ std::string nPUFilter::GetFilterId() const {
 	return "nPUFilter";
 }
 
+bool nPUFilter::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("EventMetadata");
+	return true;
+}
+
 bool nPUFilter::DoesEventPass(KappaEvent const& event, KappaProduct const& product,
                                        KappaSettings const& settings) const 
 {
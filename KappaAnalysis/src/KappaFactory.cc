@@ -71,6 +71,8 @@
 #include "Artus/KappaAnalysis/interface/Consumers/PrintHltConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/PrintEventsConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/PrintGenParticleDecayTreeConsumer.h"
+#include "Artus/KappaAnalysis/interface/Consumers/KappaSkimConsumer.h"
+#include "Artus/KappaAnalysis/interface/Consumers/EventIndexConsumer.h"
 #include "Artus/Consumer/interface/RunTimeConsumer.h"
 #include "Artus/Consumer/interface/RunTimeConsumer.h"
 
@@ -357,6 +359,10 @@ ConsumerBaseUntemplated * KappaFactory::createConsumer ( std::string const& id )
 		return new PrintGenParticleDecayTreeConsumer();
 	else if(id == PrintEventsConsumer().GetConsumerId())
 		return new PrintEventsConsumer();
+	else if(id == KappaSkimConsumer().GetConsumerId())
+		return new KappaSkimConsumer();
+	else if(id == EventIndexConsumer().GetConsumerId())
+		return new EventIndexConsumer();
 	else if(id == RunTimeConsumer<KappaTypes>().GetConsumerId())
 		return new RunTimeConsumer<KappaTypes>();
 	else
@@ -0,0 +1,8 @@
+
+#include "Artus/KappaAnalysis/interface/KappaStaticPipelines.h"
+
+
+template class StaticPipeline<KappaTypes,
+                              ValidMuonsProducer<KappaTypes>,
+                              MinMuonsCountFilter,
+                              KappaLambdaNtupleConsumer<KappaTypes> >;
@@ -6,6 +6,18 @@ std::string CrossSectionWeightProducer::GetProducerId() const
 	return "CrossSectionWeightProducer";
 }
 
+bool CrossSectionWeightProducer::GetInputCollections(std::vector<std::string> & collectionNames) const
+{
+	collectionNames.push_back("LumiMetadata");
+	return true;
+}
+
+bool CrossSectionWeightProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const
+{
+	settingNames.push_back("CrossSection");
+	return true;
+}
+
 void CrossSectionWeightProducer::Produce( KappaEvent const& event,
 			KappaProduct & product,
 			KappaSettings const& settings) const
@@ -6,6 +6,19 @@ std::string ElectronCorrectionsProducer::GetProducerId() const {
 	return "ElectronCorrectionsProducer";
 }
 
+bool ElectronCorrectionsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCorrections
+	if (typeid(*this) != typeid(ElectronCorrectionsProducer))
+	{
+		return false;
+	}
+	settingNames.push_back("CorrectOnlyRealElectrons");
+	settingNames.push_back("UseUWGenMatching");
+	settingNames.push_back("RecoElectronMatchingGenParticleMatchAllElectrons");
+	settingNames.push_back("MatchAllElectronsGenTau");
+	return true;
+}
+
 void ElectronCorrectionsProducer::Init(setting_type const& settings)
 {
 	KappaProducerBase::Init(settings);
@@ -9,6 +9,10 @@ std::string EventWeightProducer::GetProducerId() const {
 	return "EventWeightProducer";
 }
 
+bool EventWeightProducer::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	return true;
+}
+
 EventWeightProducer::~EventWeightProducer()
 {
 	if (! m_weightNames.empty())
@@ -29,11 +29,15 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 
 	if (m_DeltaRMatchingRecoJetGenParticle > 0.0f)
 	{
+		DeltaRMatcher partonMatcher;
+		std::vector<KGenParticle*> partons;
+		FillPartons(event, partonMatcher, partons);
+
 		// loop over all valid objects (jets) to check
 		for (std::vector<KBasicJet*>::iterator validJet = product.m_validJets.begin();
 			 validJet != product.m_validJets.end();)
 		{
-			KGenParticle* matchedParticle = Match(event, product, settings, static_cast<KLV*>(*validJet));
+			KGenParticle* matchedParticle = Match(event, product, settings, static_cast<KLV*>(*validJet), partonMatcher, partons);
 			if (matchedParticle != nullptr)
 			{
 				product.m_genParticleMatchedJets[*validJet] = matchedParticle;
@@ -62,23 +66,21 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 	}
 }
 
-// This is the actual reco jet gen particle matcher
 KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event, product_type const& product,
                                                         setting_type const& settings, KLV* const recoJet) const
 {
-	float deltaR = 0.0;
-	size_t nMatchingAlgoPartons = 0;
-	size_t nMatchingPhysPartons = 0;
-	KGenParticle* hardestPhysParton = nullptr;
-	KGenParticle* hardestParton = nullptr;
-	KGenParticle* hardestBQuark = nullptr;
-	KGenParticle* hardestCQuark = nullptr;
+	DeltaRMatcher partonMatcher;
+	std::vector<KGenParticle*> partons;
+	FillPartons(event, partonMatcher, partons);
+	return Match(event, product, settings, recoJet, partonMatcher, partons);
+}
 
-	// loop over all genParticles 
+void RecoJetGenParticleMatchingProducer::FillPartons(event_type const& event, DeltaRMatcher& partonMatcher, std::vector<KGenParticle*>& partons)
+{
+	// only use genParticles with id 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5
 	for (std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
 	     genParticle != event.m_genParticles->end(); ++genParticle)
 	{
-		// only use genParticles with id 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5
 		if ((std::abs(genParticle->pdgId) == 1) ||
 		    (std::abs(genParticle->pdgId) == 2) ||
 		    (std::abs(genParticle->pdgId) == 3) ||
@@ -86,52 +88,73 @@ KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event,
 		    (std::abs(genParticle->pdgId) == 5) ||
 		    (genParticle->pdgId) == 21)
 		{
-			deltaR = ROOT::Math::VectorUtil::DeltaR((recoJet)->p4, genParticle->p4);
-			if (deltaR < m_DeltaRMatchingRecoJetGenParticle)
-			{
-				// Algorithmic:
-				if (genParticle->status() != settings.GetRecoJetMatchingGenParticleStatus())
+			partonMatcher.Add(genParticle->p4);
+			partons.push_back(&(*genParticle));
+		}
+	}
+}
+
+// This is the actual reco jet gen particle matcher
+KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event, product_type const& product,
+                                                        setting_type const& settings, KLV* const recoJet,
+                                                        DeltaRMatcher const& partonMatcher, std::vector<KGenParticle*> const& partons) const
+{
+	size_t nMatchingAlgoPartons = 0;
+	size_t nMatchingPhysPartons = 0;
+	KGenParticle* hardestPhysParton = nullptr;
+	KGenParticle* hardestParton = nullptr;
+	KGenParticle* hardestBQuark = nullptr;
+	KGenParticle* hardestCQuark = nullptr;
+
+	// loop over all partons within the cone
+	std::vector<size_t> matchingPartonIndices;
+	partonMatcher.FindMatches(recoJet->p4, m_DeltaRMatchingRecoJetGenParticle, matchingPartonIndices);
+	for (std::vector<size_t>::const_iterator partonIndex = matchingPartonIndices.begin();
+	     partonIndex != matchingPartonIndices.end(); ++partonIndex)
+	{
+		KGenParticle* genParticle = partons[*partonIndex];
+
+		// Algorithmic:
+		if (genParticle->status() != settings.GetRecoJetMatchingGenParticleStatus())
+		{
+			++nMatchingAlgoPartons;
+			if (std::abs(genParticle->pdgId) == 5)
+			{ 
+				if (hardestBQuark == nullptr)
 				{
-					++nMatchingAlgoPartons;
-					if (std::abs(genParticle->pdgId) == 5)
-					{ 
-						if (hardestBQuark == nullptr)
-						{
-							hardestBQuark = &(*genParticle);
-						}
-						else if (genParticle->p4.Pt() > hardestBQuark->p4.Pt())
-						{
-							hardestBQuark = &(*genParticle);
-						}
-					}
-					else if (std::abs(genParticle->pdgId) == 4)
-					{ 
-						if (hardestCQuark == nullptr)
-						{
-							hardestCQuark = &(*genParticle);
-						}
-						else if (genParticle->p4.Pt() > hardestCQuark->p4.Pt())
-						{
-							hardestCQuark = &(*genParticle);
-						}
-					}
-					else if (hardestParton == nullptr)
-					{
-						hardestParton = &(*genParticle);
-					}
-					else if (genParticle->p4.Pt() > hardestParton->p4.Pt())
-					{
-						hardestParton = &(*genParticle);
-					}
+					hardestBQuark = &(*genParticle);
 				}
-
-				// Physics:
-				else
+				else if (genParticle->p4.Pt() > hardestBQuark->p4.Pt())
+				{
+					hardestBQuark = &(*genParticle);
+				}
+			}
+			else if (std::abs(genParticle->pdgId) == 4)
+			{ 
+				if (hardestCQuark == nullptr)
 				{
-					++nMatchingPhysPartons;
-					hardestPhysParton = &(*genParticle);
+					hardestCQuark = &(*genParticle);
 				}
-			} 
+				else if (genParticle->p4.Pt() > hardestCQuark->p4.Pt())
+				{
+					hardestCQuark = &(*genParticle);
+				}
+			}
+			else if (hardestParton == nullptr)
+			{
+				hardestParton = &(*genParticle);
+			}
+			else if (genParticle->p4.Pt() > hardestParton->p4.Pt())
+			{
+				hardestParton = &(*genParticle);
+			}
+		}
+
+		// Physics:
+		else
+		{
+			++nMatchingPhysPartons;
+			hardestPhysParton = &(*genParticle);
 		}
 	}
 
@@ -9,35 +9,32 @@ void GenTauJetProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
 	
-	LambdaNtupleConsumer<KappaTypes>::AddVFloatQuantity("genTauJetVisPt", [](KappaEvent const & event, KappaProduct const & product)
+	LambdaNtupleConsumer<KappaTypes>::AddVFloatQuantityInPlace("genTauJetVisPt", [](KappaEvent const & event, KappaProduct const & product, std::vector<float>& genTauJetPt)
 	{
-		std::vector<float> genTauJetPt;
+		genTauJetPt.clear();
 		for (typename std::vector<KGenJet*>::const_iterator genJet = (product.m_genTauJets).begin();
 		     genJet != (product.m_genTauJets).end(); ++genJet)
 		{
 			genTauJetPt.push_back((*genJet)->p4.Pt());
 		}
-		return genTauJetPt;
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddVFloatQuantity("genTauJetEta", [](KappaEvent const & event, KappaProduct const & product)
+	LambdaNtupleConsumer<KappaTypes>::AddVFloatQuantityInPlace("genTauJetEta", [](KappaEvent const & event, KappaProduct const & product, std::vector<float>& genTauJetEta)
 	{
-		std::vector<float> genTauJetEta;
+		genTauJetEta.clear();
 		for (typename std::vector<KGenJet*>::const_iterator genJet = (product.m_genTauJets).begin();
 		     genJet != (product.m_genTauJets).end(); ++genJet)
 		{
 			genTauJetEta.push_back((*genJet)->p4.Eta());
 		}
-		return genTauJetEta;
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddVIntQuantity("genTauJetDM", [](KappaEvent const & event, KappaProduct const & product)
+	LambdaNtupleConsumer<KappaTypes>::AddVIntQuantityInPlace("genTauJetDM", [](KappaEvent const & event, KappaProduct const & product, std::vector<int>& genTauJetDM)
 	{
-		std::vector<int> genTauJetDM;
+		genTauJetDM.clear();
 		for (typename std::vector<KGenJet*>::const_iterator genJet = (product.m_genTauJets).begin();
 		     genJet != (product.m_genTauJets).end(); ++genJet)
 		{
 			genTauJetDM.push_back((*genJet)->genTauDecayMode);
 		}
-		return genTauJetDM;
 	});
 }
 
@@ -6,6 +6,16 @@ std::string GeneratorWeightProducer::GetProducerId() const {
 	return "GeneratorWeightProducer";
 }
 
+bool GeneratorWeightProducer::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("EventMetadata");
+	return true;
+}
+
+bool GeneratorWeightProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	settingNames.push_back("GeneratorWeight");
+	return true;
+}
+
 void GeneratorWeightProducer::Produce(KappaEvent const& event,
 		KappaProduct& product,
 		KappaSettings const& settings) const
@@ -6,6 +6,12 @@ std::string HltProducer::GetProducerId() const {
 	return "HltProducer";
 }
 
+bool HltProducer::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("EventMetadata");
+	collectionNames.push_back("LumiMetadata");
+	return true;
+}
+
 void HltProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
@@ -15,9 +21,9 @@ void HltProducer::Init(KappaSettings const& settings)
 	{
 		return static_cast<int>(product.m_selectedHltNames.size());
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddVStringQuantity("selectedHltPaths", [](KappaEvent const& event, KappaProduct const& product)
+	LambdaNtupleConsumer<KappaTypes>::AddVStringQuantityInPlace("selectedHltPaths", [](KappaEvent const& event, KappaProduct const& product, std::vector<std::string>& selectedHltPaths)
 	{
-		return product.m_selectedHltNames;
+		selectedHltPaths = product.m_selectedHltNames;
 	});
 }
 
@@ -12,6 +12,16 @@ std::string JetCorrectionsProducer::GetProducerId() const {
 	return "JetCorrectionsProducer";
 }
 
+bool JetCorrectionsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCorrections
+	if (typeid(*this) != typeid(JetCorrectionsProducer))
+	{
+		return false;
+	}
+	AddJetCorrectionsSettingDependencies(settingNames);
+	return true;
+}
+
 
 TaggedJetCorrectionsProducer::TaggedJetCorrectionsProducer() :
 	JetCorrectionsProducerBase<KJet>(&KappaEvent::m_tjets,
@@ -23,3 +33,13 @@ std::string TaggedJetCorrectionsProducer::GetProducerId() const {
 	return "TaggedJetCorrectionsProducer";
 }
 
+bool TaggedJetCorrectionsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCorrections
+	if (typeid(*this) != typeid(TaggedJetCorrectionsProducer))
+	{
+		return false;
+	}
+	AddJetCorrectionsSettingDependencies(settingNames);
+	return true;
+}
+
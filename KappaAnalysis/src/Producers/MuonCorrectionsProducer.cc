@@ -22,6 +22,22 @@ std::string MuonCorrectionsProducer::GetProducerId() const {
 	return "MuonCorrectionsProducer";
 }
 
+bool MuonCorrectionsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCorrections
+	if (typeid(*this) != typeid(MuonCorrectionsProducer))
+	{
+		return false;
+	}
+	settingNames.push_back("InputIsData");
+	settingNames.push_back("MuonEnergyCorrection");
+	settingNames.push_back("MuonRochesterCorrectionsFile");
+	settingNames.push_back("CorrectOnlyRealMuons");
+	settingNames.push_back("UseUWGenMatching");
+	settingNames.push_back("RecoMuonMatchingGenParticleMatchAllMuons");
+	settingNames.push_back("MatchAllMuonsGenTau");
+	return true;
+}
+
 void MuonCorrectionsProducer::Init(KappaSettings const& settings) 
 {
 	KappaProducerBase::Init(settings);
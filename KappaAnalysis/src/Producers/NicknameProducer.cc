@@ -7,6 +7,15 @@ std::string NicknameProducer::GetProducerId() const {
 	return "NicknameProducer";
 }
 
+bool NicknameProducer::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	return true;
+}
+
+bool NicknameProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	settingNames.push_back("Nickname");
+	return true;
+}
+
 void NicknameProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
@@ -6,6 +6,15 @@ std::string NumberGeneratedEventsWeightProducer::GetProducerId() const {
 	return "NumberGeneratedEventsWeightProducer";
 }
 
+bool NumberGeneratedEventsWeightProducer::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	return true;
+}
+
+bool NumberGeneratedEventsWeightProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	settingNames.push_back("NumberGeneratedEvents");
+	return true;
+}
+
 void NumberGeneratedEventsWeightProducer::Produce(KappaEvent const& event,
                      KappaProduct & product,
                      KappaSettings const& settings) const
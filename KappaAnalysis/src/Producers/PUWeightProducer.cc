@@ -8,6 +8,11 @@ std::string PUWeightProducer::GetProducerId() const {
 	return "PUWeightProducer";
 }
 
+bool PUWeightProducer::GetInputCollections(std::vector<std::string> & collectionNames) const {
+	collectionNames.push_back("EventMetadata");
+	return true;
+}
+
 void PUWeightProducer::Init(KappaSettings const& settings) {
 	KappaProducerBase::Init(settings);
 
@@ -7,6 +7,19 @@ std::string TauCorrectionsProducer::GetProducerId() const {
 	return "TauCorrectionsProducer";
 }
 
+bool TauCorrectionsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCorrections
+	if (typeid(*this) != typeid(TauCorrectionsProducer))
+	{
+		return false;
+	}
+	settingNames.push_back("CorrectOnlyRealTaus");
+	settingNames.push_back("UseUWGenMatching");
+	settingNames.push_back("RecoTauMatchingGenParticleMatchAllTaus");
+	settingNames.push_back("MatchAllTausGenTau");
+	return true;
+}
+
 void TauCorrectionsProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
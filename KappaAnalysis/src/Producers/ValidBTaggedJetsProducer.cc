@@ -7,6 +7,28 @@ std::string ValidBTaggedJetsProducer::GetProducerId() const {
 	return "ValidBTaggedJetsProducer";
 }
 
+bool ValidBTaggedJetsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCriteria
+	if (typeid(*this) != typeid(ValidBTaggedJetsProducer))
+	{
+		return false;
+	}
+	settingNames.push_back("InputIsData");
+	settingNames.push_back("Year");
+	settingNames.push_back("BTaggedJetCombinedSecondaryVertexName");
+	settingNames.push_back("BTaggerWorkingPoints");
+	settingNames.push_back("BTaggedJetAbsEtaCut");
+	settingNames.push_back("PuJetIDFullDiscrName");
+	settingNames.push_back("ApplyBTagSF");
+	settingNames.push_back("BTagSFMethod");
+	settingNames.push_back("BTagScaleFactorFile");
+	settingNames.push_back("BTagEfficiencyFile");
+	settingNames.push_back("BTagWPs");
+	settingNames.push_back("BTagShift");
+	settingNames.push_back("BMistagShift");
+	return true;
+}
+
 void ValidBTaggedJetsProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
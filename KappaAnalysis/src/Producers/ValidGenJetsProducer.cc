@@ -19,6 +19,18 @@ std::string ValidGenJetsProducer::GetProducerId() const {
 	return "ValidGenJetsProducer";
 }
 
+bool ValidGenJetsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCriteria
+	if (typeid(*this) != typeid(ValidGenJetsProducer))
+	{
+		return false;
+	}
+	settingNames.push_back("GenJetLowerPtCuts");
+	settingNames.push_back("GenJetUpperAbsEtaCuts");
+	settingNames.push_back("JetLeptonLowerDeltaRCut");
+	return true;
+}
+
 void ValidGenJetsProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
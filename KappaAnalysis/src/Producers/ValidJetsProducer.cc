@@ -12,6 +12,16 @@ std::string ValidJetsProducer::GetProducerId() const {
 	return "ValidJetsProducer";
 }
 
+bool ValidJetsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCriteria
+	if (typeid(*this) != typeid(ValidJetsProducer))
+	{
+		return false;
+	}
+	AddValidJetsSettingDependencies(settingNames);
+	return true;
+}
+
 ValidTaggedJetsProducer::ValidTaggedJetsProducer() : ValidJetsProducerBase<KJet, KBasicJet>(&KappaEvent::m_tjets,
                                                                                         &KappaProduct::m_correctedTaggedJets,
                                                                                         &KappaProduct::m_validJets)
@@ -22,6 +32,22 @@ std::string ValidTaggedJetsProducer::GetProducerId() const {
 	return "ValidTaggedJetsProducer";
 }
 
+bool ValidTaggedJetsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings in AdditionalCriteria
+	if (typeid(*this) != typeid(ValidTaggedJetsProducer))
+	{
+		return false;
+	}
+	AddValidJetsSettingDependencies(settingNames);
+	settingNames.push_back("PuJetIDs");
+	settingNames.push_back("JetTaggerLowerCuts");
+	settingNames.push_back("JetTaggerUpperCuts");
+	settingNames.push_back("BTaggedJetCombinedSecondaryVertexName");
+	settingNames.push_back("BTaggedJetTrackCountingHighEffName");
+	settingNames.push_back("PuJetIDFullDiscrName");
+	return true;
+}
+
 void ValidTaggedJetsProducer::Init(KappaSettings const& settings)
 {
 	ValidJetsProducerBase<KJet, KBasicJet>::Init(settings);
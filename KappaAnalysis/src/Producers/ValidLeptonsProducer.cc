@@ -6,6 +6,11 @@ std::string ValidLeptonsProducer::GetProducerId() const {
 	return "ValidLeptonsProducer";
 }
 
+bool ValidLeptonsProducer::GetSettingDependencies(std::vector<std::string> & settingNames) const {
+	// derived producers can read further settings
+	return (typeid(*this) == typeid(ValidLeptonsProducer));
+}
+
 void ValidLeptonsProducer::Produce(KappaEvent const& event, KappaProduct& product,
                      KappaSettings const& settings) const
 {
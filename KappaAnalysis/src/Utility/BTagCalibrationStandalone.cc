@@ -1,8 +1,13 @@
 #include "Artus/KappaAnalysis/interface/Utility/BTagCalibrationStandalone.h"
 #include <iostream>
 #include <exception>
+#include <stdexcept>
 #include <algorithm>
 #include <sstream>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 
 BTagEntry::Parameters::Parameters(
@@ -362,73 +367,659 @@ std::string BTagCalibration::token(const BTagEntry::Parameters &par)
 
 
 
+// Recursive descent parser emitting the program in postfix order.
+// Operator precedence follows C++, as TFormula hands formulas to the interpreter.
+class BTagFormula::Compiler
+{
+public:
+	Compiler(const std::string &formula, std::vector<Instruction> &program):
+		str(formula), prog(program)
+	{
+	}
+
+	bool compile()
+	{
+		if (!ternary()) {
+			return false;
+		}
+		skipSpace();
+		return (pos == str.size()) && (depth == 1) && (maxDepth <= BTagFormula::maxStackDepth);
+	}
+
+	bool usesX = false;
+
+private:
+	void skipSpace()
+	{
+		while (pos < str.size() && isspace(str[pos])) {
+			++pos;
+		}
+	}
+
+	bool accept(const char* token)
+	{
+		skipSpace();
+		size_t length = strlen(token);
+		if (str.compare(pos, length, token) == 0) {
+			pos += length;
+			return true;
+		}
+		return false;
+	}
+
+	// accepts a single character operator that does not start a longer one
+	bool acceptSingle(char op, const char* notFollowedBy)
+	{
+		skipSpace();
+		if (pos < str.size() && str[pos] == op &&
+		    (pos+1 == str.size() || strchr(notFollowedBy, str[pos+1]) == nullptr)) {
+			++pos;
+			return true;
+		}
+		return false;
+	}
+
+	size_t emit(OpCode opCode, double constant=0.)
+	{
+		Instruction instruction;
+		instruction.opCode = opCode;
+		instruction.constant = constant;
+		instruction.jump = 0;
+		prog.push_back(instruction);
+
+		if (opCode == OP_CONST || opCode == OP_X) {
+			++depth;
+		}
+		else if (opCode == OP_JUMP_IF_FALSE || (opCode >= OP_ADD && opCode <= OP_OR) ||
+		         opCode == OP_MIN || opCode == OP_MAX) {
+			--depth;
+		}
+		maxDepth = std::max(maxDepth, depth);
+		return prog.size() - 1;
+	}
+
+	bool ternary()
+	{
+		if (!logicalOr()) {
+			return false;
+		}
+		if (!accept("?")) {
+			return true;
+		}
+		size_t jumpToElse = emit(OP_JUMP_IF_FALSE);
+		if (!ternary() || !accept(":")) {
+			return false;
+		}
+		size_t jumpToEnd = emit(OP_JUMP);
+		--depth;  // only one of both branches leaves its value on the stack
+		prog[jumpToElse].jump = prog.size();
+		if (!ternary()) {
+			return false;
+		}
+		prog[jumpToEnd].jump = prog.size();
+		return true;
+	}
+
+	bool logicalOr()
+	{
+		if (!logicalAnd()) {
+			return false;
+		}
+		while (accept("||")) {
+			if (!logicalAnd()) {
+				return false;
+			}
+			emit(OP_OR);
+		}
+		return true;
+	}
+
+	bool logicalAnd()
+	{
+		if (!equality()) {
+			return false;
+		}
+		while (accept("&&")) {
+			if (!equality()) {
+				return false;
+			}
+			emit(OP_AND);
+		}
+		return true;
+	}
+
+	bool equality()
+	{
+		if (!relation()) {
+			return false;
+		}
+		while (true) {
+			OpCode opCode;
+			if (accept("==")) {
+				opCode = OP_EQ;
+			}
+			else if (accept("!=")) {
+				opCode = OP_NE;
+			}
+			else {
+				return true;
+			}
+			if (!relation()) {
+				return false;
+			}
+			emit(opCode);
+		}
+	}
+
+	bool relation()
+	{
+		if (!sum()) {
+			return false;
+		}
+		while (true) {
+			OpCode opCode;
+			if (accept("<=")) {
+				opCode = OP_LE;
+			}
+			else if (accept(">=")) {
+				opCode = OP_GE;
+			}
+			else if (acceptSingle('<', "<")) {
+				opCode = OP_LT;
+			}
+			else if (acceptSingle('>', ">")) {
+				opCode = OP_GT;
+			}
+			else {
+				return true;
+			}
+			if (!sum()) {
+				return false;
+			}
+			emit(opCode);
+		}
+	}
+
+	bool sum()
+	{
+		if (!product()) {
+			return false;
+		}
+		while (true) {
+			OpCode opCode;
+			if (acceptSingle('+', "+=")) {
+				opCode = OP_ADD;
+			}
+			else if (acceptSingle('-', "-=")) {
+				opCode = OP_SUB;
+			}
+			else {
+				return true;
+			}
+			if (!product()) {
+				return false;
+			}
+			emit(opCode);
+		}
+	}
+
+	bool product()
+	{
+		if (!unary()) {
+			return false;
+		}
+		while (true) {
+			OpCode opCode;
+			if (acceptSingle('*', "*=")) {
+				opCode = OP_MUL;
+			}
+			else if (acceptSingle('/', "=")) {
+				opCode = OP_DIV;
+			}
+			else {
+				return true;
+			}
+			if (!unary()) {
+				return false;
+			}
+			emit(opCode);
+		}
+	}
+
+	bool unary()
+	{
+		if (acceptSingle('-', "-=")) {
+			if (!unary()) {
+				return false;
+			}
+			emit(OP_NEG);
+			return true;
+		}
+		if (acceptSingle('+', "+=")) {
+			return unary();
+		}
+		if (acceptSingle('!', "=")) {
+			if (!unary()) {
+				return false;
+			}
+			emit(OP_NOT);
+			return true;
+		}
+		return power();
+	}
+
+	// TFormula translates "a^b" and "a**b" into pow(a, b)
+	bool power()
+	{
+		if (!primary()) {
+			return false;
+		}
+		if (accept("**") || accept("^")) {
+			if (!unary()) {
+				return false;
+			}
+			emit(OP_POW);
+		}
+		return true;
+	}
+
+	bool primary()
+	{
+		skipSpace();
+		if (pos == str.size()) {
+			return false;
+		}
+
+		if (isdigit(str[pos]) || str[pos] == '.') {
+			const char* begin = str.c_str() + pos;
+			char* end = nullptr;
+			double value = strtod(begin, &end);
+			if (end == begin) {
+				return false;
+			}
+			pos += (end - begin);
+			emit(OP_CONST, value);
+			return true;
+		}
+
+		if (accept("(")) {
+			return ternary() && accept(")");
+		}
+
+		if (isalpha(str[pos]) || str[pos] == '_') {
+			size_t begin = pos;
+			while (pos < str.size()) {
+				if (isalnum(str[pos]) || str[pos] == '_') {
+					++pos;
+				}
+				else if (str.compare(pos, 2, "::") == 0) {
+					pos += 2;
+				}
+				else {
+					break;
+				}
+			}
+			std::string name = str.substr(begin, pos - begin);
+			if (name == "x") {
+				accept("[0]");
+				usesX = true;
+				emit(OP_X);
+				return true;
+			}
+			return function(name);
+		}
+		return false;
+	}
+
+	bool function(const std::string &name)
+	{
+		static const std::map<std::string, OpCode> unaryFunctions = {
+			{"log", OP_LOG}, {"TMath::Log", OP_LOG},
+			{"log10", OP_LOG10}, {"TMath::Log10", OP_LOG10},
+			{"exp", OP_EXP}, {"TMath::Exp", OP_EXP},
+			{"sqrt", OP_SQRT}, {"TMath::Sqrt", OP_SQRT},
+			{"abs", OP_ABS}, {"fabs", OP_ABS}, {"TMath::Abs", OP_ABS},
+			{"erf", OP_ERF}, {"TMath::Erf", OP_ERF},
+		};
+		static const std::map<std::string, OpCode> binaryFunctions = {
+			{"pow", OP_POW}, {"TMath::Power", OP_POW},
+			{"min", OP_MIN}, {"TMath::Min", OP_MIN},
+			{"max", OP_MAX}, {"TMath::Max", OP_MAX},
+		};
+
+		auto unaryFunction = unaryFunctions.find(name);
+		auto binaryFunction = binaryFunctions.find(name);
+		if (unaryFunction != unaryFunctions.end()) {
+			if (!accept("(") || !ternary() || !accept(")")) {
+				return false;
+			}
+			emit(unaryFunction->second);
+			return true;
+		}
+		if (binaryFunction != binaryFunctions.end()) {
+			if (!accept("(") || !ternary() || !accept(",") || !ternary() || !accept(")")) {
+				return false;
+			}
+			emit(binaryFunction->second);
+			return true;
+		}
+		return false;
+	}
+
+	const std::string &str;
+	std::vector<Instruction> &prog;
+	size_t pos = 0;
+	size_t depth = 0;
+	size_t maxDepth = 0;
+};
+
+BTagFormula::BTagFormula(const std::string &formula, double xMin, double xMax)
+{
+	BTagFormula::Compiler compiler(formula, program);
+	if (!compiler.compile()) {
+		program.clear();
+		fallback = std::make_shared<TF1>("", formula.c_str(), xMin, xMax);
+		return;
+	}
+
+	// the compiled program is cross-checked with the TF1 at the ends of the range, at the constants within
+	// the range (e.g. the bin edges of step formulas) and in the middle between them
+	std::vector<double> edges = {xMin, xMax};
+	for (const Instruction &instruction : program) {
+		if (instruction.opCode == OP_CONST && instruction.constant > xMin && instruction.constant < xMax) {
+			edges.push_back(instruction.constant);
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	std::vector<double> checkPoints;
+	for (size_t edge = 0; edge < edges.size(); ++edge) {
+		checkPoints.push_back(edges[edge]);
+		if (edge + 1 < edges.size()) {
+			checkPoints.push_back(0.5 * (edges[edge] + edges[edge + 1]));
+		}
+	}
+
+	if (!compiler.usesX) {
+		double value = Eval(0.);
+		program.clear();
+		Instruction constant;
+		constant.opCode = OP_CONST;
+		constant.constant = value;
+		constant.jump = 0;
+		program.push_back(constant);
+	}
+
+	// in case of differences the TF1 is used
+	auto reference = std::make_shared<TF1>("", formula.c_str(), xMin, xMax);
+	for (double x : checkPoints) {
+		double value = Eval(x);
+		double referenceValue = reference->Eval(x);
+		bool differs = (std::isnan(value) || std::isnan(referenceValue)) ?
+		               (std::isnan(value) != std::isnan(referenceValue)) :
+		               (std::abs(value - referenceValue) > 1e-9 * std::max(1., std::abs(referenceValue)));
+		if (differs) {
+			std::cerr << "WARNING in BTagFormula: formula \"" << formula << "\" is evaluated by TF1, "
+			          << "since the compiled formula differs at x=" << x << std::endl;
+			program.clear();
+			fallback = reference;
+			return;
+		}
+	}
+}
+
+double BTagFormula::Eval(double x) const
+{
+	if (fallback) {
+		return fallback->Eval(x);
+	}
+	if (program.empty()) {
+		return 0.;
+	}
+	if (program.size() == 1 && program[0].opCode == OP_CONST) {
+		return program[0].constant;
+	}
+
+	double stack[maxStackDepth];
+	size_t top = 0;  // number of values on the stack
+	size_t pc = 0;
+	while (pc < program.size()) {
+		const Instruction &instruction = program[pc++];
+		switch (instruction.opCode) {
+		case OP_CONST: stack[top++] = instruction.constant; break;
+		case OP_X: stack[top++] = x; break;
+		case OP_NEG: stack[top-1] = -stack[top-1]; break;
+		case OP_NOT: stack[top-1] = (stack[top-1] == 0.) ? 1. : 0.; break;
+		case OP_ADD: --top; stack[top-1] += stack[top]; break;
+		case OP_SUB: --top; stack[top-1] -= stack[top]; break;
+		case OP_MUL: --top; stack[top-1] *= stack[top]; break;
+		case OP_DIV: --top; stack[top-1] /= stack[top]; break;
+		case OP_POW: --top; stack[top-1] = std::pow(stack[top-1], stack[top]); break;
+		case OP_LT: --top; stack[top-1] = (stack[top-1] < stack[top]) ? 1. : 0.; break;
+		case OP_LE: --top; stack[top-1] = (stack[top-1] <= stack[top]) ? 1. : 0.; break;
+		case OP_GT: --top; stack[top-1] = (stack[top-1] > stack[top]) ? 1. : 0.; break;
+		case OP_GE: --top; stack[top-1] = (stack[top-1] >= stack[top]) ? 1. : 0.; break;
+		case OP_EQ: --top; stack[top-1] = (stack[top-1] == stack[top]) ? 1. : 0.; break;
+		case OP_NE: --top; stack[top-1] = (stack[top-1] != stack[top]) ? 1. : 0.; break;
+		case OP_AND: --top; stack[top-1] = (stack[top-1] != 0. && stack[top] != 0.) ? 1. : 0.; break;
+		case OP_OR: --top; stack[top-1] = (stack[top-1] != 0. || stack[top] != 0.) ? 1. : 0.; break;
+		case OP_JUMP: pc = instruction.jump; break;
+		case OP_JUMP_IF_FALSE: if (stack[--top] == 0.) { pc = instruction.jump; } break;
+		case OP_LOG: stack[top-1] = std::log(stack[top-1]); break;
+		case OP_LOG10: stack[top-1] = std::log10(stack[top-1]); break;
+		case OP_EXP: stack[top-1] = std::exp(stack[top-1]); break;
+		case OP_SQRT: stack[top-1] = std::sqrt(stack[top-1]); break;
+		case OP_ABS: stack[top-1] = std::abs(stack[top-1]); break;
+		case OP_ERF: stack[top-1] = std::erf(stack[top-1]); break;
+		case OP_MIN: --top; stack[top-1] = std::min(stack[top-1], stack[top]); break;
+		case OP_MAX: --top; stack[top-1] = std::max(stack[top-1], stack[top]); break;
+		}
+	}
+	return stack[0];
+}
+
+
+
 BTagCalibrationReader::BTagCalibrationReader(const BTagCalibration* c,
 	                                           BTagEntry::OperatingPoint op,
 	                                           std::string measurementType,
 	                                           std::string sysType):
-	params(BTagEntry::Parameters(op, measurementType, sysType)),
-	useAbsEta(true)
+	BTagCalibrationReader(c, op, measurementType, std::vector<std::string>(1, sysType))
+{
+}
+
+BTagCalibrationReader::BTagCalibrationReader(const BTagCalibration* c,
+	                                           BTagEntry::OperatingPoint op,
+	                                           std::string measurementType,
+	                                           std::vector<std::string> const& sysTypes):
+	params(BTagEntry::Parameters(op, measurementType, sysTypes.empty() ? "central" : sysTypes[0])),
+	sysTypes_(sysTypes)
 {
 	setupTmpData(c);
 }
 
+// index of the bin [edges[i], edges[i+1]) containing x, npos if there is none
+static size_t findBin(const std::vector<float> &edges, float x)
+{
+	if (edges.empty() || !(edges.front() <= x && x < edges.back())) {
+		return std::string::npos;
+	}
+	return (std::upper_bound(edges.begin(), edges.end(), x) - edges.begin()) - 1;
+}
+
+size_t BTagCalibrationReader::findCell(const FlavourIndex &index,
+	                                     float eta,
+	                                     float pt,
+	                                     float discr) const
+{
+	size_t etaBin = findBin(index.etaEdges, eta);
+	size_t ptBin = findBin(index.ptEdges, pt);
+	size_t discrBin = 0;
+	if (params.operatingPoint == BTagEntry::OP_RESHAPING) {
+		discrBin = findBin(index.discrEdges, discr);
+	}
+	if (etaBin == std::string::npos || ptBin == std::string::npos || discrBin == std::string::npos) {
+		return std::string::npos;
+	}
+	size_t nDiscrBins = std::max(index.discrEdges.size(), size_t(2)) - 1;
+	return ((etaBin * (index.ptEdges.size() - 1)) + ptBin) * nDiscrBins + discrBin;
+}
+
+double BTagCalibrationReader::evalCell(const FlavourIndex &index,
+	                                     size_t cell,
+	                                     size_t sys,
+	                                     float pt,
+	                                     float discr) const
+{
+	if (cell == std::string::npos) {
+		return 0.;  // default value
+	}
+	int formula = index.cells[cell * sysTypes_.size() + sys];
+	if (formula < 0) {
+		return 0.;  // default value
+	}
+	bool use_discr = (params.operatingPoint == BTagEntry::OP_RESHAPING);
+	return formulas_[formula].Eval(use_discr ? discr : pt);
+}
+
 double BTagCalibrationReader::eval(BTagEntry::JetFlavor jf,
 	                                 float eta,
 	                                 float pt,
 	                                 float discr) const
 {
-	bool use_discr = (params.operatingPoint == BTagEntry::OP_RESHAPING);
-	if (useAbsEta[jf] && eta < 0) {
+	const FlavourIndex &index = index_.at(jf);
+	if (!index.hasEntries[0]) {
+		throw std::out_of_range("BTagCalibrationReader: no entries for this jet flavour");
+	}
+	if (index.useAbsEta[0] && eta < 0) {
 		eta = -eta;
 	}
+	return evalCell(index, findCell(index, eta, pt, discr), 0, pt, discr);
+}
 
-	// search linearly through eta, pt and discr ranges and eval
-	// future: find some clever data structure based on intervals
-	const std::vector<TmpEntry> &entries = tmpData_.at(jf);
-	for (unsigned i=0; i<entries.size(); ++i) {
-		const BTagCalibrationReader::TmpEntry &e = entries.at(i);
-		if (
-			e.etaMin <= eta && eta < e.etaMax                   // find eta
-			&& e.ptMin <= pt && pt < e.ptMax                    // check pt
-		){
-			if (use_discr) {                                    // discr. reshaping?
-				if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
-					return e.func.Eval(discr);
-				}
-			} else {
-				return e.func.Eval(pt);
+void BTagCalibrationReader::eval(BTagEntry::JetFlavor jf,
+	                               float eta,
+	                               float pt,
+	                               float discr,
+	                               double* values) const
+{
+	const FlavourIndex &index = index_.at(jf);
+	size_t signedEtaCell = std::string::npos;
+	size_t absEtaCell = std::string::npos;
+	bool signedEtaCellFound = false;
+	bool absEtaCellFound = false;
+	for (size_t sys = 0; sys < sysTypes_.size(); ++sys) {
+		if (!index.hasEntries[sys]) {
+			throw std::out_of_range("BTagCalibrationReader: no entries for this jet flavour");
+		}
+		if (index.useAbsEta[sys] && eta < 0) {
+			if (!absEtaCellFound) {
+				absEtaCell = findCell(index, -eta, pt, discr);
+				absEtaCellFound = true;
+			}
+			values[sys] = evalCell(index, absEtaCell, sys, pt, discr);
+		} else {
+			if (!signedEtaCellFound) {
+				signedEtaCell = findCell(index, eta, pt, discr);
+				signedEtaCellFound = true;
 			}
+			values[sys] = evalCell(index, signedEtaCell, sys, pt, discr);
 		}
 	}
-
-	return 0.;  // default value
 }
 
 void BTagCalibrationReader::setupTmpData(const BTagCalibration* c)
 {
-	useAbsEta = std::vector<bool>(4, true);
-	const std::vector<BTagEntry> &entries = c->getEntries(params);
-	for (unsigned i=0; i<entries.size(); ++i) {
-		const BTagEntry &be = entries[i];
-		BTagCalibrationReader::TmpEntry te;
-		te.etaMin = be.params.etaMin;
-		te.etaMax = be.params.etaMax;
-		te.ptMin = be.params.ptMin;
-		te.ptMax = be.params.ptMax;
-		te.discrMin = be.params.discrMin;
-		te.discrMax = be.params.discrMax;
-
-		if (params.operatingPoint == BTagEntry::OP_RESHAPING) {
-			te.func = TF1("", be.formula.c_str(),
-			              be.params.discrMin, be.params.discrMax);
-		} else {
-			te.func = TF1("", be.formula.c_str(),
-			              be.params.ptMin, be.params.ptMax);
+	bool use_discr = (params.operatingPoint == BTagEntry::OP_RESHAPING);
+	size_t nSys = sysTypes_.size();
+
+	// collect the entries per flavour and systematic type, keeping their order
+	std::map<BTagEntry::JetFlavor, std::vector<std::vector<const BTagEntry*> > > entriesByFlavour;
+	for (size_t sys = 0; sys < nSys; ++sys) {
+		BTagEntry::Parameters sysParams(params.operatingPoint, params.measurementType, sysTypes_[sys]);
+		const std::vector<BTagEntry> &entries = c->getEntries(sysParams);
+		for (unsigned i=0; i<entries.size(); ++i) {
+			std::vector<std::vector<const BTagEntry*> > &entriesBySys = entriesByFlavour[entries[i].params.jetFlavor];
+			entriesBySys.resize(nSys);
+			entriesBySys[sys].push_back(&entries[i]);
+		}
+	}
+
+	for (auto const& flavourEntries : entriesByFlavour) {
+		FlavourIndex &index = index_[flavourEntries.first];
+		index.hasEntries = std::vector<bool>(nSys, false);
+		index.useAbsEta = std::vector<bool>(nSys, true);
+
+		// entries with empty or invalid ranges never match and are left out of the grid
+		std::vector<std::vector<const BTagEntry*> > validEntriesBySys(nSys);
+		for (size_t sys = 0; sys < nSys; ++sys) {
+			for (const BTagEntry* be : flavourEntries.second[sys]) {
+				index.hasEntries[sys] = true;
+				if (be->params.etaMin < 0) {
+					index.useAbsEta[sys] = false;
+				}
+				if ((be->params.etaMin < be->params.etaMax) && (be->params.ptMin < be->params.ptMax) &&
+				    ((!use_discr) || (be->params.discrMin < be->params.discrMax))) {
+					validEntriesBySys[sys].push_back(be);
+					index.etaEdges.push_back(be->params.etaMin);
+					index.etaEdges.push_back(be->params.etaMax);
+					index.ptEdges.push_back(be->params.ptMin);
+					index.ptEdges.push_back(be->params.ptMax);
+					if (use_discr) {
+						index.discrEdges.push_back(be->params.discrMin);
+						index.discrEdges.push_back(be->params.discrMax);
+					}
+				}
+			}
+		}
+		for (std::vector<float>* edges : {&index.etaEdges, &index.ptEdges, &index.discrEdges}) {
+			std::sort(edges->begin(), edges->end());
+			edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
 		}
+		if (index.etaEdges.empty()) {
+			continue;
+		}
+
+		size_t nPtBins = index.ptEdges.size() - 1;
+		size_t nDiscrBins = std::max(index.discrEdges.size(), size_t(2)) - 1;
+		index.cells = std::vector<int>((index.etaEdges.size() - 1) * nPtBins * nDiscrBins * nSys, -1);
 
-		tmpData_[be.params.jetFlavor].push_back(te);
-		if (te.etaMin < 0) {
-			useAbsEta[be.params.jetFlavor] = false;
+		// the first entry covering a cell wins, as in a linear search
+		for (size_t sys = 0; sys < nSys; ++sys) {
+			for (const BTagEntry* be : validEntriesBySys[sys]) {
+				int formula = formulas_.size();
+				if (use_discr) {
+					formulas_.push_back(BTagFormula(be->formula, be->params.discrMin, be->params.discrMax));
+				} else {
+					formulas_.push_back(BTagFormula(be->formula, be->params.ptMin, be->params.ptMax));
+				}
+
+				size_t etaBegin = findBin(index.etaEdges, be->params.etaMin);
+				size_t etaEnd = findBin(index.etaEdges, be->params.etaMax);
+				size_t ptBegin = findBin(index.ptEdges, be->params.ptMin);
+				size_t ptEnd = findBin(index.ptEdges, be->params.ptMax);
+				size_t discrBegin = 0;
+				size_t discrEnd = 1;
+				if (use_discr) {
+					discrBegin = findBin(index.discrEdges, be->params.discrMin);
+					discrEnd = findBin(index.discrEdges, be->params.discrMax);
+				}
+				// upper edges equal to the last edge are outside of the bins
+				if (etaEnd == std::string::npos) etaEnd = index.etaEdges.size() - 1;
+				if (ptEnd == std::string::npos) ptEnd = nPtBins;
+				if (discrEnd == std::string::npos) discrEnd = nDiscrBins;
+
+				for (size_t etaBin = etaBegin; etaBin < etaEnd; ++etaBin) {
+					for (size_t ptBin = ptBegin; ptBin < ptEnd; ++ptBin) {
+						for (size_t discrBin = discrBegin; discrBin < discrEnd; ++discrBin) {
+							int &cell = index.cells[(((etaBin * nPtBins) + ptBin) * nDiscrBins + discrBin) * nSys + sys];
+							if (cell < 0) {
+								cell = formula;
+							}
+						}
+					}
+				}
+			}
 		}
 	}
 }
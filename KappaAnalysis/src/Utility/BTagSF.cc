@@ -46,77 +46,40 @@ void BTagSF::initBtagwp(std::string btagwp)
 	TDirectory *savedir(gDirectory);
 	TFile *savefile(gFile);
 
+	std::vector<std::string> sysTypes = {"central", "up", "down"};
+	BTagEntry::OperatingPoint operatingPoint = BTagEntry::OP_MEDIUM;
+	bool validBtagwp = true;
+
 	if (btagwp == std::string("medium"))
 	{
-		reader_mujets = BTagCalibrationReader(
-				&calib,				  // calibration instance
-				BTagEntry::OP_MEDIUM, // operating point
-				"comb",			  // measurement type
-				"central"			  // systematics type
-		);
-
-		reader_mujets_up = BTagCalibrationReader(&calib, BTagEntry::OP_MEDIUM, "comb", "up");	  // sys up
-		reader_mujets_do = BTagCalibrationReader(&calib, BTagEntry::OP_MEDIUM, "comb", "down");  // sys down
-
-		reader_incl = BTagCalibrationReader(
-				&calib,				  // calibration instance
-				BTagEntry::OP_MEDIUM, // operating point
-				"incl",				  // measurement type
-				"central"			  // systematics type
-		);
-
-		reader_incl_up = BTagCalibrationReader(&calib, BTagEntry::OP_MEDIUM, "incl", "up");	  // sys up
-		reader_incl_do = BTagCalibrationReader(&calib, BTagEntry::OP_MEDIUM, "incl", "down");  // sys down
+		operatingPoint = BTagEntry::OP_MEDIUM;
 	}
 	else if (btagwp == std::string("loose"))
 	{
-		reader_mujets = BTagCalibrationReader(
-				&calib,				 // calibration instance
-				BTagEntry::OP_LOOSE, // operating point
-				"comb",			 // measurement type
-				"central"			 // systematics type
-		);
-
-		reader_mujets_up = BTagCalibrationReader(&calib, BTagEntry::OP_LOOSE, "comb", "up");	 // sys up
-		reader_mujets_do = BTagCalibrationReader(&calib, BTagEntry::OP_LOOSE, "comb", "down");  // sys down
-
-		reader_incl = BTagCalibrationReader(
-				&calib,				 // calibration instance
-				BTagEntry::OP_LOOSE, // operating point
-				"incl",				 // measurement type
-				"central"			 // systematics type
-		);
-
-		reader_incl_up = BTagCalibrationReader(&calib, BTagEntry::OP_LOOSE, "incl", "up");	 // sys up
-		reader_incl_do = BTagCalibrationReader(&calib, BTagEntry::OP_LOOSE, "incl", "down");  // sys down
+		operatingPoint = BTagEntry::OP_LOOSE;
 	}
 	else if (btagwp == std::string("tight"))
 	{
-		reader_mujets = BTagCalibrationReader(
-				&calib,				 // calibration instance
-				BTagEntry::OP_TIGHT, // operating point
-				"comb",			 // measurement type
-				"central"			 // systematics type
-		);
-
-		reader_mujets_up = BTagCalibrationReader(&calib, BTagEntry::OP_TIGHT, "comb", "up");	 // sys up
-		reader_mujets_do = BTagCalibrationReader(&calib, BTagEntry::OP_TIGHT, "comb", "down");  // sys down
-
-		reader_incl = BTagCalibrationReader(
-				&calib,				 // calibration instance
-				BTagEntry::OP_TIGHT, // operating point
-				"incl",				 // measurement type
-				"central"			 // systematics type
-		);
-
-		reader_incl_up = BTagCalibrationReader(&calib, BTagEntry::OP_TIGHT, "incl", "up");	 // sys up
-		reader_incl_do = BTagCalibrationReader(&calib, BTagEntry::OP_TIGHT, "incl", "down");  // sys down
+		operatingPoint = BTagEntry::OP_TIGHT;
 	}
 	else
 	{
+		validBtagwp = false;
 		std::cout << "No valid btag-workingpoint specified" << std::endl;
 	}
 
+	if (validBtagwp)
+	{
+		reader_mujets = BTagCalibrationReader(
+				&calib,			// calibration instance
+				operatingPoint,	// operating point
+				"comb",			// measurement type
+				sysTypes		// systematics types
+		);
+
+		reader_incl = BTagCalibrationReader(&calib, operatingPoint, "incl", sysTypes);
+	}
+
 	gDirectory = savedir;
 	gFile = savefile;
 }
@@ -211,9 +174,11 @@ double BTagSF::getSFb(double pt, float eta, unsigned int btagsys, int year) cons
 				  pt = MinBJetPt;
 		}
 
-		double jet_scalefactor = reader_mujets.eval(BTagEntry::FLAV_B, std::abs(eta), pt);
-		double jet_scalefactor_up = reader_mujets_up.eval(BTagEntry::FLAV_B, std::abs(eta), pt);
-		double jet_scalefactor_do = reader_mujets_do.eval(BTagEntry::FLAV_B, std::abs(eta), pt);
+		double jet_scalefactors[3];  // central, up, down
+		reader_mujets.eval(BTagEntry::FLAV_B, std::abs(eta), pt, 0., jet_scalefactors);
+		double jet_scalefactor = jet_scalefactors[0];
+		double jet_scalefactor_up = jet_scalefactors[1];
+		double jet_scalefactor_do = jet_scalefactors[2];
 
 		if (DoubleUncertainty) {
 		  jet_scalefactor_up = 2*(jet_scalefactor_up - jet_scalefactor) + jet_scalefactor;
@@ -330,9 +295,11 @@ double BTagSF::getSFc(double pt, float eta, unsigned int btagsys, int year) cons
 	          pt = MinBJetPt;
 	}
 
-	double jet_scalefactor = reader_mujets.eval(BTagEntry::FLAV_C, std::abs(eta), pt);
-	double jet_scalefactor_up = reader_mujets_up.eval(BTagEntry::FLAV_C, std::abs(eta), pt);
-	double jet_scalefactor_do = reader_mujets_do.eval(BTagEntry::FLAV_C, std::abs(eta), pt);
+	double jet_scalefactors[3];  // central, up, down
+	reader_mujets.eval(BTagEntry::FLAV_C, std::abs(eta), pt, 0., jet_scalefactors);
+	double jet_scalefactor = jet_scalefactors[0];
+	double jet_scalefactor_up = jet_scalefactors[1];
+	double jet_scalefactor_do = jet_scalefactors[2];
 
 	if (DoubleUncertainty) {
 	  jet_scalefactor_up = 2*(jet_scalefactor_up - jet_scalefactor) + jet_scalefactor;
@@ -437,9 +404,11 @@ double BTagSF::getSFl(double pt, float eta, unsigned int mistagsys, int year) co
 	  pt = MaxLJetPt;
 	}
 
-	double jet_scalefactor = reader_incl.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt);
-	double jet_scalefactor_up = reader_incl_up.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt);
-	double jet_scalefactor_do = reader_incl_do.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt);
+	double jet_scalefactors[3];  // central, up, down
+	reader_incl.eval(BTagEntry::FLAV_UDSG, std::abs(eta), pt, 0., jet_scalefactors);
+	double jet_scalefactor = jet_scalefactors[0];
+	double jet_scalefactor_up = jet_scalefactors[1];
+	double jet_scalefactor_do = jet_scalefactors[2];
 
 	if (DoubleUncertainty) {
 	  jet_scalefactor_up = 2*(jet_scalefactor_up - jet_scalefactor) + jet_scalefactor;
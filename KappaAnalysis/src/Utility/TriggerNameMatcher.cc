@@ -0,0 +1,43 @@
+#include "Artus/KappaAnalysis/interface/Utility/TriggerNameMatcher.h"
+
+
+size_t TriggerNameMatcher::AddPattern(std::string const& pattern)
+{
+	std::map<std::string, size_t>::const_iterator patternIndex = m_patternIndices.find(pattern);
+	if (patternIndex != m_patternIndices.end())
+	{
+		return patternIndex->second;
+	}
+
+	m_patterns.push_back(boost::regex(pattern, boost::regex::icase | boost::regex::extended));
+	m_results.push_back(std::unordered_map<std::string, bool>());
+	m_patternIndices[pattern] = m_patterns.size() - 1;
+	return (m_patterns.size() - 1);
+}
+
+bool TriggerNameMatcher::Matches(size_t patternIndex, std::string const& name) const
+{
+	std::unordered_map<std::string, bool>& results = m_results[patternIndex];
+	std::unordered_map<std::string, bool>::const_iterator result = results.find(name);
+	if (result != results.end())
+	{
+		return result->second;
+	}
+
+	bool match = boost::regex_search(name, m_patterns[patternIndex]);
+	results[name] = match;
+	return match;
+}
+
+bool TriggerNameMatcher::MatchesAny(size_t patternIndex, std::vector<std::string> const& names) const
+{
+	for (std::vector<std::string>::const_iterator name = names.begin(); name != names.end(); ++name)
+	{
+		if (Matches(patternIndex, *name))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
@@ -8,6 +8,7 @@
 #include <TChain.h>
 
 #include "Artus/Core/interface/EventProviderBase.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
 
 template<class TTypes>
 class RootEventProvider: public EventProviderBase<TTypes> {
@@ -17,8 +18,11 @@ public:
 	typedef typename TTypes::product_type product_type;
 	typedef typename TTypes::setting_type setting_type;
 
+	/// with readInClusters, the events are processed in batches of one TTree cluster
 	RootEventProvider(std::vector<std::string> const& fileNames,
-			std::string const& treeName) {
+			std::string const& treeName, bool readInClusters = false) :
+		m_readInClusters(readInClusters)
+	{
 		m_rootChain.reset(new TChain(treeName.c_str()));
 
 		for (auto const& fname : fileNames) {
@@ -30,6 +34,26 @@ public:
 		return (m_rootChain->GetEntry(lEvent) != 0);
 	}
 
+	long long GetBatchEnd(long long lEvent) override {
+		if (! m_readInClusters)
+		{
+			return EventProviderBase<TTypes>::GetBatchEnd(lEvent);
+		}
+		return RootFileHelper::GetClusterEnd(m_rootChain.get(), lEvent);
+	}
+
+	bool LoadBatch(long long lFirstEvent, long long lEndEvent) override {
+		if (m_readInClusters)
+		{
+			long long localEntry = m_rootChain->LoadTree(lFirstEvent);
+			if ((localEntry >= 0) && (m_rootChain->GetTree() != nullptr))
+			{
+				RootFileHelper::LoadBaskets(m_rootChain->GetTree(), localEntry, localEntry + (lEndEvent - lFirstEvent));
+			}
+		}
+		return true;
+	}
+
 	event_type const& GetCurrentEvent() const override{
 		return m_event;
 	}
@@ -43,5 +67,6 @@ public:
 protected:
 	event_type m_event;
 	boost::scoped_ptr<TChain> m_rootChain;
+	bool m_readInClusters;
 };
 
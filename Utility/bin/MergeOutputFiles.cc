@@ -0,0 +1,220 @@
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <RVersion.h>
+#include <TClass.h>
+#include <TFile.h>
+#include <TFileMerger.h>
+#include <TKey.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+#include "boost/program_options.hpp"
+
+
+/// adds the numbers of entries of all trees in the directory and its subdirectories
+void CountTreeEntries(TDirectory* directory, std::string const& path, std::map<std::string, long long>& entries)
+{
+	// the keys are sorted by decreasing cycle numbers, only the latest cycle is counted
+	std::set<std::string> countedNames;
+	TIter nextKey(directory->GetListOfKeys());
+	while (TKey* key = static_cast<TKey*>(nextKey()))
+	{
+		if (! countedNames.insert(key->GetName()).second)
+		{
+			continue;
+		}
+
+		TClass* keyClass = TClass::GetClass(key->GetClassName());
+		if (keyClass == nullptr)
+		{
+			continue;
+		}
+
+		std::string objectPath = path + key->GetName();
+		if (keyClass->InheritsFrom(TDirectory::Class()))
+		{
+			CountTreeEntries(static_cast<TDirectory*>(key->ReadObj()), objectPath + "/", entries);
+		}
+		else if (keyClass->InheritsFrom(TTree::Class()))
+		{
+			TTree* tree = static_cast<TTree*>(key->ReadObj());
+			entries[objectPath] += tree->GetEntries();
+			delete tree;
+		}
+	}
+}
+
+bool CountTreeEntries(std::string const& fileName, std::map<std::string, long long>& entries)
+{
+	TFile* file = TFile::Open(fileName.c_str(), "READ");
+	if ((file == nullptr) || file->IsZombie())
+	{
+		std::cerr << "Cannot open file \"" << fileName << "\"!" << std::endl;
+		delete file;
+		return false;
+	}
+	CountTreeEntries(file, "", entries);
+	file->Close();
+	delete file;
+	return true;
+}
+
+/// the baskets of the trees are copied without decompressing them, if the compression settings
+/// of the input files and of the output file agree
+bool MergeFiles(std::vector<std::string> const& inputFiles, std::string const& outputFile, int compressionSettings)
+{
+	TFileMerger merger(false, false);
+	merger.SetFastMethod(true);
+	if (! merger.OutputFile(outputFile.c_str(), "RECREATE", compressionSettings))
+	{
+		std::cerr << "Cannot create file \"" << outputFile << "\"!" << std::endl;
+		return false;
+	}
+	for (std::vector<std::string>::const_iterator inputFile = inputFiles.begin(); inputFile != inputFiles.end(); ++inputFile)
+	{
+		if (! merger.AddFile(inputFile->c_str(), false))
+		{
+			std::cerr << "Cannot add file \"" << *inputFile << "\"!" << std::endl;
+			return false;
+		}
+	}
+	return merger.Merge();
+}
+
+
+int main(int argc, char* argv[]) {
+
+	std::vector<std::string> inputFiles;
+	std::string outputFile = "output.root";
+	size_t nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	boost::program_options::options_description help_config("Help");
+	help_config.add_options()
+		("help,h", "Show the help message");
+	boost::program_options::options_description config("Configuration");
+	config.add_options()
+		("input,i", boost::program_options::value<std::vector<std::string> >(&inputFiles)->multitoken(),
+		"Input files.")
+		("output,o", boost::program_options::value<std::string>(&outputFile)->default_value(outputFile),
+		"Output file.")
+		("threads,j", boost::program_options::value<size_t>(&nThreads)->default_value(nThreads),
+		"Number of threads merging parts of the input files in parallel.");
+
+	boost::program_options::variables_map vm;
+	boost::program_options::store(
+			boost::program_options::command_line_parser(argc, argv).options(help_config).allow_unregistered().run(),
+			vm
+	);
+	boost::program_options::notify(vm);
+	if (vm.count("help")) {
+		std::cout << config << std::endl;
+		return 1;
+	}
+	boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(config).run(), vm);
+	boost::program_options::notify(vm);
+
+	if (inputFiles.size() == 0)
+	{
+		return 0;
+	}
+
+	// expected numbers of entries of the merged trees
+	std::map<std::string, long long> inputEntries;
+	for (std::vector<std::string>::const_iterator inputFile = inputFiles.begin(); inputFile != inputFiles.end(); ++inputFile)
+	{
+		if (! CountTreeEntries(*inputFile, inputEntries))
+		{
+			return 1;
+		}
+	}
+
+	// keep the compression of the inputs, such that the baskets can be copied
+	TFile* firstInputFile = TFile::Open(inputFiles.front().c_str(), "READ");
+	int compressionSettings = firstInputFile->GetCompressionSettings();
+	firstInputFile->Close();
+	delete firstInputFile;
+
+	// each thread merges a contiguous part of the inputs into a temporary file,
+	// these are merged in the order of the inputs afterwards
+	size_t nParts = std::min(std::max(nThreads, size_t(1)), inputFiles.size() / 2);
+	bool success = true;
+	if (nParts <= 1)
+	{
+		success = MergeFiles(inputFiles, outputFile, compressionSettings);
+	}
+	else
+	{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+		ROOT::EnableThreadSafety();
+#endif
+		// no empty parts at the end
+		const size_t nFilesPerPart = (inputFiles.size() + nParts - 1) / nParts;
+		nParts = (inputFiles.size() + nFilesPerPart - 1) / nFilesPerPart;
+
+		std::vector<std::string> partFiles;
+		std::vector<char> partResults(nParts, 0);
+		std::vector<std::thread> threads;
+		for (size_t part = 0; part < nParts; ++part)
+		{
+			std::vector<std::string> partInputFiles(inputFiles.begin() + part * nFilesPerPart,
+			                                        inputFiles.begin() + std::min((part + 1) * nFilesPerPart, inputFiles.size()));
+			partFiles.push_back(outputFile + ".part" + std::to_string(part) + ".root");
+			std::string partFile = partFiles.back();
+			threads.push_back(std::thread([partInputFiles, partFile, compressionSettings, part, &partResults]() {
+				partResults[part] = MergeFiles(partInputFiles, partFile, compressionSettings);
+			}));
+		}
+		for (std::vector<std::thread>::iterator thread = threads.begin(); thread != threads.end(); ++thread)
+		{
+			thread->join();
+		}
+		success = (std::count(partResults.begin(), partResults.end(), 0) == 0);
+
+		if (success)
+		{
+			success = MergeFiles(partFiles, outputFile, compressionSettings);
+		}
+		for (std::vector<std::string>::const_iterator partFile = partFiles.begin(); partFile != partFiles.end(); ++partFile)
+		{
+			std::remove(partFile->c_str());
+		}
+	}
+
+	if (! success)
+	{
+		std::cerr << "Merging into \"" << outputFile << "\" failed!" << std::endl;
+		return 1;
+	}
+
+	// verify the numbers of entries
+	std::map<std::string, long long> outputEntries;
+	if (! CountTreeEntries(outputFile, outputEntries))
+	{
+		return 1;
+	}
+	if (outputEntries != inputEntries)
+	{
+		for (std::map<std::string, long long>::const_iterator tree = inputEntries.begin(); tree != inputEntries.end(); ++tree)
+		{
+			long long nOutputEntries = ((outputEntries.count(tree->first) > 0) ? outputEntries[tree->first] : 0);
+			if (nOutputEntries != tree->second)
+			{
+				std::cerr << "Tree \"" << tree->first << "\" has " << nOutputEntries << " entries instead of "
+				          << tree->second << "!" << std::endl;
+			}
+		}
+		return 1;
+	}
+
+	std::cout << "Merged " << inputFiles.size() << " files with " << inputEntries.size() << " trees into \""
+	          << outputFile << "\"." << std::endl;
+	return 0;
+}
@@ -7,6 +7,7 @@
 #define ELPP_DISABLE_TRACE_LOGS
 #define ELPP_DISABLE_DEFAULT_CRASH_HANDLING
 #define ELPP_STACKTRACE_ON_CRASH
+#define ELPP_THREAD_SAFE
 
 #include "Artus/Utility/interface/easylogging++.h"
 
@@ -16,12 +16,12 @@ public:
 	static CutRange UpperThresholdCut(double max);
 	static CutRange EqualsCut(double cut);
 	
-	bool IsInRange(double value);
+	bool IsInRange(double value) const;
 
 private:
 	double m_min, m_max, m_epsilon;
 	bool m_pointRange;
 
-	bool Equals(double valueA, double valueB);
+	bool Equals(double valueA, double valueB) const;
 };
 
@@ -0,0 +1,78 @@
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+   \brief Finds the candidates within a cone in (eta, phi) around a given direction.
+
+   The directions of the candidates are stored as (eta, phi) arrays sorted by eta, such that a
+   query only compares the candidates in the eta range of the cone. The distances are compared
+   as squared Delta R in double precision with the Delta phi wrapped into ]-pi, pi] as done in
+   ROOT::Math::VectorUtil. Candidates with an undefined eta never match and are not stored.
+   Matches are always reported in the order, in which the candidates have been added.
+*/
+class DeltaRMatcher
+{
+public:
+
+	void Clear();
+	void Reserve(size_t size);
+
+	/// the index of the candidate is given by the number of previously added candidates
+	void Add(float eta, float phi);
+
+	template<class TLorentzVector>
+	void Add(TLorentzVector const& p4)
+	{
+		Add(p4.Eta(), p4.Phi());
+	}
+
+	size_t GetSize() const;
+
+	/// index of the closest candidate with Delta R < maxDeltaR, -1 if there is none
+	/// in case of equal distances, the first added candidate is returned
+	int FindBestMatch(float eta, float phi, double maxDeltaR, float* deltaR=nullptr) const;
+
+	/// indices of all candidates with Delta R < maxDeltaR (ascending)
+	void FindMatches(float eta, float phi, double maxDeltaR, std::vector<size_t>& indices) const;
+
+	bool HasMatch(float eta, float phi, double maxDeltaR) const;
+
+	template<class TLorentzVector>
+	int FindBestMatch(TLorentzVector const& p4, double maxDeltaR, float* deltaR=nullptr) const
+	{
+		return FindBestMatch(p4.Eta(), p4.Phi(), maxDeltaR, deltaR);
+	}
+
+	template<class TLorentzVector>
+	void FindMatches(TLorentzVector const& p4, double maxDeltaR, std::vector<size_t>& indices) const
+	{
+		FindMatches(p4.Eta(), p4.Phi(), maxDeltaR, indices);
+	}
+
+	template<class TLorentzVector>
+	bool HasMatch(TLorentzVector const& p4, double maxDeltaR) const
+	{
+		return HasMatch(p4.Eta(), p4.Phi(), maxDeltaR);
+	}
+
+	static double DeltaR2(float eta1, float phi1, float eta2, float phi2);
+
+private:
+
+	/// sorts the candidates by eta, if candidates have been added since the last query
+	void Sort() const;
+
+	/// position of the first sorted candidate with an eta not below the given value
+	size_t LowerBound(double eta) const;
+
+	mutable std::vector<float> m_etas;
+	mutable std::vector<float> m_phis;
+	mutable std::vector<size_t> m_indices;
+	mutable bool m_sorted = true;
+	size_t m_size = 0;
+};
+
@@ -0,0 +1,62 @@
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <TDirectory.h>
+
+
+/**
+   \brief Sorted map from (run, lumi, event) to the input file and the entry in its Events tree.
+
+   The index is written by the EventIndexConsumer and read for replaying single events
+   (see the ReplayEventIndex and ReplayEvents settings). It is stored in two trees, EventIndex
+   with one entry per event and EventIndexFiles with the names of the input files.
+*/
+class EventIndex
+{
+public:
+
+	struct Entry
+	{
+		unsigned int run;
+		unsigned int lumi;
+		unsigned long long event;
+		int file;
+		long long entry;
+
+		/// ordered by (run, lumi, event)
+		bool operator<(Entry const& other) const;
+	};
+
+	/// returns the index of the file, which is added if it is not yet known
+	int AddFile(std::string const& fileName);
+	void Add(unsigned int run, unsigned int lumi, unsigned long long event, int file, long long entry);
+
+	/// adds all entries of another index
+	void Merge(EventIndex const& other);
+
+	void Write(TDirectory* directory);
+	bool Read(std::string const& fileName);
+
+	/// returns nullptr for events not contained in the index
+	Entry const* Find(unsigned int run, unsigned int lumi, unsigned long long event);
+
+	std::vector<std::string> const& GetFiles() const;
+	size_t GetSize() const;
+
+	/// parses events given as "run:lumi:event"
+	static bool ParseEvent(std::string const& eventId, unsigned int& run, unsigned int& lumi, unsigned long long& event);
+
+private:
+
+	void Sort();
+
+	std::vector<std::string> m_files;
+	std::map<std::string, int> m_fileIndices;
+	std::vector<Entry> m_entries;
+	bool m_sorted = true;
+};
+
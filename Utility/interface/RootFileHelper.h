@@ -11,6 +11,7 @@
 #include <TDirectory.h>
 #include <TFile.h>
 #include <TGraphErrors.h>
+#include <TTree.h>
 
 #include "KappaTools/Toolbox/interface/String.h"
 
@@ -257,4 +258,17 @@ public:
 	
 	static void WriteRootObject(TDirectory* directory, TObject* object, std::string path);
 
+	/// end (exclusive) of the cluster containing the entry, for chains only the clusters of the
+	/// tree containing the entry are considered, such that a cluster never spans several files
+	static long long GetClusterEnd(TTree* tree, long long entry);
+	/// read and decompress the baskets of all active branches containing the entries [firstEntry, endEntry)
+	/// of the tree, for chains the entries refer to the currently loaded tree (TChain::GetTree)
+	static void LoadBaskets(TTree* tree, long long firstEntry, long long endEntry);
+
+	/// ROOT compression settings (100 * algorithm + level) for an algorithm name ("ZLIB", "LZMA", "LZ4" or "ZSTD"),
+	/// -1 for an empty name, in which case the settings of the output file are kept
+	static int GetCompressionSettings(std::string const& algorithm, int level);
+	/// applies the compression settings to all existing branches of the tree, negative settings are ignored
+	static void SetCompressionSettings(TTree* tree, int compressionSettings);
+
 };
@@ -0,0 +1,61 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/**
+   \brief Set of (run, lumi, event) tuples with constant lookup time.
+
+   Run and lumi are packed into one 64 bit key, the keys are stored in an open-addressing hash
+   table with linear probing, which is filled at most to one half.
+*/
+class RunLumiEventSet
+{
+public:
+
+	/// the tuples are given by the entries with equal indices, surplus entries are ignored
+	void Build(std::vector<uint64_t> const& runs, std::vector<uint64_t> const& lumis, std::vector<uint64_t> const& events);
+
+	bool Contains(uint64_t run, uint64_t lumi, uint64_t event) const;
+
+	size_t GetSize() const;
+
+private:
+
+	struct Key
+	{
+		uint64_t runLumi;
+		uint64_t event;
+	};
+
+	static uint64_t Hash(uint64_t runLumi, uint64_t event);
+	size_t FindSlot(uint64_t runLumi, uint64_t event) const;
+
+	std::vector<Key> m_keys;
+	std::vector<char> m_occupied;
+	size_t m_mask = 0;
+	size_t m_size = 0;
+};
+
+
+/**
+   \brief Set of values stored as sorted, disjoint intervals of consecutive values.
+*/
+class IntervalSet
+{
+public:
+
+	void Build(std::vector<uint64_t> const& values);
+
+	bool Contains(uint64_t value) const;
+	bool IsEmpty() const;
+
+private:
+	/// closed intervals [first, second]
+	std::vector<std::pair<uint64_t, uint64_t> > m_intervals;
+};
+
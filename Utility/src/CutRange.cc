@@ -25,7 +25,7 @@ CutRange CutRange::EqualsCut(double cut)
 	return CutRange(cut, cut);
 }
 
-bool CutRange::IsInRange(double value)
+bool CutRange::IsInRange(double value) const
 {
 	bool isInRange = false;
 	if (m_pointRange) {
@@ -37,7 +37,7 @@ bool CutRange::IsInRange(double value)
 	return isInRange;
 }
 
-bool CutRange::Equals(double valueA, double valueB)
+bool CutRange::Equals(double valueA, double valueB) const
 {
 	double deltaOverMean = 2.0 * std::abs(valueA-valueB) / std::abs(valueA+valueB);
 	return (deltaOverMean < m_epsilon);
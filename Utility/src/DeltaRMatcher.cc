@@ -0,0 +1,160 @@
+#include "Artus/Utility/interface/DeltaRMatcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+void DeltaRMatcher::Clear()
+{
+	m_etas.clear();
+	m_phis.clear();
+	m_indices.clear();
+	m_sorted = true;
+	m_size = 0;
+}
+
+void DeltaRMatcher::Reserve(size_t size)
+{
+	m_etas.reserve(size);
+	m_phis.reserve(size);
+	m_indices.reserve(size);
+}
+
+void DeltaRMatcher::Add(float eta, float phi)
+{
+	size_t index = m_size++;
+
+	// would break the ordering by eta
+	if (std::isnan(eta))
+	{
+		return;
+	}
+
+	m_sorted = (m_sorted && (m_etas.empty() || (m_etas.back() <= eta)));
+	m_indices.push_back(index);
+	m_etas.push_back(eta);
+	m_phis.push_back(phi);
+}
+
+size_t DeltaRMatcher::GetSize() const
+{
+	return m_size;
+}
+
+int DeltaRMatcher::FindBestMatch(float eta, float phi, double maxDeltaR, float* deltaR) const
+{
+	Sort();
+
+	int bestIndex = -1;
+	double bestDeltaR2 = maxDeltaR * maxDeltaR;
+	if (maxDeltaR > 0.0)
+	{
+		double maxEta = eta + maxDeltaR;
+		for (size_t position = LowerBound(eta - maxDeltaR); (position < m_etas.size()) && (m_etas[position] <= maxEta); ++position)
+		{
+			double deltaR2 = DeltaR2(eta, phi, m_etas[position], m_phis[position]);
+			if ((deltaR2 < bestDeltaR2) || ((deltaR2 == bestDeltaR2) && (bestIndex >= 0) && (m_indices[position] < static_cast<size_t>(bestIndex))))
+			{
+				bestDeltaR2 = deltaR2;
+				bestIndex = static_cast<int>(m_indices[position]);
+			}
+		}
+	}
+
+	if (deltaR != nullptr)
+	{
+		*deltaR = ((bestIndex >= 0) ? std::sqrt(bestDeltaR2) : std::numeric_limits<float>::max());
+	}
+	return bestIndex;
+}
+
+void DeltaRMatcher::FindMatches(float eta, float phi, double maxDeltaR, std::vector<size_t>& indices) const
+{
+	Sort();
+
+	indices.clear();
+	if (maxDeltaR > 0.0)
+	{
+		double maxDeltaR2 = maxDeltaR * maxDeltaR;
+		double maxEta = eta + maxDeltaR;
+		for (size_t position = LowerBound(eta - maxDeltaR); (position < m_etas.size()) && (m_etas[position] <= maxEta); ++position)
+		{
+			if (DeltaR2(eta, phi, m_etas[position], m_phis[position]) < maxDeltaR2)
+			{
+				indices.push_back(m_indices[position]);
+			}
+		}
+		std::sort(indices.begin(), indices.end());
+	}
+}
+
+bool DeltaRMatcher::HasMatch(float eta, float phi, double maxDeltaR) const
+{
+	Sort();
+
+	if (maxDeltaR > 0.0)
+	{
+		double maxDeltaR2 = maxDeltaR * maxDeltaR;
+		double maxEta = eta + maxDeltaR;
+		for (size_t position = LowerBound(eta - maxDeltaR); (position < m_etas.size()) && (m_etas[position] <= maxEta); ++position)
+		{
+			if (DeltaR2(eta, phi, m_etas[position], m_phis[position]) < maxDeltaR2)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+double DeltaRMatcher::DeltaR2(float eta1, float phi1, float eta2, float phi2)
+{
+	double deltaPhi = double(phi2) - double(phi1);
+	if (deltaPhi > M_PI)
+	{
+		deltaPhi -= 2.0 * M_PI;
+	}
+	else if (deltaPhi <= -M_PI)
+	{
+		deltaPhi += 2.0 * M_PI;
+	}
+	double deltaEta = double(eta2) - double(eta1);
+	return ((deltaEta * deltaEta) + (deltaPhi * deltaPhi));
+}
+
+void DeltaRMatcher::Sort() const
+{
+	if (m_sorted)
+	{
+		return;
+	}
+
+	std::vector<size_t> positions(m_etas.size());
+	for (size_t position = 0; position < positions.size(); ++position)
+	{
+		positions[position] = position;
+	}
+	std::sort(positions.begin(), positions.end(),
+	          [this](size_t position1, size_t position2) { return (m_etas[position1] < m_etas[position2]); });
+
+	std::vector<float> etas(m_etas.size());
+	std::vector<float> phis(m_phis.size());
+	std::vector<size_t> indices(m_indices.size());
+	for (size_t position = 0; position < positions.size(); ++position)
+	{
+		etas[position] = m_etas[positions[position]];
+		phis[position] = m_phis[positions[position]];
+		indices[position] = m_indices[positions[position]];
+	}
+	m_etas.swap(etas);
+	m_phis.swap(phis);
+	m_indices.swap(indices);
+	m_sorted = true;
+}
+
+size_t DeltaRMatcher::LowerBound(double eta) const
+{
+	return static_cast<size_t>(std::lower_bound(m_etas.begin(), m_etas.end(), eta) - m_etas.begin());
+}
+
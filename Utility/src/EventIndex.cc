@@ -0,0 +1,183 @@
+#include "Artus/Utility/interface/EventIndex.h"
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+
+bool EventIndex::Entry::operator<(Entry const& other) const
+{
+	return (std::tie(run, lumi, event) < std::tie(other.run, other.lumi, other.event));
+}
+
+int EventIndex::AddFile(std::string const& fileName)
+{
+	std::map<std::string, int>::iterator fileIndex = m_fileIndices.find(fileName);
+	if (fileIndex != m_fileIndices.end())
+	{
+		return fileIndex->second;
+	}
+	m_files.push_back(fileName);
+	m_fileIndices[fileName] = static_cast<int>(m_files.size() - 1);
+	return static_cast<int>(m_files.size() - 1);
+}
+
+void EventIndex::Add(unsigned int run, unsigned int lumi, unsigned long long event, int file, long long entry)
+{
+	Entry newEntry = { run, lumi, event, file, entry };
+	m_sorted = (m_sorted && (m_entries.empty() || (! (newEntry < m_entries.back()))));
+	m_entries.push_back(newEntry);
+}
+
+void EventIndex::Merge(EventIndex const& other)
+{
+	std::vector<int> fileIndices;
+	for (std::vector<std::string>::const_iterator fileName = other.m_files.begin(); fileName != other.m_files.end(); ++fileName)
+	{
+		fileIndices.push_back(AddFile(*fileName));
+	}
+	for (std::vector<Entry>::const_iterator entry = other.m_entries.begin(); entry != other.m_entries.end(); ++entry)
+	{
+		Add(entry->run, entry->lumi, entry->event, fileIndices[entry->file], entry->entry);
+	}
+}
+
+void EventIndex::Write(TDirectory* directory)
+{
+	Sort();
+
+	TDirectory* tmpDirectory = gDirectory;
+	directory->cd();
+
+	TTree filesTree("EventIndexFiles", "EventIndexFiles");
+	std::string fileName;
+	filesTree.Branch("fileName", &fileName);
+	for (std::vector<std::string>::const_iterator file = m_files.begin(); file != m_files.end(); ++file)
+	{
+		fileName = *file;
+		filesTree.Fill();
+	}
+	filesTree.Write(filesTree.GetName());
+
+	TTree entriesTree("EventIndex", "EventIndex");
+	Entry entry;
+	entriesTree.Branch("run", &entry.run, "run/i");
+	entriesTree.Branch("lumi", &entry.lumi, "lumi/i");
+	entriesTree.Branch("event", &entry.event, "event/l");
+	entriesTree.Branch("file", &entry.file, "file/I");
+	entriesTree.Branch("entry", &entry.entry, "entry/L");
+	for (std::vector<Entry>::const_iterator indexEntry = m_entries.begin(); indexEntry != m_entries.end(); ++indexEntry)
+	{
+		entry = *indexEntry;
+		entriesTree.Fill();
+	}
+	entriesTree.Write(entriesTree.GetName());
+
+	gDirectory = tmpDirectory;
+}
+
+bool EventIndex::Read(std::string const& fileName)
+{
+	TDirectory* tmpDirectory = gDirectory;
+	std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+	gDirectory = tmpDirectory;
+	if ((! file) || file->IsZombie())
+	{
+		return false;
+	}
+
+	TTree* filesTree = dynamic_cast<TTree*>(file->Get("EventIndexFiles"));
+	TTree* entriesTree = dynamic_cast<TTree*>(file->Get("EventIndex"));
+	if ((filesTree == nullptr) || (entriesTree == nullptr))
+	{
+		return false;
+	}
+
+	std::string* indexFileName = nullptr;
+	filesTree->SetBranchAddress("fileName", &indexFileName);
+	for (Long64_t fileEntry = 0; fileEntry < filesTree->GetEntries(); ++fileEntry)
+	{
+		filesTree->GetEntry(fileEntry);
+		AddFile(*indexFileName);
+	}
+	filesTree->ResetBranchAddresses();
+	delete indexFileName;
+
+	Entry entry;
+	entriesTree->SetBranchAddress("run", &entry.run);
+	entriesTree->SetBranchAddress("lumi", &entry.lumi);
+	entriesTree->SetBranchAddress("event", &entry.event);
+	entriesTree->SetBranchAddress("file", &entry.file);
+	entriesTree->SetBranchAddress("entry", &entry.entry);
+	m_entries.reserve(m_entries.size() + entriesTree->GetEntries());
+	for (Long64_t indexEntry = 0; indexEntry < entriesTree->GetEntries(); ++indexEntry)
+	{
+		entriesTree->GetEntry(indexEntry);
+		Add(entry.run, entry.lumi, entry.event, entry.file, entry.entry);
+	}
+	entriesTree->ResetBranchAddresses();
+
+	file->Close();
+	return true;
+}
+
+EventIndex::Entry const* EventIndex::Find(unsigned int run, unsigned int lumi, unsigned long long event)
+{
+	Sort();
+
+	Entry searchedEntry = { run, lumi, event, -1, -1 };
+	std::vector<Entry>::const_iterator entry = std::lower_bound(m_entries.begin(), m_entries.end(), searchedEntry);
+	if ((entry == m_entries.end()) || (searchedEntry < *entry))
+	{
+		return nullptr;
+	}
+	return &(*entry);
+}
+
+std::vector<std::string> const& EventIndex::GetFiles() const
+{
+	return m_files;
+}
+
+size_t EventIndex::GetSize() const
+{
+	return m_entries.size();
+}
+
+bool EventIndex::ParseEvent(std::string const& eventId, unsigned int& run, unsigned int& lumi, unsigned long long& event)
+{
+	std::vector<std::string> splitted;
+	boost::algorithm::split(splitted, eventId, boost::algorithm::is_any_of(":"));
+	if (splitted.size() != 3)
+	{
+		return false;
+	}
+
+	try
+	{
+		run = boost::lexical_cast<unsigned int>(boost::algorithm::trim_copy(splitted[0]));
+		lumi = boost::lexical_cast<unsigned int>(boost::algorithm::trim_copy(splitted[1]));
+		event = boost::lexical_cast<unsigned long long>(boost::algorithm::trim_copy(splitted[2]));
+	}
+	catch (boost::bad_lexical_cast const&)
+	{
+		return false;
+	}
+	return true;
+}
+
+void EventIndex::Sort()
+{
+	if (! m_sorted)
+	{
+		std::stable_sort(m_entries.begin(), m_entries.end());
+		m_sorted = true;
+	}
+}
+
@@ -1,8 +1,14 @@
 
 #include "Artus/Utility/interface/RootFileHelper.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include <RVersion.h>
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TMath.h>
+
 #include <boost/algorithm/string.hpp>
 
 
@@ -77,3 +83,100 @@ void RootFileHelper::WriteRootObject(TDirectory* directory, TObject* object, std
 	}
 	directory->cd();
 }
+
+long long RootFileHelper::GetClusterEnd(TTree* tree, long long entry)
+{
+	long long localEntry = tree->LoadTree(entry);
+	TTree* currentTree = tree->GetTree();
+	if ((localEntry < 0) || (currentTree == nullptr))
+	{
+		return (entry + 1);
+	}
+
+	TTree::TClusterIterator clusterIterator = currentTree->GetClusterIterator(localEntry);
+	clusterIterator();
+	return (entry - localEntry + std::max(clusterIterator.GetNextEntry(), localEntry + 1));
+}
+
+void RootFileHelper::LoadBaskets(TTree* tree, long long firstEntry, long long endEntry)
+{
+	endEntry = std::min(endEntry, tree->GetEntries());
+	if ((firstEntry < 0) || (firstEntry >= endEntry))
+	{
+		return;
+	}
+
+	TObjArray* leaves = tree->GetListOfLeaves();
+	for (int leafIndex = 0; leafIndex < leaves->GetEntriesFast(); ++leafIndex)
+	{
+		TBranch* branch = static_cast<TLeaf*>(leaves->UncheckedAt(leafIndex))->GetBranch();
+		if (branch->TestBit(kDoNotProcess) || (branch->GetWriteBasket() < 0))
+		{
+			continue;
+		}
+
+		Long64_t nBaskets = branch->GetWriteBasket() + 1;
+		Long64_t firstBasket = TMath::BinarySearch(nBaskets, branch->GetBasketEntry(), Long64_t(firstEntry));
+		Long64_t lastBasket = TMath::BinarySearch(nBaskets, branch->GetBasketEntry(), Long64_t(endEntry - 1));
+		for (Long64_t basket = std::max(firstBasket, Long64_t(0)); basket <= lastBasket; ++basket)
+		{
+			if (basket != branch->GetReadBasket())
+			{
+				branch->GetBasket(basket);
+			}
+		}
+	}
+}
+
+int RootFileHelper::GetCompressionSettings(std::string const& algorithm, int level)
+{
+	if (algorithm.empty())
+	{
+		return -1;
+	}
+	if ((level < 0) || (level > 99))
+	{
+		LOG(FATAL) << "Invalid compression level " << level << "!";
+	}
+
+	std::string upperAlgorithm = boost::algorithm::to_upper_copy(algorithm);
+	int algorithmId = 0;
+	if (upperAlgorithm == "ZLIB")
+	{
+		algorithmId = 1;
+	}
+	else if (upperAlgorithm == "LZMA")
+	{
+		algorithmId = 2;
+	}
+	else if (upperAlgorithm == "LZ4")
+	{
+		algorithmId = 4;
+	}
+	else if (upperAlgorithm == "ZSTD")
+	{
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,20,0)
+		LOG(FATAL) << "ZSTD compression requires ROOT 6.20 or newer!";
+#endif
+		algorithmId = 5;
+	}
+	else
+	{
+		LOG(FATAL) << "Unknown compression algorithm \"" << algorithm << "\"! Use \"ZLIB\", \"LZMA\", \"LZ4\" or \"ZSTD\".";
+	}
+	return (100 * algorithmId) + level;
+}
+
+void RootFileHelper::SetCompressionSettings(TTree* tree, int compressionSettings)
+{
+	if (compressionSettings < 0)
+	{
+		return;
+	}
+
+	TObjArray* branches = tree->GetListOfBranches();
+	for (int branchIndex = 0; branchIndex < branches->GetEntriesFast(); ++branchIndex)
+	{
+		static_cast<TBranch*>(branches->UncheckedAt(branchIndex))->SetCompressionSettings(compressionSettings);
+	}
+}
@@ -0,0 +1,109 @@
+#include "Artus/Utility/interface/RunLumiEventSet.h"
+
+#include <algorithm>
+#include <limits>
+
+
+void RunLumiEventSet::Build(std::vector<uint64_t> const& runs, std::vector<uint64_t> const& lumis, std::vector<uint64_t> const& events)
+{
+	size_t nTuples = std::min(std::min(runs.size(), lumis.size()), events.size());
+
+	size_t capacity = 2;
+	while (capacity < 2 * nTuples)
+	{
+		capacity *= 2;
+	}
+	m_keys.assign(capacity, Key());
+	m_occupied.assign(capacity, 0);
+	m_mask = capacity - 1;
+	m_size = 0;
+
+	for (size_t index = 0; index < nTuples; ++index)
+	{
+		// runs and lumis do not exceed 32 bit, larger values cannot be matched
+		if ((runs[index] > std::numeric_limits<uint32_t>::max()) || (lumis[index] > std::numeric_limits<uint32_t>::max()))
+		{
+			continue;
+		}
+
+		uint64_t runLumi = ((runs[index] << 32) | lumis[index]);
+		size_t slot = FindSlot(runLumi, events[index]);
+		if (! m_occupied[slot])
+		{
+			m_keys[slot].runLumi = runLumi;
+			m_keys[slot].event = events[index];
+			m_occupied[slot] = 1;
+			++m_size;
+		}
+	}
+}
+
+bool RunLumiEventSet::Contains(uint64_t run, uint64_t lumi, uint64_t event) const
+{
+	if ((m_size == 0) || (run > std::numeric_limits<uint32_t>::max()) || (lumi > std::numeric_limits<uint32_t>::max()))
+	{
+		return false;
+	}
+	return m_occupied[FindSlot(((run << 32) | lumi), event)];
+}
+
+size_t RunLumiEventSet::GetSize() const
+{
+	return m_size;
+}
+
+uint64_t RunLumiEventSet::Hash(uint64_t runLumi, uint64_t event)
+{
+	// finalizer of splitmix64
+	uint64_t hash = runLumi ^ (event * 0x9E3779B97F4A7C15ULL);
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+	return (hash ^ (hash >> 31));
+}
+
+/// returns the slot of the key or the empty slot, at which the key has to be inserted
+size_t RunLumiEventSet::FindSlot(uint64_t runLumi, uint64_t event) const
+{
+	size_t slot = static_cast<size_t>(Hash(runLumi, event)) & m_mask;
+	while (m_occupied[slot] && ((m_keys[slot].runLumi != runLumi) || (m_keys[slot].event != event)))
+	{
+		slot = (slot + 1) & m_mask;
+	}
+	return slot;
+}
+
+
+void IntervalSet::Build(std::vector<uint64_t> const& values)
+{
+	std::vector<uint64_t> sortedValues(values);
+	std::sort(sortedValues.begin(), sortedValues.end());
+
+	m_intervals.clear();
+	for (std::vector<uint64_t>::const_iterator value = sortedValues.begin(); value != sortedValues.end(); ++value)
+	{
+		if ((! m_intervals.empty()) && (*value <= m_intervals.back().second + 1))
+		{
+			m_intervals.back().second = std::max(m_intervals.back().second, *value);
+		}
+		else
+		{
+			m_intervals.push_back(std::make_pair(*value, *value));
+		}
+	}
+}
+
+bool IntervalSet::Contains(uint64_t value) const
+{
+	// first interval starting after the value
+	std::vector<std::pair<uint64_t, uint64_t> >::const_iterator interval = std::upper_bound(
+			m_intervals.begin(), m_intervals.end(), value,
+			[](uint64_t searchedValue, std::pair<uint64_t, uint64_t> const& interval) { return (searchedValue < interval.first); }
+	);
+	return ((interval != m_intervals.begin()) && (value <= (interval - 1)->second));
+}
+
+bool IntervalSet::IsEmpty() const
+{
+	return m_intervals.empty();
+}
+